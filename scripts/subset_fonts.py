@@ -0,0 +1,137 @@
+# Generates src/fonts_subset.h with reduced copies of the fonts the firmware draws with, keeping
+# only the glyphs it can actually render. Runs before every build as a PlatformIO extra script,
+# or standalone with `python scripts/subset_fonts.py [path to OLEDDisplayFonts.h]`.
+#
+# Fonts are in the format of http://oleddisplay.squix.ch: width, height, first char, number of
+# chars, a 4 byte jump table entry per char (bitmap offset msb/lsb, bitmap size, advance width,
+# offset 0xFFFF for chars without bitmap) and the bitmaps.
+
+import glob
+import os
+import re
+import sys
+
+DIGITS = "0123456789"
+# temperature and humidity as formatted in updateDisplay(), including "nan" before the first reading
+READINGS_CHARS = DIGITS + ".-°%na"
+# IP addresses plus the status lines in src/status.h
+STATUS_CHARS = DIGITS + "."
+STATUS_TABLE = re.compile(r'statusLines\s*\[[^\]]*\]\s*=\s*\{(.*?)\};', re.S)
+
+
+def parse_font(source, name):
+    match = re.search(r'const\s+(?:uint8_t|char)\s+' + name + r'\s*\[\]\s*PROGMEM\s*=\s*\{(.*?)\};', source, re.S)
+    if match is None:
+        return None
+    body = re.sub(r'//[^\n]*', '', match.group(1))
+    return [int(value, 0) for value in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+
+
+def subset_font(font, chars):
+    height, width, first, count = font[1], font[0], font[2], font[3]
+    codes = sorted(set(ord(c) for c in chars if first <= ord(c) < first + count))
+    new_first, new_last = codes[0], codes[-1]
+    jump = []
+    bitmaps = []
+    for code in range(new_first, new_last + 1):
+        entry = 4 + (code - first) * 4
+        msb, lsb, size, advance = font[entry:entry + 4]
+        if code not in codes:
+            jump += [0xFF, 0xFF, 0x00, 0x00]
+        elif msb == 0xFF and lsb == 0xFF:
+            jump += [0xFF, 0xFF, 0x00, advance]
+        else:
+            offset = (msb << 8) | lsb
+            start = 4 + count * 4 + offset
+            jump += [len(bitmaps) >> 8, len(bitmaps) & 0xFF, size, advance]
+            bitmaps += font[start:start + size]
+    return [width, height, new_first, new_last - new_first + 1] + jump + bitmaps
+
+
+def format_font(name, data, original_size=None):
+    comment = "// %d bytes" % len(data)
+    if original_size is not None:
+        comment += ", subset of %d bytes" % original_size
+    lines = [comment, "const uint8_t %s[] PROGMEM = {" % name]
+    for i in range(0, len(data), 16):
+        lines.append("\t" + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def status_chars(src_dir):
+    with open(os.path.join(src_dir, "status.h"), encoding="utf-8") as f:
+        table = STATUS_TABLE.search(f.read())
+    if table is None:
+        # better no build than a status line with missing glyphs
+        raise SystemExit("statusLines not found in src/status.h")
+    literals = re.findall(r'"((?:[^"\\]|\\.)*)"', table.group(1))
+    return STATUS_CHARS + "".join(literals)
+
+
+def generate(project_dir, library_fonts):
+    src_dir = os.path.join(project_dir, "src")
+    output = ["#ifndef __FONTS_SUBSET__", "#define __FONTS_SUBSET__", "",
+              "// Generated by scripts/subset_fonts.py, do not edit", "", "#include <Arduino.h>", ""]
+
+    with open(os.path.join(src_dir, "font.h"), encoding="utf-8") as f:
+        dialog = parse_font(f.read(), "Dialog_plain_10")
+    subset = subset_font(dialog, status_chars(src_dir))
+    output.append(format_font("Dialog_plain_10_subset", subset, len(dialog)))
+    print("Dialog_plain_10: %d -> %d bytes" % (len(dialog), len(subset)))
+
+    arial = None
+    if library_fonts is not None:
+        with open(library_fonts, encoding="utf-8") as f:
+            arial = parse_font(f.read(), "ArialMT_Plain_24")
+    output.append("")
+    if arial is None:
+        # without the library sources the full font is used, see SSD1306.h
+        print("OLEDDisplayFonts.h not found, not subsetting ArialMT_Plain_24")
+        output.append("#define ArialMT_Plain_24_subset ArialMT_Plain_24")
+    else:
+        subset = subset_font(arial, READINGS_CHARS)
+        output.append("#define READINGS_FONT_SUBSET")
+        output.append(format_font("ArialMT_Plain_24_subset", subset, len(arial)))
+        print("ArialMT_Plain_24: %d -> %d bytes" % (len(arial), len(subset)))
+        # what the subset is compared with on the host, see test/test_screen
+        output += ["", "#ifdef FONTS_SUBSET_ORIGINALS",
+                   format_font("ArialMT_Plain_24_original", arial),
+                   "#endif"]
+
+    output += ["", "#endif", ""]
+    content = "\n".join(output)
+    path = os.path.join(src_dir, "fonts_subset.h")
+    # only touch the file when it changes so it doesn't trigger a rebuild every time
+    if not os.path.exists(path) or open(path, encoding="utf-8").read() != content:
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(content)
+
+
+# the library of the environment being built, or one another environment installed: env:native
+# doesn't depend on it, but its tests compare with the library's fonts once they're around
+def find_library_fonts(libdeps_dir, env_name):
+    for pattern in [os.path.join(libdeps_dir, env_name, "**"), os.path.join(libdeps_dir, "*", "**")]:
+        matches = glob.glob(os.path.join(pattern, "OLEDDisplayFonts.h"), recursive=True)
+        if matches:
+            return matches[0]
+    return None
+
+
+# what env:native subsets when no environment installed the library, so test/test_screen always
+# has a readings subset to compare; the firmware is never built from it
+def stand_in_fonts(project_dir):
+    return os.path.join(project_dir, "test", "test_screen", "OLEDDisplayFonts.h")
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    project = env.subst("$PROJECT_DIR")  # noqa: F821
+    fonts = find_library_fonts(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"))  # noqa: F821
+    if fonts is None and env.subst("$PIOENV") == "native":  # noqa: F821
+        fonts = stand_in_fonts(project)
+    generate(project, fonts)
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))),
+                 sys.argv[1] if len(sys.argv) > 1 else None)
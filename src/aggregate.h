@@ -0,0 +1,75 @@
+#ifndef __AGGREGATE__
+#define __AGGREGATE__
+
+#include <stdint.h>
+#include "samples.h"
+
+// Running statistics of every reading between two uploads, including the ones that didn't
+// change enough to be reported. Constant size so it can live in RTC memory.
+struct ChannelAggregate {
+    int16_t min;
+    int16_t max;
+    int32_t sum;
+
+    void add(int16_t value, bool first) {
+        if(first || value < min) {
+            min = value;
+        }
+        if(first || value > max) {
+            max = value;
+        }
+        sum = first ? value : sum + value;
+    }
+
+    // taken of the other's count readings, only their share of the sum is added
+    void merge(const ChannelAggregate &other, uint16_t taken, uint16_t count) {
+        if(other.min < min) {
+            min = other.min;
+        }
+        if(other.max > max) {
+            max = other.max;
+        }
+        sum += taken == count ? other.sum : (int32_t) ((int64_t) other.sum * taken / count);
+    }
+
+    float mean(uint16_t count) const {
+        return (float) sum / count / 100;
+    }
+};
+
+struct ClimateAggregate {
+    uint16_t count;
+    ChannelAggregate temperature;
+    ChannelAggregate humidity;
+
+    void clear() {
+        count = 0;
+    }
+
+    void add(const Sample &reading) {
+        if(count == UINT16_MAX) {
+            return;
+        }
+        temperature.add(reading.temperature_cC, count == 0);
+        humidity.add(reading.humidity_cpct, count == 0);
+        count++;
+    }
+
+    void merge(const ClimateAggregate &other) {
+        if(other.count == 0) {
+            return;
+        }
+        if(count == 0) {
+            *this = other;
+            return;
+        }
+        // the count saturates like add() stops counting, with the sums kept to the same readings
+        // so the mean stays right and the sums can't overflow
+        uint16_t taken = (uint32_t) count + other.count > UINT16_MAX ? UINT16_MAX - count : other.count;
+        temperature.merge(other.temperature, taken, other.count);
+        humidity.merge(other.humidity, taken, other.count);
+        count += taken;
+    }
+};
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef __BMP280__
+#define __BMP280__
+
+#include "sensor.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+// Bosch BMP280 pressure and temperature sensor, straight over Wire. Measures in forced mode at
+// 1x oversampling, so it sleeps between reads without being told.
+
+#define BMP280_CHIP_ID 0x58
+#define BMP280_REG_CALIBRATION 0x88
+#define BMP280_REG_ID 0xD0
+#define BMP280_REG_STATUS 0xF3
+#define BMP280_REG_CTRL_MEAS 0xF4
+#define BMP280_REG_DATA 0xF7
+// temperature and pressure oversampling 1x, forced mode
+#define BMP280_FORCED_1X 0x25
+// a forced measurement at 1x takes up to 6.4 ms
+#define BMP280_MEASURE_TIMEOUT_MS 20
+
+class BMP280Sensor : public SensorDriver {
+public:
+    BMP280Sensor(uint8_t address) : address(address) {
+    }
+
+    bool begin() override {
+        uint8_t id;
+        if(!readRegisters(BMP280_REG_ID, &id, 1)) {
+            return fail("no answer");
+        }
+        if(id != BMP280_CHIP_ID) {
+            return fail("not a BMP280");
+        }
+        uint8_t data[24];
+        if(!readRegisters(BMP280_REG_CALIBRATION, data, sizeof data)) {
+            return fail("calibration read failed");
+        }
+        T1 = data[0] | data[1] << 8;
+        T2 = (int16_t) (data[2] | data[3] << 8);
+        T3 = (int16_t) (data[4] | data[5] << 8);
+        P1 = data[6] | data[7] << 8;
+        for(uint8_t i = 0; i < 8; i++) {
+            P[i] = (int16_t) (data[8 + 2 * i] | data[9 + 2 * i] << 8);
+        }
+        error = "none";
+        return true;
+    }
+
+    bool measure(SensorReading &reading) override {
+        if(!writeRegister(BMP280_REG_CTRL_MEAS, BMP280_FORCED_1X)) {
+            return fail("start failed");
+        }
+        unsigned long start = millis();
+        uint8_t status;
+        do {
+            delay(2);
+            if(!readRegisters(BMP280_REG_STATUS, &status, 1)) {
+                return fail("status read failed");
+            }
+        } while((status & 0x08) && millis() - start < BMP280_MEASURE_TIMEOUT_MS);
+        uint8_t data[6];
+        if(!readRegisters(BMP280_REG_DATA, data, sizeof data)) {
+            return fail("data read failed");
+        }
+        int32_t adcP = (int32_t) data[0] << 12 | data[1] << 4 | data[2] >> 4;
+        int32_t adcT = (int32_t) data[3] << 12 | data[4] << 4 | data[5] >> 4;
+        int32_t fine = temperatureFine(adcT);
+        reading.temperature_C = ((fine * 5 + 128) >> 8) / 100.0f;
+        reading.humidity_pct = NAN;
+        reading.pressure_hPa = pressure(adcP, fine) / 25600.0f;
+        return true;
+    }
+
+    void sleep() override {
+        // forced mode goes back to sleep after each measurement
+    }
+
+    const char *lastError() override {
+        return error;
+    }
+
+private:
+    // the compensation of the datasheet, in its integer form
+    int32_t temperatureFine(int32_t adcT) {
+        int32_t var1 = (((adcT >> 3) - ((int32_t) T1 << 1)) * T2) >> 11;
+        int32_t var2 = (((((adcT >> 4) - (int32_t) T1) * ((adcT >> 4) - (int32_t) T1)) >> 12) * T3) >> 14;
+        return var1 + var2;
+    }
+
+    // in Pa as Q24.8
+    uint32_t pressure(int32_t adcP, int32_t fine) {
+        int64_t var1 = (int64_t) fine - 128000;
+        int64_t var2 = var1 * var1 * P[4];
+        var2 += (var1 * P[3]) << 17;
+        var2 += (int64_t) P[2] << 35;
+        var1 = ((var1 * var1 * P[1]) >> 8) + ((var1 * P[0]) << 12);
+        var1 = (((int64_t) 1 << 47) + var1) * P1 >> 33;
+        if(var1 == 0) {
+            return 0;
+        }
+        int64_t p = 1048576 - adcP;
+        p = (((p << 31) - var2) * 3125) / var1;
+        var1 = ((int64_t) P[7] * (p >> 13) * (p >> 13)) >> 25;
+        var2 = ((int64_t) P[6] * p) >> 19;
+        return (uint32_t) (((p + var1 + var2) >> 8) + ((int64_t) P[5] << 4));
+    }
+
+    bool writeRegister(uint8_t reg, uint8_t value) {
+        Wire.beginTransmission(address);
+        Wire.write(reg);
+        Wire.write(value);
+        return Wire.endTransmission() == 0;
+    }
+
+    bool readRegisters(uint8_t reg, uint8_t *data, uint8_t length) {
+        Wire.beginTransmission(address);
+        Wire.write(reg);
+        if(Wire.endTransmission(false) != 0 || Wire.requestFrom(address, length) != length) {
+            return false;
+        }
+        for(uint8_t i = 0; i < length; i++) {
+            data[i] = Wire.read();
+        }
+        return true;
+    }
+
+    bool fail(const char *message) {
+        error = message;
+        return false;
+    }
+
+    uint8_t address;
+    uint16_t T1 = 0;
+    int16_t T2 = 0;
+    int16_t T3 = 0;
+    uint16_t P1 = 0;
+    int16_t P[8] = {};  // dig_P2 to dig_P9
+    const char *error = "none";
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef __CLOCK__
+#define __CLOCK__
+
+#include <stdint.h>
+
+// Maps the station clock (see stationClock()) to unix time from the last SNTP sync. The station
+// clock counts the nominal deep sleep intervals, which the RTC oscillator misses by up to a few
+// percent, so the drift measured between two syncs is corrected for as well. Kept in RTC memory,
+// so SNTP is only needed every now and then instead of on every upload.
+
+#define CLOCK_DRIFT_MIN_SPAN_S 1800  // shorter spans can't tell drift from the 1 s resolution
+#define CLOCK_DRIFT_MAX_PPM 100000
+#define CLOCK_RESYNC_S 21600         // sync at least this often, whatever the number of wakes
+
+struct ClockSync {
+    uint32_t station_s;  // station clock at the last sync
+    uint32_t unix_s;     // unix time then
+    int32_t drift_ppm;   // how much faster the station clock runs than real time
+    uint16_t wakes;      // deep sleep wakes since the last sync
+    bool valid;
+    bool driftKnown;
+
+    void clear() {
+        valid = false;
+        driftKnown = false;
+        drift_ppm = 0;
+        wakes = 0;
+    }
+
+    // whether to take the time from SNTP at the next chance
+    bool due(uint32_t now_s, uint16_t everyWakes) const {
+        return !valid || wakes >= everyWakes || now_s - station_s >= CLOCK_RESYNC_S;
+    }
+
+    // Unix time of a station clock time, only meaningful when valid
+    uint32_t unixTime(uint32_t time_s) const {
+        int32_t elapsed = (int32_t) (time_s - station_s);
+        return unix_s + (int32_t) ((int64_t) elapsed * 1000000 / (1000000 + drift_ppm));
+    }
+
+    // Anchors the clock at unix time now_unix. Returns how many seconds the previous anchor and
+    // drift were off by.
+    int32_t sync(uint32_t now_s, uint32_t now_unix) {
+        int32_t error = 0;
+        if(valid) {
+            error = (int32_t) (unixTime(now_s) - now_unix);
+            int32_t stationElapsed = (int32_t) (now_s - station_s);
+            int32_t realElapsed = (int32_t) (now_unix - unix_s);
+            if(stationElapsed >= CLOCK_DRIFT_MIN_SPAN_S && realElapsed > 0) {
+                int64_t measured = (int64_t) (stationElapsed - realElapsed) * 1000000 / realElapsed;
+                if(measured > CLOCK_DRIFT_MAX_PPM) {
+                    measured = CLOCK_DRIFT_MAX_PPM;
+                } else if(measured < -CLOCK_DRIFT_MAX_PPM) {
+                    measured = -CLOCK_DRIFT_MAX_PPM;
+                }
+                // the interval mix changes between syncs, so smooth rather than replace
+                drift_ppm = driftKnown ? (int32_t) ((3 * (int64_t) drift_ppm + measured) / 4) : (int32_t) measured;
+                driftKnown = true;
+            }
+        }
+        station_s = now_s;
+        unix_s = now_unix;
+        wakes = 0;
+        valid = true;
+        return error;
+    }
+};
+
+#endif
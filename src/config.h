@@ -0,0 +1,80 @@
+#ifndef __CONFIG__
+#define __CONFIG__
+
+#include <string.h>
+#include <stdint.h>
+#include "energy.h"
+#include "sensors.h"
+
+// The settings themselves, without the EEPROM handling of settings.h so the station logic can be
+// built for the simulator too. How they're stored is up to settingsstore.h, strings only take
+// the space of their contents there.
+
+struct struct_settings
+{
+    int deepSleepTimer;
+    bool influxEnabled;
+    char influxHost[64];
+    unsigned short influxPort;
+    char influxDatabase[32];
+    char influxSeries[32];
+    char influxTags[64];
+    char displayContrast;
+    char lowPowerContrast;
+    unsigned char batchSize;      // number of samples collected in deep sleep before uploading
+    unsigned short batchMaxAge;   // maximum age in seconds of a buffered sample before uploading
+    int deepSleepMaxTimer;        // deep sleep stretches up to this while readings are stable
+    char sensorRepeatability;     // see SensorRepeatability
+    bool sensorHeater;
+    unsigned char filterMode;       // see FilterMode
+    unsigned char filterWindow;     // readings in the median window
+    unsigned char filterEmaShift;   // EMA alpha is 1 / 2^filterEmaShift
+    unsigned char filterHysteresis; // % of the threshold added when a change reverses the previous one
+    unsigned char filterOversample; // readings averaged per deep sleep wake
+    uint32_t phaseCurrent_uA[ENERGY_PHASES]; // supply current in each EnergyPhase
+    unsigned short clockSyncWakes;  // deep sleep wakes between SNTP syncs
+    unsigned char uploadProtocol;   // see UploadProtocol, influxEnabled turns uploads on
+    char mqttHost[64];
+    unsigned short mqttPort;
+    char mqttTopic[64];             // {id} and {series} are replaced, see expandMqttTopic()
+    unsigned char mqttQos;          // 0 or 1
+    bool mqttRetain;                // publish the newest reading retained
+    unsigned short influxUdpPort;   // of InfluxDB's UDP listener, for UPLOAD_UDP
+    unsigned short sensorSlots[SENSOR_SLOTS]; // what the last cold boot found on the bus, see makeSensorSlot()
+    bool gatewayEnabled;            // forward what nodes send, see gateway.h, while powered
+};
+
+struct_settings settings;
+
+void defaultSettings(struct_settings &settings) {
+    memset(&settings, 0, sizeof settings);
+    settings.deepSleepTimer = 10; // every 10 seconds
+    settings.deepSleepMaxTimer = 300; // up to every 5 minutes when stable
+    settings.filterMode = 1; // median, see FilterMode
+    settings.filterWindow = 3;
+    settings.filterEmaShift = 2;
+    settings.filterHysteresis = 50;
+    settings.filterOversample = 1;
+    // ESP8266 with the modem idle or transmitting, the OLED and SHT31 draw comparatively little
+    settings.phaseCurrent_uA[PHASE_SENSOR] = 20000;
+    settings.phaseCurrent_uA[PHASE_DISPLAY] = 20000;
+    settings.phaseCurrent_uA[PHASE_WIFI] = 75000;
+    settings.phaseCurrent_uA[PHASE_UPLOAD] = 75000;
+    settings.phaseCurrent_uA[PHASE_OTHER] = 20000;
+    settings.phaseCurrent_uA[PHASE_SLEEP] = 25;
+    settings.influxEnabled = false;
+    settings.influxHost[0] = 0;
+    settings.influxPort = 8086;
+    settings.influxUdpPort = 8089;
+    settings.batchSize = 10;
+    settings.batchMaxAge = 900; // 15 minutes
+    settings.clockSyncWakes = 100;
+    settings.mqttPort = 1883;
+    settings.mqttQos = 1;
+    settings.mqttRetain = true;
+    strncpy(settings.mqttTopic, "climate/{id}", sizeof settings.mqttTopic - 1);
+    strncpy(settings.influxSeries, "climate", sizeof settings.influxSeries - 1);
+    strncpy(settings.influxTags, "name=Sensor 1", sizeof settings.influxTags - 1);
+}
+
+#endif
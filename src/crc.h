@@ -0,0 +1,18 @@
+#ifndef __CRC__
+#define __CRC__
+
+#include <stdint.h>
+#include <stddef.h>
+
+// CRC-16/CCITT-FALSE, bitwise since the records it protects are small
+inline uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF) {
+    for(size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t) data[i] << 8;
+        for(uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+#endif
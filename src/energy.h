@@ -0,0 +1,108 @@
+#ifndef __ENERGY__
+#define __ENERGY__
+
+#include <stdint.h>
+
+// Estimates the charge drawn by the station from the time spent in each phase of a wake and a
+// configurable current per phase. Every millisecond is attributed to exactly one phase, so the
+// phases add up to the time since the account was cleared.
+
+enum EnergyPhase {
+    PHASE_SENSOR,
+    PHASE_DISPLAY,
+    PHASE_WIFI,      // associating, including WiFiManager
+    PHASE_UPLOAD,
+    PHASE_OTHER,     // the rest of a wake: boot, settings, sleep entry
+    PHASE_SLEEP,
+    ENERGY_PHASES
+};
+
+#define ENERGY_MAX_CURRENT_UA 1000000  // the most /energy takes for a phase, far above what the board draws
+
+inline const char *energyPhaseName(uint8_t phase) {
+    static const char *names[ENERGY_PHASES] = { "sensor", "display", "wifi", "upload", "other", "sleep" };
+    return phase < ENERGY_PHASES ? names[phase] : "";
+}
+
+// Kept in RTC memory, cleared on cold boot
+struct EnergyAccount {
+    uint64_t phase_ms[ENERGY_PHASES];
+
+    void clear() {
+        for(uint8_t i = 0; i < ENERGY_PHASES; i++) {
+            phase_ms[i] = 0;
+        }
+    }
+
+    uint64_t total_ms() const {
+        uint64_t total = 0;
+        for(uint8_t i = 0; i < ENERGY_PHASES; i++) {
+            total += phase_ms[i];
+        }
+        return total;
+    }
+
+    float charge_mAh(uint8_t phase, const uint32_t *current_uA) const {
+        return (float) phase_ms[phase] * current_uA[phase] / 3.6e9f;
+    }
+
+    float charge_mAh(const uint32_t *current_uA) const {
+        float charge = 0;
+        for(uint8_t i = 0; i < ENERGY_PHASES; i++) {
+            charge += charge_mAh(i, current_uA);
+        }
+        return charge;
+    }
+
+    // 0 until some time was accounted
+    float mAhPerDay(const uint32_t *current_uA) const {
+        uint64_t total = total_ms();
+        return total > 0 ? charge_mAh(current_uA) * 86400000.0f / total : 0;
+    }
+};
+
+// Tracks the phase the station is in during a wake, the account only sees whole intervals
+class EnergyMeter {
+public:
+    EnergyMeter(EnergyAccount &account) : account(account) {
+    }
+
+    // Attributes the time since the last call to the current phase and switches to phase.
+    // Returns the phase that was current.
+    uint8_t enter(uint8_t phase, uint32_t now_ms) {
+        bool radio = current == PHASE_WIFI || current == PHASE_UPLOAD;
+        account.phase_ms[backgroundPhase < ENERGY_PHASES && !radio ? backgroundPhase : current] += now_ms - since_ms;
+        uint8_t previous = current;
+        current = phase;
+        since_ms = now_ms;
+        return previous;
+    }
+
+    // While the radio runs in the background, e.g. associating during the sensor reading, the
+    // time of the foreground phases goes to phase instead as the radio draws the most.
+    // ENERGY_PHASES ends it.
+    void background(uint8_t phase, uint32_t now_ms) {
+        enter(current, now_ms);
+        backgroundPhase = phase;
+    }
+
+    // clears the account, the time until now_ms isn't attributed
+    void reset(uint32_t now_ms) {
+        account.clear();
+        since_ms = now_ms;
+    }
+
+    // ends the wake, the time until now_ms still goes to the current phase
+    void sleep(uint32_t now_ms, uint32_t seconds) {
+        enter(PHASE_SLEEP, now_ms);
+        account.phase_ms[PHASE_SLEEP] += (uint64_t) seconds * 1000;
+    }
+
+private:
+    EnergyAccount &account;
+    uint8_t current = PHASE_OTHER;
+    uint8_t backgroundPhase = ENERGY_PHASES;
+    uint32_t since_ms = 0;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef __FILTER__
+#define __FILTER__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Noise filtering between the sensor and change detection. Values are fixed point hundredths
+// (see Sample) and the state is small enough to be kept in RTC memory across deep sleep.
+
+#define FILTER_WINDOW_MAX 5
+
+enum FilterMode {
+    FILTER_NONE,
+    FILTER_MEDIAN,  // median of the last windowSize readings
+    FILTER_EMA      // exponential moving average with alpha = 1 / 2^emaShift
+};
+
+struct FilterParams {
+    uint8_t mode;
+    uint8_t windowSize;
+    uint8_t emaShift;
+    uint8_t hysteresis_pct;  // extra threshold, in % of it, to reverse the last reported change
+};
+
+struct ChannelFilter {
+    int16_t window[FILTER_WINDOW_MAX];
+    uint8_t head;
+    uint8_t count;
+    int8_t direction;  // of the last reported change
+    int32_t ema;       // filtered value << 8
+
+    void clear() {
+        head = 0;
+        count = 0;
+        direction = 0;
+        ema = 0;
+    }
+
+    int16_t apply(int16_t value, const FilterParams &params) {
+        switch(params.mode) {
+        case FILTER_MEDIAN:
+            return median(value, params.windowSize);
+        case FILTER_EMA:
+            if(count == 0) {
+                ema = (int32_t) value << 8;
+                count = 1;
+            } else {
+                ema += (((int32_t) value << 8) - ema) >> params.emaShift;
+            }
+            // round rather than truncate towards minus infinity
+            return (int16_t) ((ema + 128) >> 8);
+        default:
+            return value;
+        }
+    }
+
+    // Whether value moved more than threshold away from the reported value. Going against the
+    // direction of the last reported change takes hysteresis_pct more, so noise around the
+    // threshold doesn't report the same change back and forth.
+    bool changed(int16_t value, int16_t reported, uint16_t threshold, const FilterParams &params) {
+        int32_t delta = (int32_t) value - reported;
+        if(delta == 0) {
+            return false;
+        }
+        int8_t towards = delta > 0 ? 1 : -1;
+        uint32_t needed = threshold;
+        if(direction != 0 && towards != direction) {
+            needed += (uint32_t) threshold * params.hysteresis_pct / 100;
+        }
+        if((uint32_t) labs(delta) > needed) {
+            direction = towards;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    int16_t median(int16_t value, uint8_t size) {
+        if(size < 1 || size > FILTER_WINDOW_MAX) {
+            size = FILTER_WINDOW_MAX;
+        }
+        if(count >= size) {
+            head = (head + 1) % size;
+            count = size - 1;
+        }
+        window[(head + count) % size] = value;
+        count++;
+
+        int16_t sorted[FILTER_WINDOW_MAX];
+        for(uint8_t i = 0; i < count; i++) {
+            int16_t v = window[(head + i) % size];
+            uint8_t j = i;
+            for(; j > 0 && sorted[j - 1] > v; j--) {
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = v;
+        }
+        if(count % 2 == 1) {
+            return sorted[count / 2];
+        }
+        return (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    }
+};
+
+struct ClimateFilter {
+    ChannelFilter temperature;
+    ChannelFilter humidity;
+
+    void clear() {
+        temperature.clear();
+        humidity.clear();
+    }
+};
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef __FONT__
+#define __FONT__
+
 #include <Arduino.h>
 
 // Created by http://oleddisplay.squix.ch/ Consider a donation
@@ -458,3 +461,5 @@ const uint8_t Dialog_plain_10[] PROGMEM = {
 	0x00,0x00,0xFC,0x0F,0x20,0x02,0x20,0x02,0x20,0x02,0xC0,0x01,	// 254
 	0x00,0x00,0x60,0x08,0x88,0x09,0x00,0x06,0x88,0x01,0x60	// 255
 };
+
+#endif
@@ -0,0 +1,481 @@
+#ifndef __GATEWAY__
+#define __GATEWAY__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "samples.h"
+#include "crc.h"
+#include "uploader.h"
+
+// Battery stations as nodes of a gateway: instead of associating and writing to InfluxDB
+// themselves, they send their queue as a binary frame over a connectionless link (ESP-NOW on
+// the board) to a mains powered station, which keeps the frames of all its nodes and forwards
+// them to InfluxDB in large batches. A frame is a few milliseconds of radio where an upload is
+// hundreds.
+//
+//   magic version type count node(u32) boot(u16) clock_s(u32) { timestamp_s(u32) temperature_cC(i16) humidity_cpct(u16) }* crc16
+//
+// Integers are little-endian. Nodes never learn the time, so clock_s is the station clock when
+// the frame was sent and the gateway stamps the samples by their age. boot tells the cold boots
+// of a node apart, as its station clock starts over with each. The gateway acknowledges with a
+// frame without samples whose clock_s is the timestamp of the newest sample it has of the node,
+// so a frame sent again because its ack was lost isn't stored twice. Nodes keep their samples
+// until acknowledged and the gateway only acknowledges what it has room for, so while it can't
+// forward, the samples wait on the nodes.
+
+#define GATEWAY_FRAME_MAX 250       // ESP-NOW payload limit
+#define GATEWAY_MAGIC 0xC7
+#define GATEWAY_VERSION 1
+#define GATEWAY_HEADER_SIZE 14
+#define GATEWAY_SAMPLE_SIZE 8
+#define GATEWAY_CRC_SIZE 2
+#define GATEWAY_FRAME_SAMPLES ((GATEWAY_FRAME_MAX - GATEWAY_HEADER_SIZE - GATEWAY_CRC_SIZE) / GATEWAY_SAMPLE_SIZE)
+#define GATEWAY_ADDRESS_SIZE 6
+
+// a node waits this long for the ack, the gateway answers as soon as the frame is stored
+#define GATEWAY_ACK_TIMEOUT_MS 30
+#define GATEWAY_SEND_ATTEMPTS 3
+// how often a gateway looks for frames, well within the time a node waits for the ack
+#define GATEWAY_POLL_MS 5
+
+#define GATEWAY_NODES 16
+#define GATEWAY_QUEUE_SIZE 128      // samples of all nodes waiting to be forwarded
+#define GATEWAY_BATCH_SAMPLES 64    // forwarded once this many are waiting, about what a request holds
+#define GATEWAY_PAYLOAD_SIZE 4096
+
+static_assert(SAMPLE_BUFFER_SIZE <= GATEWAY_FRAME_SAMPLES, "a whole queue must fit a frame");
+static_assert(GATEWAY_QUEUE_SIZE <= 255, "the uploader counts samples in flight in a byte");
+
+enum GatewayFrameType {
+    GATEWAY_SAMPLES = 1,
+    GATEWAY_ACK = 2
+};
+
+const uint8_t gatewayBroadcast[GATEWAY_ADDRESS_SIZE] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+// Single frames to and from the stations in range, without a connection. Addresses are MAC
+// addresses on the board, the link of the simulator uses the IPv4 address and port.
+class GatewayLink {
+public:
+    virtual ~GatewayLink() {}
+    // Brings up the radio on channel, without associating if it isn't already
+    virtual bool begin(uint8_t channel) = 0;
+    virtual bool ready() = 0;
+    // Must not block, all 0xFF broadcasts
+    virtual bool send(const uint8_t *address, const uint8_t *data, size_t length) = 0;
+    // The next frame that came in and its sender, 0 if there's none. Must not block.
+    virtual size_t receive(uint8_t *address, uint8_t *data, size_t capacity) = 0;
+    virtual void end() = 0;
+};
+
+struct GatewayFrame {
+    uint8_t type;     // see GatewayFrameType
+    uint8_t count;
+    uint32_t node;
+    uint16_t boot;
+    uint32_t clock_s;
+    Sample samples[GATEWAY_FRAME_SAMPLES];
+};
+
+inline size_t putGatewayInteger(uint8_t *data, size_t at, uint32_t value, uint8_t size) {
+    for(uint8_t i = 0; i < size; i++) {
+        data[at++] = value >> 8 * i;
+    }
+    return at;
+}
+
+inline uint32_t getGatewayInteger(const uint8_t *data, size_t at, uint8_t size) {
+    uint32_t value = 0;
+    for(uint8_t i = 0; i < size; i++) {
+        value |= (uint32_t) data[at + i] << 8 * i;
+    }
+    return value;
+}
+
+// Writes frame to data, which must hold GATEWAY_FRAME_MAX bytes. Returns the length.
+inline size_t encodeGatewayFrame(const GatewayFrame &frame, uint8_t *data) {
+    size_t at = 0;
+    data[at++] = GATEWAY_MAGIC;
+    data[at++] = GATEWAY_VERSION;
+    data[at++] = frame.type;
+    data[at++] = frame.count;
+    at = putGatewayInteger(data, at, frame.node, 4);
+    at = putGatewayInteger(data, at, frame.boot, 2);
+    at = putGatewayInteger(data, at, frame.clock_s, 4);
+    for(uint8_t i = 0; i < frame.count; i++) {
+        at = putGatewayInteger(data, at, frame.samples[i].timestamp_s, 4);
+        at = putGatewayInteger(data, at, (uint16_t) frame.samples[i].temperature_cC, 2);
+        at = putGatewayInteger(data, at, frame.samples[i].humidity_cpct, 2);
+    }
+    return putGatewayInteger(data, at, crc16(data, at), 2);
+}
+
+// Returns false for anything that isn't a whole, intact frame of this version
+inline bool decodeGatewayFrame(const uint8_t *data, size_t length, GatewayFrame &frame) {
+    if(length < GATEWAY_HEADER_SIZE + GATEWAY_CRC_SIZE || data[0] != GATEWAY_MAGIC || data[1] != GATEWAY_VERSION) {
+        return false;
+    }
+    frame.type = data[2];
+    frame.count = data[3];
+    if(frame.count > GATEWAY_FRAME_SAMPLES || length != (size_t) (GATEWAY_HEADER_SIZE + frame.count * GATEWAY_SAMPLE_SIZE + GATEWAY_CRC_SIZE)) {
+        return false;
+    }
+    if(getGatewayInteger(data, length - GATEWAY_CRC_SIZE, 2) != crc16(data, length - GATEWAY_CRC_SIZE)) {
+        return false;
+    }
+    frame.node = getGatewayInteger(data, 4, 4);
+    frame.boot = getGatewayInteger(data, 8, 2);
+    frame.clock_s = getGatewayInteger(data, 10, 4);
+    for(uint8_t i = 0; i < frame.count; i++) {
+        size_t at = GATEWAY_HEADER_SIZE + i * GATEWAY_SAMPLE_SIZE;
+        frame.samples[i].timestamp_s = getGatewayInteger(data, at, 4);
+        frame.samples[i].temperature_cC = (int16_t) getGatewayInteger(data, at + 4, 2);
+        frame.samples[i].humidity_cpct = getGatewayInteger(data, at + 6, 2);
+    }
+    return true;
+}
+
+// The node side, sends the whole queue as one frame and removes it once the gateway acked it.
+// There's nothing like a connection, so only IDLE, SEND, AWAIT_RESPONSE and BACKOFF are used.
+class GatewayUploader : public Uploader {
+public:
+    GatewayUploader(GatewayLink &link) : link(link) {
+    }
+
+    // node tells the stations apart, boot changes with every cold boot and clock is the
+    // station clock the samples are stamped with. boot must stay valid while the uploader is used.
+    void setNode(uint32_t node, const uint16_t &boot, uint32_t (*clock)()) {
+        this->node = node;
+        this->boot = &boot;
+        this->clock = clock;
+        reset();
+    }
+
+    // the gateway places the samples in time, a node never learns the time itself
+    bool ready(const ClockSync &) const override {
+        return !queue->empty();
+    }
+
+    void step(uint32_t now_ms, const ClockSync &) override {
+        switch(current) {
+        case IDLE:
+            if(!queue->empty()) {
+                encode();
+                attempts = 0;
+                current = SEND;
+            }
+            break;
+        case SEND:
+            if(!link.send(gatewayBroadcast, frame, length)) {
+                lastResult = UPLOAD_ERROR_SEND_FAILED;
+                backOff(now_ms);
+                break;
+            }
+            framesSent++;
+            attempts++;
+            sent_ms = now_ms;
+            current = AWAIT_RESPONSE;
+            break;
+        case AWAIT_RESPONSE:
+            receive(now_ms);
+            break;
+        case CONNECT:
+            current = IDLE;
+            break;
+        case BACKOFF:
+            if(now_ms - failedAt_ms >= backoff_ms) {
+                current = IDLE;
+            }
+            break;
+        }
+    }
+
+    unsigned long framesSent = 0;
+
+private:
+    void encode() {
+        GatewayFrame data;
+        data.type = GATEWAY_SAMPLES;
+        data.node = node;
+        data.boot = *boot;
+        data.clock_s = clock();
+        data.count = queue->size();
+        for(uint8_t i = 0; i < data.count; i++) {
+            data.samples[i] = queue->at(i);
+        }
+        length = encodeGatewayFrame(data, frame);
+        newest_s = queue->newest().timestamp_s;
+        inFlight = data.count;
+        droppedAtEncode = queue->dropped;
+    }
+
+    void receive(uint32_t now_ms) {
+        uint8_t from[GATEWAY_ADDRESS_SIZE];
+        uint8_t data[GATEWAY_FRAME_MAX];
+        GatewayFrame ack;
+        size_t n;
+        while((n = link.receive(from, data, sizeof data)) > 0) {
+            // other nodes' acks are broadcast too
+            if(decodeGatewayFrame(data, n, ack) && ack.type == GATEWAY_ACK && ack.node == node &&
+                    ack.boot == *boot && ack.clock_s == newest_s) {
+                lastResult = 0;
+                accepted();
+                return;
+            }
+        }
+        if(now_ms - sent_ms < GATEWAY_ACK_TIMEOUT_MS) {
+            return;
+        }
+        if(attempts < GATEWAY_SEND_ATTEMPTS) {
+            // the same frame, the gateway recognizes the samples it already has
+            current = SEND;
+            return;
+        }
+        lastResult = UPLOAD_ERROR_READ_TIMEOUT;
+        backOff(now_ms);
+    }
+
+    GatewayLink &link;
+    uint32_t node = 0;
+    const uint16_t *boot = NULL;
+    uint32_t (*clock)() = NULL;
+
+    uint8_t frame[GATEWAY_FRAME_MAX];
+    size_t length = 0;
+    uint32_t newest_s = 0;
+    uint8_t attempts = 0;
+    uint32_t sent_ms = 0;
+};
+
+// What the gateway knows of a node, to tell repeated frames from new ones
+struct GatewayNode {
+    uint32_t id;
+    uint16_t boot;
+    uint32_t newest_s;      // node clock of the newest sample stored, if any since boot changed
+    uint32_t lastSeen_s;    // gateway clock
+    unsigned long frames;
+    unsigned long samples;
+    unsigned long duplicates; // samples received again because an ack was lost
+    bool stored;
+    bool known;
+};
+
+struct GatewaySample {
+    uint32_t node;
+    Sample sample;          // stamped with the gateway's station clock
+};
+
+// Fixed size ring of the samples of all nodes, the gateway refuses frames it has no room for
+struct GatewayQueue {
+    uint16_t head;
+    uint16_t count;
+    uint32_t since_s;  // gateway time the oldest sample came in, their timestamps are much older
+    GatewaySample items[GATEWAY_QUEUE_SIZE];
+
+    uint16_t size() const {
+        return count;
+    }
+
+    uint16_t room() const {
+        return GATEWAY_QUEUE_SIZE - count;
+    }
+
+    const GatewaySample &at(uint16_t i) const {
+        return items[(head + i) % GATEWAY_QUEUE_SIZE];
+    }
+
+    void push(uint32_t node, const Sample &sample, uint32_t now_s) {
+        if(count == 0) {
+            since_s = now_s;
+        }
+        GatewaySample &item = items[(head + count) % GATEWAY_QUEUE_SIZE];
+        item.node = node;
+        item.sample = sample;
+        count++;
+    }
+
+    // What's left didn't fit the request that took the others, it counts as waiting since now_s
+    void drop(uint16_t n, uint32_t now_s) {
+        n = n < count ? n : count;
+        head = (head + n) % GATEWAY_QUEUE_SIZE;
+        count -= n;
+        if(count > 0) {
+            since_s = now_s;
+        }
+    }
+
+    // like uploadDue(), with the batch size of a gateway and counting from when samples came in,
+    // as a node only sends what is due already
+    bool due(uint32_t now_s, uint16_t fillLevel, uint32_t maxAge_s) const {
+        return count > 0 && (count >= fillLevel || now_s - since_s >= maxAge_s);
+    }
+};
+
+// The gateway side, stores the samples of the frames that come in and acks them
+class Gateway {
+public:
+    Gateway(GatewayLink &link) : link(link) {
+    }
+
+    // Handles every frame that came in, now_s is the gateway's station clock
+    void receive(uint32_t now_s) {
+        uint8_t from[GATEWAY_ADDRESS_SIZE];
+        uint8_t data[GATEWAY_FRAME_MAX];
+        GatewayFrame frame;
+        size_t n;
+        while((n = link.receive(from, data, sizeof data)) > 0) {
+            if(!decodeGatewayFrame(data, n, frame)) {
+                framesInvalid++;
+                continue;
+            }
+            if(frame.type != GATEWAY_SAMPLES || frame.count == 0) {
+                continue;
+            }
+            if(store(frame, now_s)) {
+                acknowledge(from, frame);
+            }
+        }
+    }
+
+    uint8_t nodeCount() const {
+        uint8_t n = 0;
+        for(const GatewayNode &node : nodes) {
+            n += node.known;
+        }
+        return n;
+    }
+
+    const GatewayNode &node(uint8_t i) const {
+        return nodes[i];
+    }
+
+    GatewayQueue queue = {};
+    unsigned long framesReceived = 0;
+    unsigned long framesInvalid = 0;
+    unsigned long framesRefused = 0;  // for lack of room, the node sends them again later
+
+private:
+    // Returns false when the new samples don't fit, all of them or none are stored
+    bool store(const GatewayFrame &frame, uint32_t now_s) {
+        GatewayNode &node = lookup(frame.node);
+        if(node.boot != frame.boot) {
+            node.boot = frame.boot;
+            node.stored = false;
+        }
+        uint8_t first = 0;
+        while(first < frame.count && node.stored && frame.samples[first].timestamp_s <= node.newest_s) {
+            first++;
+        }
+        if(frame.count - first > queue.room()) {
+            framesRefused++;
+            return false;
+        }
+        framesReceived++;
+        node.frames++;
+        node.duplicates += first;
+        node.lastSeen_s = now_s;
+        for(uint8_t i = first; i < frame.count; i++) {
+            Sample sample = frame.samples[i];
+            // by its age, which wraps like the station clock does before the gateway's first
+            // minutes, see ClockSync::unixTime()
+            uint32_t age_s = sample.timestamp_s < frame.clock_s ? frame.clock_s - sample.timestamp_s : 0;
+            sample.timestamp_s = now_s - age_s;
+            queue.push(frame.node, sample, now_s);
+            node.samples++;
+            node.newest_s = frame.samples[i].timestamp_s;
+            node.stored = true;
+        }
+        return true;
+    }
+
+    // the node's entry, the one seen the longest ago makes room for a new node
+    GatewayNode &lookup(uint32_t id) {
+        GatewayNode *oldest = &nodes[0];
+        for(GatewayNode &node : nodes) {
+            if(node.known && node.id == id) {
+                return node;
+            }
+            if(!node.known || (oldest->known && node.lastSeen_s < oldest->lastSeen_s)) {
+                oldest = &node;
+            }
+        }
+        memset(oldest, 0, sizeof *oldest);
+        oldest->id = id;
+        oldest->known = true;
+        return *oldest;
+    }
+
+    void acknowledge(const uint8_t *to, const GatewayFrame &frame) {
+        GatewayFrame ack;
+        ack.type = GATEWAY_ACK;
+        ack.count = 0;
+        ack.node = frame.node;
+        ack.boot = frame.boot;
+        ack.clock_s = frame.samples[frame.count - 1].timestamp_s;
+        uint8_t data[GATEWAY_FRAME_MAX];
+        link.send(to, data, encodeGatewayFrame(ack, data));
+    }
+
+    GatewayLink &link;
+    GatewayNode nodes[GATEWAY_NODES] = {};
+};
+
+// Forwards the samples of the nodes to InfluxDB, as many per request as fit the buffer. Every
+// line is tagged with the node it came from.
+class GatewayForwarder : public InfluxUploader {
+public:
+    GatewayForwarder(UploadTransport &transport, char *buffer, size_t capacity, GatewayQueue &samples)
+        : InfluxUploader(transport, buffer, capacity), samples(samples) {
+    }
+
+    using InfluxUploader::step;
+
+    // now_s is the gateway's station clock the samples were stamped with
+    void step(uint32_t now_ms, const ClockSync &clock, uint32_t now_s) {
+        this->now_s = now_s;
+        step(now_ms, clock);
+    }
+
+protected:
+    bool pending() const override {
+        return samples.size() > 0;
+    }
+
+    // the samples only have the gateway's station clock, they wait for SNTP
+    bool ready(const ClockSync &clock) const override {
+        return pending() && clock.valid;
+    }
+
+    bool encodeBody(const ClockSync &clock) override {
+        char node[12];
+        uint8_t count = 0;
+        body.reset();
+        for(uint16_t i = 0; i < samples.size(); i++) {
+            const GatewaySample &item = samples.at(i);
+            snprintf(node, sizeof node, "%06lx", (unsigned long) item.node);
+            body.beginLine(prefix);
+            body.tag("node", node);
+            body.field("temperature_C", sampleTemperature(item.sample), 1);
+            body.field("humidity", sampleHumidity(item.sample), 0);
+            body.timestamp(clock.unixTime(item.sample.timestamp_s));
+            if(!body.endLine()) {
+                break;
+            }
+            count++;
+        }
+        inFlight = count;
+        return count > 0;
+    }
+
+    void removeInFlight() override {
+        samples.drop(inFlight, now_s);
+    }
+
+private:
+    GatewayQueue &samples;
+    uint32_t now_s = 0;
+};
+
+#endif
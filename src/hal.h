@@ -0,0 +1,67 @@
+#ifndef __HAL__
+#define __HAL__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "sensor.h"
+#include "sensors.h"
+#include "uploader.h"
+#include "udp.h"
+#include "gateway.h"
+#include "wificache.h"
+#include "spool.h"
+
+// Platform services the station logic (station.h, influx.h) is built on. The firmware implements
+// them in hal_esp8266.h and main.cpp, the simulator in sim/hal_sim.h, so everything above this
+// runs unchanged on a board and on a Linux host.
+
+// milliseconds since this wake started
+unsigned long halMillis();
+void halDelay(unsigned long ms);
+// lets the platform do its background work during long loops
+void halYield();
+// unix time, below MIN_VALID_TIME while SNTP hasn't synced
+time_t halTime();
+// printf style, one line per call
+void halLog(const char *format, ...);
+uint32_t halRandom();
+// tells the stations apart, e.g. the chip id
+uint32_t halDeviceId();
+
+// memory that survives deep sleep but not a power cycle
+void halRtcRead(void *data, size_t size);
+void halRtcWrite(const void *data, size_t size);
+// doesn't return, the station starts over from setup() after the interval
+void halDeepSleep(uint32_t seconds);
+
+ClimateSensor &halSensor();
+// the bus the other sensors are found on, see sensors.h
+SensorBus &halSensorBus();
+
+// Starts associating with the cached access point details in the background and returns right
+// away, false when they aren't usable
+bool halWifiBegin(WIFI_CACHE &cache, uint32_t now_s);
+// Brings up wifi, through the cached access point details when they're usable, and completes
+// what halWifiBegin() started. Returns whether the fast path worked.
+bool halWifiConnect(WIFI_CACHE &cache, uint32_t now_s);
+bool halWifiConnected();
+UploadTransport &halUploadTransport();
+DatagramTransport &halDatagramTransport();
+// ESP-NOW on the board, see gateway.h
+GatewayLink &halGatewayLink();
+// the gateway's connection for forwarding, besides the one of its own uploads
+UploadTransport &halForwardTransport();
+// Turns the radio off for the rest of the wake, once what was sent left
+void halWifiOff();
+// mounted on first use, as most wakes don't need it
+SpoolStorage &halSpoolStorage();
+
+// turns the display on after deep sleep
+void halDisplayOn();
+// shows the current readings and connection state
+void halUpdateDisplay();
+// the display keeps showing its content through deep sleep, returns its hash, see Screen
+uint32_t halDisplaySleep();
+
+#endif
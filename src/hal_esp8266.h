@@ -0,0 +1,404 @@
+#ifndef __HAL_ESP8266__
+#define __HAL_ESP8266__
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include <LittleFS.h>
+#include <stdarg.h>
+#include "hal.h"
+
+extern "C" {
+#include <espnow.h>
+#include <user_interface.h>
+}
+
+// The parts of the HAL that only need the ESP8266 core. The ones depending on the sensor,
+// display and WiFiManager instances are implemented in main.cpp.
+
+#define INFLUX_CONNECT_TIMEOUT_MS 2000
+// the SDK transmits queued frames in the background, the last of them needs a moment to leave
+#define WIFI_OFF_FLUSH_MS 10
+// ESP-NOW frames the SDK handed over that loop() didn't take yet
+#define ESPNOW_RECEIVE_FRAMES 4
+
+unsigned long halMillis() {
+    return millis();
+}
+
+void halDelay(unsigned long ms) {
+    delay(ms);
+}
+
+void halYield() {
+    yield();
+}
+
+time_t halTime() {
+    return time(nullptr);
+}
+
+void halLog(const char *format, ...) {
+    char line[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof line, format, args);
+    va_end(args);
+    Serial.println(line);
+}
+
+uint32_t halRandom() {
+    return ESP.random();
+}
+
+uint32_t halDeviceId() {
+    return ESP.getChipId();
+}
+
+void halRtcRead(void *data, size_t size) {
+    ESP.rtcUserMemoryRead(0, (uint32_t*) data, size);
+}
+
+void halRtcWrite(const void *data, size_t size) {
+    ESP.rtcUserMemoryWrite(0, (uint32_t*) data, size);
+}
+
+void halDeepSleep(uint32_t seconds) {
+    ESP.deepSleep(1e6 * seconds);
+}
+
+bool halWifiConnected() {
+    return WiFi.isConnected();
+}
+
+class WiFiClientTransport : public UploadTransport {
+public:
+    bool connect(const char *host, uint16_t port) override {
+        client.setTimeout(INFLUX_CONNECT_TIMEOUT_MS);
+        if(!client.connect(host, port)) {
+            return false;
+        }
+        client.setNoDelay(true);
+        return true;
+    }
+
+    bool connected() override {
+        return client.connected();
+    }
+
+    size_t write(const uint8_t *data, size_t length) override {
+        // no more than the send buffer takes, beyond that WiFiClient waits for the server's ACKs
+        size_t room = client.availableForWrite();
+        if(room > 0 && room < length) {
+            length = room;
+        }
+        return client.write(data, length);
+    }
+
+    int available() override {
+        return client.available();
+    }
+
+    int read() override {
+        return client.read();
+    }
+
+    void stop() override {
+        client.stop();
+    }
+
+private:
+    WiFiClient client;
+};
+
+UploadTransport &halUploadTransport() {
+    static WiFiClientTransport transport;
+    return transport;
+}
+
+UploadTransport &halForwardTransport() {
+    static WiFiClientTransport transport;
+    return transport;
+}
+
+class WiFiUdpTransport : public DatagramTransport {
+public:
+    bool send(const char *host, uint16_t port, const uint8_t *data, size_t length) override {
+        // resolved again for each datagram, there's only a few per wake
+        if(!udp.beginPacket(host, port)) {
+            return false;
+        }
+        udp.write(data, length);
+        return udp.endPacket();
+    }
+
+private:
+    WiFiUDP udp;
+};
+
+DatagramTransport &halDatagramTransport() {
+    static WiFiUdpTransport transport;
+    return transport;
+}
+
+class LittleFSStorage : public SpoolStorage {
+public:
+    uint32_t size(const char *path) override {
+        if(!mount()) {
+            return 0;
+        }
+        File file = LittleFS.open(path, "r");
+        uint32_t size = file ? file.size() : 0;
+        file.close();
+        return size;
+    }
+
+    bool append(const char *path, const uint8_t *data, size_t length) override {
+        if(!mount()) {
+            return false;
+        }
+        File file = LittleFS.open(path, "a");
+        bool ok = file && file.write(data, length) == length;
+        file.close();
+        return ok;
+    }
+
+    size_t read(const char *path, uint32_t offset, uint8_t *data, size_t length) override {
+        if(!mount()) {
+            return 0;
+        }
+        File file = LittleFS.open(path, "r");
+        size_t n = file && file.seek(offset) ? file.read(data, length) : 0;
+        file.close();
+        return n;
+    }
+
+    bool remove(const char *path) override {
+        return mount() && LittleFS.remove(path);
+    }
+
+    bool rename(const char *from, const char *to) override {
+        if(!mount()) {
+            return false;
+        }
+        LittleFS.remove(to);
+        return LittleFS.rename(from, to);
+    }
+
+private:
+    bool mount() {
+        if(!mounted) {
+            // formats an unformatted partition, there's nothing else on it
+            mounted = LittleFS.begin();
+            if(!mounted) {
+                Serial.println("LittleFS mount failed");
+            }
+        }
+        return mounted;
+    }
+
+    bool mounted = false;
+};
+
+SpoolStorage &halSpoolStorage() {
+    static LittleFSStorage storage;
+    return storage;
+}
+
+void cacheWifi(WIFI_CACHE &cache, uint32_t now_s) {
+    if(!WiFi.isConnected()) {
+        return;
+    }
+    cache.channel = WiFi.channel();
+    memcpy(cache.bssid, WiFi.BSSID(), sizeof cache.bssid);
+    cache.ip = WiFi.localIP();
+    cache.gateway = WiFi.gatewayIP();
+    cache.subnet = WiFi.subnetMask();
+    cache.dns = WiFi.dnsIP();
+    cache.cachedAt_s = now_s;
+    cache.valid = true;
+}
+
+bool fastConnecting = false;
+unsigned long fastConnectStart = 0;
+
+// Starts connecting straight to the cached access point with the cached IP configuration and
+// returns right away. The SSID and password are the ones the SDK stored for the last connection.
+bool beginFastConnect(WIFI_CACHE &cache, uint32_t now_s) {
+    if(fastConnecting) {
+        return true;
+    }
+    if(!wifiCacheUsable(cache, now_s)) {
+        return false;
+    }
+    String ssid = WiFi.SSID();
+    String psk = WiFi.psk();
+    if(ssid.length() == 0) {
+        return false;
+    }
+
+    // credentials didn't change, don't wear the flash by storing them again
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+    WiFi.begin(ssid.c_str(), psk.c_str(), cache.channel, cache.bssid, true);
+    WiFi.persistent(true);
+    fastConnecting = true;
+    fastConnectStart = millis();
+    return true;
+}
+
+// Waits for the fast connect to complete. On failure the cache is invalidated and DHCP
+// re-enabled, so the caller can fall back to a full connect.
+bool fastConnect(WIFI_CACHE &cache, uint32_t now_s) {
+    if(!beginFastConnect(cache, now_s)) {
+        return false;
+    }
+    while(WiFi.status() != WL_CONNECTED && millis() - fastConnectStart < FAST_CONNECT_TIMEOUT_MS) {
+        delay(10);
+    }
+    fastConnecting = false;
+    if(WiFi.status() == WL_CONNECTED) {
+        return true;
+    }
+
+    Serial.println("Fast connect failed");
+    cache.valid = false;
+    // a persistent disconnect would also erase the stored credentials
+    WiFi.persistent(false);
+    WiFi.disconnect();
+    WiFi.persistent(true);
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    return false;
+}
+
+bool halWifiBegin(WIFI_CACHE &cache, uint32_t now_s) {
+    return beginFastConnect(cache, now_s);
+}
+
+void radioOff() {
+    // only for this wake, the next one connects with the stored credentials again
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_OFF);
+    WiFi.persistent(true);
+    WiFi.forceSleepBegin();
+}
+
+void halWifiOff() {
+    if(WiFi.isConnected()) {
+        delay(WIFI_OFF_FLUSH_MS);
+    } else if(!fastConnecting) {
+        return;
+    }
+    fastConnecting = false;
+    radioOff();
+}
+
+// ESP-NOW in station mode, so a gateway keeps its connection to the access point while it
+// listens. Nodes bring up the radio without associating and turn it off again in end().
+// Replies go to the sender as a peer, or broadcast once the SDK's table of 20 peers is full.
+class EspNowLink : public GatewayLink {
+public:
+    bool begin(uint8_t channel) override {
+        if(started) {
+            return true;
+        }
+        ownRadio = !WiFi.isConnected();
+        if(ownRadio) {
+            // without the association the SDK would start on its own with the stored credentials
+            WiFi.persistent(false);
+            WiFi.mode(WIFI_STA);
+            WiFi.disconnect();
+            WiFi.persistent(true);
+            if(channel > 0) {
+                wifi_set_channel(channel);
+            }
+        }
+        this->channel = wifi_get_channel();
+        if(esp_now_init() != 0) {
+            return false;
+        }
+        esp_now_set_self_role(ESP_NOW_ROLE_COMBO);
+        esp_now_add_peer((uint8_t *) gatewayBroadcast, ESP_NOW_ROLE_COMBO, this->channel, NULL, 0);
+        instance = this;
+        esp_now_register_recv_cb(received);
+        started = true;
+        return true;
+    }
+
+    bool ready() override {
+        return started;
+    }
+
+    bool send(const uint8_t *address, const uint8_t *data, size_t length) override {
+        uint8_t *peer = (uint8_t *) address;
+        if(esp_now_is_peer_exist(peer) <= 0 && esp_now_add_peer(peer, ESP_NOW_ROLE_COMBO, channel, NULL, 0) != 0) {
+            // the frame tells which node it's for
+            peer = (uint8_t *) gatewayBroadcast;
+        }
+        return esp_now_send(peer, (uint8_t *) data, length) == 0;
+    }
+
+    size_t receive(uint8_t *address, uint8_t *data, size_t capacity) override {
+        if(head == tail) {
+            return 0;
+        }
+        const Frame &frame = frames[tail % ESPNOW_RECEIVE_FRAMES];
+        size_t length = frame.length < capacity ? frame.length : capacity;
+        memcpy(address, frame.address, GATEWAY_ADDRESS_SIZE);
+        memcpy(data, frame.data, length);
+        tail++;
+        return length;
+    }
+
+    void end() override {
+        if(!started) {
+            return;
+        }
+        esp_now_unregister_recv_cb();
+        esp_now_deinit();
+        started = false;
+        if(ownRadio) {
+            radioOff();
+        }
+    }
+
+private:
+    struct Frame {
+        uint8_t address[GATEWAY_ADDRESS_SIZE];
+        uint8_t data[GATEWAY_FRAME_MAX];
+        uint8_t length;
+    };
+
+    // The SDK calls this in between loop() iterations, like the other WiFi events. Frames
+    // that find the buffer full are lost, their nodes send them again.
+    static void received(uint8_t *address, uint8_t *data, uint8_t length) {
+        EspNowLink &link = *instance;
+        if((uint8_t) (link.head - link.tail) >= ESPNOW_RECEIVE_FRAMES || length > GATEWAY_FRAME_MAX) {
+            return;
+        }
+        Frame &frame = link.frames[link.head % ESPNOW_RECEIVE_FRAMES];
+        memcpy(frame.address, address, GATEWAY_ADDRESS_SIZE);
+        memcpy(frame.data, data, length);
+        frame.length = length;
+        link.head++;
+    }
+
+    static EspNowLink *instance;
+
+    Frame frames[ESPNOW_RECEIVE_FRAMES];
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+    uint8_t channel = 0;
+    bool started = false;
+    bool ownRadio = false;
+};
+
+EspNowLink *EspNowLink::instance = NULL;
+
+GatewayLink &halGatewayLink() {
+    static EspNowLink link;
+    return link;
+}
+
+#endif
@@ -1,33 +1,229 @@
 #ifndef __INFLUX__
 #define __INFLUX__
 
-#include "settings.h"
-#include <Arduino.h>
-#include <ESP8266HTTPClient.h>
-
-int lastInfluxPostResult = 0;
-
-void syncInflux(float temperature_C, float humidity_pct) {
-    if(settings.influxEnabled && WiFi.isConnected()) {
-        Serial.println("Syncing to influx");
-        String url = "/write?db=" + String(settings.influxDatabase);
-        String payload = String(settings.influxSeries);
-        if(settings.influxTags[0] != 0) {
-            payload += "," + String(settings.influxTags);
+#include "config.h"
+#include "hal.h"
+#include "samples.h"
+#include "lineprotocol.h"
+#include "uploader.h"
+#include "mqtt.h"
+#include "udp.h"
+#include "gateway.h"
+#include "spool.h"
+
+#define INFLUX_PAYLOAD_SIZE 1024
+// how long a deep sleep wake keeps replaying spooled samples after the queue was uploaded
+#define INFLUX_REPLAY_BUDGET_MS 3000
+
+// measurement and tags are the same for every line, so they're escaped once when settings change
+char influxPrefix[2 * sizeof settings.influxSeries + 2 * sizeof settings.influxTags + 2];
+char influxUrl[sizeof settings.influxDatabase + 24];
+char influxPayload[INFLUX_PAYLOAD_SIZE];
+char mqttTopic[sizeof settings.mqttTopic + sizeof settings.influxSeries + 16];
+char mqttClientId[24];
+
+// Only the uploader of the protocol in the settings is used, so they share the payload buffer
+// and the transport
+InfluxUploader influxUploader(halUploadTransport(), influxPayload, sizeof influxPayload);
+MqttUploader mqttUploader(halUploadTransport(), influxPayload, sizeof influxPayload);
+UdpUploader udpUploader(halDatagramTransport(), influxPayload, sizeof influxPayload);
+GatewayUploader gatewayUploader(halGatewayLink());
+Uploader *activeUploader = &influxUploader;
+
+// The gateway role, separate from the station's own uploads as it forwards on a connection of
+// its own and in larger batches
+char gatewayPrefix[2 * sizeof settings.influxSeries + 1];
+char gatewayPayload[GATEWAY_PAYLOAD_SIZE];
+Gateway gateway(halGatewayLink());
+GatewayForwarder gatewayForwarder(halForwardTransport(), gatewayPayload, sizeof gatewayPayload, gateway.queue);
+
+SampleSpool influxSpool(halSpoolStorage(), "/spool.log", "/spool.tmp");
+SampleBuffer *influxQueue = NULL;
+// a chunk of the spool being uploaded, in RAM as it's read again when a wake doesn't finish it
+SampleBuffer influxReplay;
+uint32_t influxReplayBytes = 0;
+bool influxReplaying = false;
+
+// samples is the queue the station adds to, cursor the position in the spool, both in RTC
+// memory, and clock the station clock the samples are stamped with
+void setInfluxQueue(SampleBuffer &samples, SpoolCursor &cursor, uint32_t (*clock)()) {
+    influxQueue = &samples;
+    influxUploader.setQueue(samples);
+    mqttUploader.setQueue(samples);
+    udpUploader.setQueue(samples);
+    gatewayUploader.setQueue(samples);
+    gatewayUploader.setNode(halDeviceId(), cursor.boot, clock);
+    influxSpool.setCursor(cursor);
+}
+
+// the extra fields and lines of the newest sample, see Uploader
+void setInfluxStatistics(ClimateAggregate &aggregate, const EnergyAccount &energy, const uint32_t *current_uA, const SensorRegistry &sensors) {
+    influxUploader.setAggregate(aggregate);
+    influxUploader.setEnergy(energy, current_uA);
+    influxUploader.setSensors(sensors);
+    mqttUploader.setAggregate(aggregate);
+    mqttUploader.setEnergy(energy, current_uA);
+    mqttUploader.setSensors(sensors);
+    udpUploader.setAggregate(aggregate);
+    udpUploader.setEnergy(energy, current_uA);
+    udpUploader.setSensors(sensors);
+}
+
+// Applies the upload settings, after the last of the upload settings changed
+void updateUploadTarget() {
+    if(influxReplaying) {
+        // the chunk is read from the spool again once the new target is up
+        influxReplaying = false;
+        influxReplay.clear();
+        influxUploader.setQueue(*influxQueue);
+        mqttUploader.setQueue(*influxQueue);
+        udpUploader.setQueue(*influxQueue);
+        gatewayUploader.setQueue(*influxQueue);
+    }
+    if(!buildLineProtocolPrefix(influxPrefix, sizeof influxPrefix, settings.influxSeries, settings.influxTags)) {
+        halLog("Influx series and tags don't fit");
+    }
+    snprintf(influxUrl, sizeof influxUrl, "/write?db=%s&precision=s", settings.influxDatabase);
+    snprintf(mqttClientId, sizeof mqttClientId, "climate-%06lx", (unsigned long) halDeviceId());
+    if(!expandMqttTopic(mqttTopic, sizeof mqttTopic, settings.mqttTopic, mqttClientId, settings.influxSeries)) {
+        halLog("MQTT topic doesn't fit");
+    }
+    // the host may have changed, don't reuse a connection to the old one
+    influxUploader.setTarget(settings.influxHost, settings.influxPort, influxUrl, influxPrefix);
+    mqttUploader.setTarget(settings.mqttHost, settings.mqttPort, mqttClientId, mqttTopic, influxPrefix, settings.mqttQos, settings.mqttRetain);
+    udpUploader.setTarget(settings.influxHost, settings.influxUdpPort, influxPrefix);
+    // the nodes have tags of their own
+    buildLineProtocolPrefix(gatewayPrefix, sizeof gatewayPrefix, settings.influxSeries, "");
+    gatewayForwarder.setTarget(settings.influxHost, settings.influxPort, influxUrl, gatewayPrefix);
+    switch(settings.uploadProtocol) {
+    case UPLOAD_MQTT:
+        activeUploader = &mqttUploader;
+        break;
+    case UPLOAD_UDP:
+        activeUploader = &udpUploader;
+        break;
+    case UPLOAD_GATEWAY:
+        activeUploader = &gatewayUploader;
+        break;
+    default:
+        activeUploader = &influxUploader;
+        break;
+    }
+}
+
+// whether the active uploader can get its samples out, the gateway link doesn't need wifi
+bool influxReachable() {
+    return settings.uploadProtocol == UPLOAD_GATEWAY ? halGatewayLink().ready() : halWifiConnected();
+}
+
+// Moves a full queue to the spool instead of letting it drop its oldest sample, as long as
+// the uploader isn't sending from it. Not on a node of a gateway, which never learns the time
+// to replay them with.
+void spoolInflux(const ClockSync &clock) {
+    if(!settings.influxEnabled || !influxQueue->full() || settings.uploadProtocol == UPLOAD_GATEWAY) {
+        return;
+    }
+    if(!influxReplaying && !activeUploader->idle() && activeUploader->state() != Uploader::BACKOFF) {
+        return;
+    }
+    if(influxSpool.append(*influxQueue, clock)) {
+        halLog("Spooled %u samples", (unsigned) influxQueue->size());
+        influxQueue->drop(influxQueue->size());
+    } else {
+        halLog("Spooling failed");
+    }
+}
+
+// Switches the uploader between the queue and chunks of the spool, in between requests. The
+// queue goes first, the spool needs the time to place its samples.
+void replayInflux(const ClockSync &clock, bool startChunk) {
+    if(!activeUploader->idle()) {
+        return;
+    }
+    if(influxReplaying) {
+        if(!influxReplay.empty()) {
+            return;
         }
-        payload += " temperature_C=" + String(temperature_C, 1) + ",humidity=" + String(humidity_pct, 0);
-        
-        HTTPClient http;
-        http.begin(settings.influxHost, settings.influxPort, url);
-        Serial.println("Sending request to " + String(settings.influxHost) + ":" + String(settings.influxPort) + " / " + url + " for: " + payload);
-        lastInfluxPostResult = http.POST(payload);
-        if(lastInfluxPostResult == HTTPC_ERROR_CONNECTION_REFUSED) {
-            Serial.println("Influx refused connection");
-        } else {
-            Serial.println("Influx replied " + String(lastInfluxPostResult));
+        influxSpool.consumed(influxReplayBytes);
+        influxReplaying = false;
+        activeUploader->setQueue(*influxQueue);
+    }
+    if(!startChunk || !clock.valid || !influxQueue->empty() || !influxSpool.pending()) {
+        return;
+    }
+    influxReplay.clear();
+    influxReplayBytes = influxSpool.load(influxReplay, clock);
+    influxReplaying = true;
+    activeUploader->setQueue(influxReplay, false);
+}
+
+// Encodes the first upload ahead of the connection, so it's ready to go out once wifi is up.
+// Only while the clock doesn't sync this wake, as that changes the timestamps.
+void prepareInflux(const ClockSync &clock) {
+    if(!settings.influxEnabled || influxQueue->empty() || !activeUploader->idle()) {
+        return;
+    }
+    activeUploader->step(halMillis(), clock);
+}
+
+// Advances the upload of queued and spooled samples by one step without blocking, call this
+// from loop()
+void serviceInflux(const ClockSync &clock, bool replay = true) {
+    if(!settings.influxEnabled || !influxReachable()) {
+        return;
+    }
+    replayInflux(clock, replay);
+    unsigned long succeeded = activeUploader->uploadsSucceeded;
+    unsigned long failed = activeUploader->uploadsFailed;
+    activeUploader->step(halMillis(), clock);
+    if(activeUploader->uploadsSucceeded != succeeded) {
+        halLog("Server replied %d", activeUploader->lastResult);
+    } else if(activeUploader->uploadsFailed != failed) {
+        halLog("Upload failed with %d, retrying in %lu ms", activeUploader->lastResult, (unsigned long) activeUploader->backoff());
+    }
+}
+
+// Uploads all queued samples, and spooled ones for up to INFLUX_REPLAY_BUDGET_MS, before
+// returning. For the deep sleep wake where there is nothing else to do in the meantime.
+// Returns false as soon as an upload fails.
+bool syncInflux(const ClockSync &clock) {
+    if(!settings.influxEnabled || !influxReachable()) {
+        return false;
+    }
+    SampleBuffer &samples = *influxQueue;
+    halLog("Syncing %u samples to influx", (unsigned) samples.size());
+    unsigned long start = halMillis();
+    while(activeUploader->ready(clock) || !activeUploader->idle() || influxReplaying ||
+            (clock.valid && halMillis() - start < INFLUX_REPLAY_BUDGET_MS && influxSpool.pending())) {
+        serviceInflux(clock, halMillis() - start < INFLUX_REPLAY_BUDGET_MS);
+        if(activeUploader->state() == Uploader::BACKOFF) {
+            return false;
         }
+        halYield();
+    }
+    if(!samples.empty()) {
+        halLog("%u samples wait for the clock", (unsigned) samples.size());
+    }
+    return true;
+}
 
-        http.end();
+// Takes in what the nodes sent and forwards it once a batch is due, call this from loop().
+// now_s is the station clock the gateway stamps the samples with.
+void serviceGateway(const ClockSync &clock, uint32_t now_s) {
+    if(!settings.gatewayEnabled) {
+        return;
+    }
+    gateway.receive(now_s);
+    if(!halWifiConnected() || (gatewayForwarder.idle() && !gateway.queue.due(now_s, GATEWAY_BATCH_SAMPLES, settings.batchMaxAge))) {
+        return;
+    }
+    unsigned long succeeded = gatewayForwarder.uploadsSucceeded;
+    unsigned long failed = gatewayForwarder.uploadsFailed;
+    gatewayForwarder.step(halMillis(), clock, now_s);
+    if(gatewayForwarder.uploadsSucceeded != succeeded) {
+        halLog("Forwarded for %u nodes, server replied %d", (unsigned) gateway.nodeCount(), gatewayForwarder.lastResult);
+    } else if(gatewayForwarder.uploadsFailed != failed) {
+        halLog("Forwarding failed with %d, retrying in %lu ms", gatewayForwarder.lastResult, (unsigned long) gatewayForwarder.backoff());
     }
 }
 
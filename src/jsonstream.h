@@ -0,0 +1,374 @@
+#ifndef __JSON_STREAM__
+#define __JSON_STREAM__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "sink.h"
+
+// JSON without a document in memory: JsonWriter writes through a small buffer to a sink as it
+// goes, JsonReader is fed a character at a time and hands every value to a handler along with
+// its path, e.g. "influx.host". Enough for flat settings objects, arrays aren't supported.
+
+#define JSON_WRITER_BUFFER 128
+#define JSON_READER_DEPTH 4
+#define JSON_PATH_SIZE 48
+#define JSON_TOKEN_SIZE 72  // longest string or number a value may have
+
+class JsonWriter {
+public:
+    JsonWriter(OutputSink &sink) : sink(sink) {
+    }
+
+    // key is NULL for the outermost object
+    void beginObject(const char *key = NULL) {
+        if(key != NULL) {
+            name(key);
+        } else {
+            separate();
+        }
+        put('{');
+        first = true;
+    }
+
+    void endObject() {
+        put('}');
+        first = false;
+    }
+
+    void string(const char *key, const char *value) {
+        name(key);
+        quoted(value);
+    }
+
+    void number(const char *key, long value) {
+        name(key);
+        char text[12];
+        int length = snprintf(text, sizeof text, "%ld", value);
+        append(text, length);
+    }
+
+    void boolean(const char *key, bool value) {
+        name(key);
+        append(value ? "true" : "false", value ? 4 : 5);
+    }
+
+    // hands what's buffered to the sink, must be called at the end
+    void flush() {
+        if(length > 0) {
+            sink.write(buffer, length);
+            written += length;
+            length = 0;
+        }
+    }
+
+    size_t written = 0;
+
+private:
+    void separate() {
+        if(!first) {
+            put(',');
+        }
+        first = false;
+    }
+
+    void name(const char *key) {
+        separate();
+        quoted(key);
+        put(':');
+    }
+
+    void quoted(const char *text) {
+        put('"');
+        for(; *text; text++) {
+            char c = *text;
+            if(c == '"' || c == '\\') {
+                put('\\');
+                put(c);
+            } else if((uint8_t) c < 0x20) {
+                char escape[7];
+                snprintf(escape, sizeof escape, "\\u%04x", (unsigned) c);
+                append(escape, 6);
+            } else {
+                put(c);
+            }
+        }
+        put('"');
+    }
+
+    void append(const char *text, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            put(text[i]);
+        }
+    }
+
+    void put(char c) {
+        if(length == sizeof buffer) {
+            flush();
+        }
+        buffer[length++] = c;
+    }
+
+    OutputSink &sink;
+    char buffer[JSON_WRITER_BUFFER];
+    size_t length = 0;
+    bool first = true;
+};
+
+// Receives the values JsonReader comes across
+class JsonHandler {
+public:
+    virtual ~JsonHandler() {}
+    // quoted tells a string from a number or literal. Returning false stops the reader.
+    virtual bool value(const char *path, const char *value, bool quoted) = 0;
+};
+
+class JsonReader {
+public:
+    JsonReader(JsonHandler &handler) : handler(handler) {
+    }
+
+    // Returns false once the input turned out invalid or the handler refused a value
+    bool feed(char c) {
+        if(error != NULL) {
+            return false;
+        }
+        switch(current) {
+        case START:
+            if(c == '{') {
+                depth = 1;
+                prefix[0] = 0;
+                current = KEY_OR_END;
+            } else if(!space(c)) {
+                fail("Expected an object");
+            }
+            break;
+        case KEY_OR_END:
+        case KEY:
+            if(c == '"') {
+                begin(true);
+                current = STRING;
+            } else if(c == '}' && current == KEY_OR_END) {
+                close();
+            } else if(!space(c)) {
+                fail("Expected a key");
+            }
+            break;
+        case COLON:
+            if(c == ':') {
+                current = VALUE;
+            } else if(!space(c)) {
+                fail("Expected ':'");
+            }
+            break;
+        case VALUE:
+            if(c == '"') {
+                begin(false);
+                current = STRING;
+            } else if(c == '{') {
+                if(depth == JSON_READER_DEPTH) {
+                    fail("Nested too deep");
+                    break;
+                }
+                prefix[depth++] = pathLength;
+                current = KEY_OR_END;
+            } else if(c == '[') {
+                fail("Arrays aren't supported");
+            } else if(literal(c)) {
+                begin(false);
+                add(c);
+                current = LITERAL;
+            } else if(!space(c)) {
+                fail("Expected a value");
+            }
+            break;
+        case STRING:
+            if(c == '\\') {
+                current = ESCAPE;
+            } else if(c == '"') {
+                endString();
+            } else if((uint8_t) c < 0x20) {
+                fail("Control character in string");
+            } else {
+                add(c);
+            }
+            break;
+        case ESCAPE:
+            escape(c);
+            break;
+        case UNICODE:
+            unicodeDigit(c);
+            break;
+        case LITERAL:
+            if(literal(c)) {
+                add(c);
+                break;
+            }
+            deliver(false);
+            if(error == NULL) {
+                current = COMMA_OR_END;
+                return feed(c);
+            }
+            break;
+        case COMMA_OR_END:
+            if(c == ',') {
+                current = KEY;
+            } else if(c == '}') {
+                close();
+            } else if(!space(c)) {
+                fail("Expected ',' or '}'");
+            }
+            break;
+        case DONE:
+            if(!space(c)) {
+                fail("Trailing characters");
+            }
+            break;
+        }
+        return error == NULL;
+    }
+
+    bool feed(const char *data, size_t length) {
+        for(size_t i = 0; i < length; i++) {
+            if(!feed(data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether a whole object was read without errors
+    bool finish() {
+        if(error == NULL && current != DONE) {
+            fail("Unexpected end");
+        }
+        return error == NULL;
+    }
+
+    // why reading stopped, NULL if it didn't
+    const char *error = NULL;
+
+private:
+    enum State {
+        START, KEY_OR_END, KEY, COLON, VALUE, STRING, ESCAPE, UNICODE, LITERAL, COMMA_OR_END, DONE
+    };
+
+    static bool space(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static bool literal(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+    }
+
+    void fail(const char *message) {
+        error = message;
+    }
+
+    void begin(bool key) {
+        isKey = key;
+        tokenLength = 0;
+    }
+
+    void add(char c) {
+        if(tokenLength == sizeof token - 1) {
+            fail("Value too long");
+            return;
+        }
+        token[tokenLength++] = c;
+    }
+
+    void endString() {
+        if(!isKey) {
+            deliver(true);
+            current = COMMA_OR_END;
+            return;
+        }
+        // the path of a key is that of its object, a dot and the key
+        size_t at = prefix[depth - 1];
+        if(at + (at > 0) + tokenLength >= sizeof path) {
+            fail("Key too long");
+            return;
+        }
+        if(at > 0) {
+            path[at++] = '.';
+        }
+        memcpy(path + at, token, tokenLength);
+        pathLength = at + tokenLength;
+        path[pathLength] = 0;
+        current = COLON;
+    }
+
+    void deliver(bool quoted) {
+        token[tokenLength] = 0;
+        if(!handler.value(path, token, quoted)) {
+            fail("Value not accepted");
+        }
+    }
+
+    void close() {
+        depth--;
+        current = depth == 0 ? DONE : COMMA_OR_END;
+    }
+
+    void escape(char c) {
+        const char *from = "\"\\/bfnrt";
+        const char *to = "\"\\/\b\f\n\r\t";
+        const char *at = strchr(from, c);
+        current = STRING;
+        if(c == 'u') {
+            unicode = 0;
+            digits = 0;
+            current = UNICODE;
+        } else if(c != 0 && at != NULL) {
+            add(to[at - from]);
+        } else {
+            fail("Invalid escape");
+        }
+    }
+
+    void unicodeDigit(char c) {
+        uint8_t digit;
+        if(c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if(c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if(c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            fail("Invalid escape");
+            return;
+        }
+        unicode = unicode << 4 | digit;
+        if(++digits < 4) {
+            return;
+        }
+        // as UTF-8, surrogate pairs are left as they are
+        if(unicode < 0x80) {
+            add(unicode);
+        } else if(unicode < 0x800) {
+            add(0xC0 | unicode >> 6);
+            add(0x80 | (unicode & 0x3F));
+        } else {
+            add(0xE0 | unicode >> 12);
+            add(0x80 | (unicode >> 6 & 0x3F));
+            add(0x80 | (unicode & 0x3F));
+        }
+        current = STRING;
+    }
+
+    JsonHandler &handler;
+    State current = START;
+    uint8_t depth = 0;
+    uint8_t prefix[JSON_READER_DEPTH];  // path length of the object at each depth
+    char path[JSON_PATH_SIZE] = "";
+    size_t pathLength = 0;
+    char token[JSON_TOKEN_SIZE];
+    size_t tokenLength = 0;
+    bool isKey = false;
+    uint16_t unicode = 0;
+    uint8_t digits = 0;
+};
+
+#endif
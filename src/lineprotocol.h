@@ -0,0 +1,169 @@
+#ifndef __LINEPROTOCOL__
+#define __LINEPROTOCOL__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "numberformat.h"
+
+// Escapes the characters in special with a backslash, as line protocol requires for
+// measurement names and tag values. Returns false if dst is too small.
+inline bool escapeLineProtocol(char *dst, size_t capacity, const char *src, const char *special) {
+    size_t len = 0;
+    for(; *src; src++) {
+        if(strchr(special, *src) != NULL) {
+            if(len + 1 >= capacity) {
+                return false;
+            }
+            dst[len++] = '\\';
+        }
+        if(len + 1 >= capacity) {
+            return false;
+        }
+        dst[len++] = *src;
+    }
+    dst[len] = 0;
+    return true;
+}
+
+// Builds the constant "measurement,tag=value" part of every line. tags is a comma separated
+// list of key=value pairs as entered in the settings, only spaces in it need escaping.
+inline bool buildLineProtocolPrefix(char *dst, size_t capacity, const char *measurement, const char *tags) {
+    if(!escapeLineProtocol(dst, capacity, measurement, ", ")) {
+        return false;
+    }
+    if(tags[0] == 0) {
+        return true;
+    }
+    size_t len = strlen(dst);
+    if(len + 2 > capacity) {
+        return false;
+    }
+    dst[len++] = ',';
+    return escapeLineProtocol(dst + len, capacity - len, tags, " ");
+}
+
+// Writes line protocol into a caller supplied buffer without touching the heap. Writes that
+// don't fit mark the writer as overflowed, endLine() then removes the incomplete line so the
+// buffer always holds whole lines.
+class LineProtocolWriter {
+public:
+    LineProtocolWriter(char *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {
+        reset();
+    }
+
+    void reset() {
+        len = 0;
+        lineStart = 0;
+        overflow = false;
+        firstField = true;
+        buffer[0] = 0;
+    }
+
+    // prefix is the escaped measurement and tags, see buildLineProtocolPrefix()
+    void beginLine(const char *prefix) {
+        lineStart = len;
+        overflow = false;
+        firstField = true;
+        append(prefix, strlen(prefix));
+    }
+
+    // A tag on top of the prefix, before the first field
+    void tag(const char *key, const char *value) {
+        append(',');
+        append(key, strlen(key));
+        append('=');
+        for(; *value; value++) {
+            if(*value == ',' || *value == '=' || *value == ' ') {
+                append('\\');
+            }
+            append(*value);
+        }
+    }
+
+    // NaN values are skipped since line protocol can't represent them
+    void field(const char *name, float value, uint8_t decimals) {
+        if(isnan(value)) {
+            return;
+        }
+        beginField(name);
+        appendFixed(value, decimals);
+    }
+
+    void field(const char *name, long value) {
+        beginField(name);
+        if(value < 0) {
+            append('-');
+            appendUnsigned(-(unsigned long) value);
+        } else {
+            appendUnsigned(value);
+        }
+        append('i');
+    }
+
+    void timestamp(uint32_t timestamp) {
+        append(' ');
+        appendUnsigned(timestamp);
+    }
+
+    // Returns false, and discards the line, when it didn't fit or has no fields
+    bool endLine() {
+        append('\n');
+        if(overflow || firstField) {
+            len = lineStart;
+            buffer[len] = 0;
+            return false;
+        }
+        return true;
+    }
+
+    const char *c_str() const {
+        return buffer;
+    }
+
+    size_t length() const {
+        return len;
+    }
+
+private:
+    void beginField(const char *name) {
+        append(firstField ? ' ' : ',');
+        firstField = false;
+        append(name, strlen(name));
+        append('=');
+    }
+
+    void append(const char *s, size_t n) {
+        if(overflow || len + n >= capacity) {
+            overflow = true;
+            return;
+        }
+        memcpy(buffer + len, s, n);
+        len += n;
+        buffer[len] = 0;
+    }
+
+    void append(char c) {
+        append(&c, 1);
+    }
+
+    void appendUnsigned(unsigned long value) {
+        char text[NUMBER_FORMAT_SIZE];
+        append(text, formatUnsigned(text, value));
+    }
+
+    void appendFixed(float value, uint8_t decimals) {
+        char text[NUMBER_FORMAT_SIZE];
+        append(text, formatFixed(text, value, decimals));
+    }
+
+    char *buffer;
+    size_t capacity;
+    size_t len;
+    size_t lineStart;
+    bool overflow;
+    bool firstField;
+};
+
+#endif
@@ -35,10 +35,17 @@
 #include <EEPROM.h>
 #include <ESP8266WebServer.h>
 #include "settings.h"
-#include <ClosedCube_SHT31D.h>
-#include <Ticker.h>
-
-#include "influx.h"
+#include "settingsjson.h"
+#include "metrics.h"
+#include "sht31.h"
+#include "bmp280.h"
+#include "tasks.h"
+#include <time.h>
+
+#include "hal_esp8266.h"
+#include "station.h"
+#include "screen.h"
+#include "status.h"
 
 // Include the correct display library
 // For a connection via I2C using Wire include
@@ -63,62 +70,42 @@
 
 // Initialize the OLED display using Wire library
 SSD1306 display(0x3c, D2, D1);
+Screen screen(display, 0x3c);
 ESP8266WebServer httpServer(80);
 
 const int WAKE_UP_PIN = 14;
 
-const float temperature_threshold = 0.2;
-const float humidity_threshold = 1;
-
 int screenW = 128;
 int screenH = 64;
 
-bool inLowPowerMode = false;
-bool syncNeeded = false;
-
-struct STATE {
-  float temperature_C;
-  float humidity_pct;
-};
-
-STATE state = {
-  NAN, NAN
-};
-
 WiFiManager wifiManager;
-ClosedCube_SHT31D sht3xd;
-Ticker ticker;
+SHT31Sensor sht31(SENSOR_PRIMARY_ADDRESS);
+ClimateSensor &sensor = sht31;
 
-String SHT3XD_Error_to_String(SHT31D_ErrorCode err)
-{
-  switch (err)
-  {
-  case SHT3XD_NO_ERROR:
-    return "SHT3XD_NO_ERROR";
-  case SHT3XD_CRC_ERROR:
-    return "SHT3XD_CRC_ERROR ";
-  case SHT3XD_TIMEOUT_ERROR:
-    return "SHT3XD_TIMEOUT_ERROR ";
-  case SHT3XD_PARAM_WRONG_MODE:
-    return "SHT3XD_PARAM_WRONG_MODE ";
-  case SHT3XD_PARAM_WRONG_REPEATABILITY:
-    return "SHT3XD_PARAM_WRONG_REPEATABILITY ";
-  case SHT3XD_PARAM_WRONG_FREQUENCY:
-    return "SHT3XD_PARAM_WRONG_FREQUENCY ";
-  case SHT3XD_PARAM_WRONG_ALERT:
-    return "SHT3XD_PARAM_WRONG_ALERT ";
-  case SHT3XD_WIRE_I2C_DATA_TOO_LOG:
-    return "SHT3XD_WIRE_I2C_DATA_TOO_LOG ";
-  case SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_ADDRESS:
-    return "SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_ADDRESS ";
-  case SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_DATA:
-    return "SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_DATA ";
-  case SHT3XD_WIRE_I2C_UNKNOW_ERROR:
-    return "SHT3XD_WIRE_I2C_UNKNOW_ERROR ";
-  default: return "WTF?";
+uint32_t schedulerClock() {
+  return micros();
+}
+
+// with light sleep allowed, the radio dozes between beacons while delay() waits
+void schedulerIdle(uint32_t us) {
+  if(us >= 1000) {
+    delay(us / 1000);
+  } else {
+    yield();
   }
 }
 
+// millis() wraps after 49.7 days, the uptime adds up its steps instead
+uint64_t uptime_ms = 0;
+uint32_t uptimeMillis = 0;
+
+// runs what powered mode does, see the tasks in setup()
+Scheduler scheduler(schedulerClock, schedulerIdle);
+uint8_t displayTask = SCHEDULER_NONE;
+uint8_t sampleTask = SCHEDULER_NONE;
+uint8_t uploadTask = SCHEDULER_NONE;
+uint8_t gatewayTask = SCHEDULER_NONE;
+
 void displaySetUpWifi(WiFiManager *wifiManager)
 {
   display.clear();
@@ -127,44 +114,104 @@ void displaySetUpWifi(WiFiManager *wifiManager)
   display.drawString(64, 4, "Connect to:");
   display.drawString(64, 32, wifiManager->getConfigPortalSSID());
 
-  display.display();
+  screen.showFrame();
 }
 
 void updateDisplay()
 {
+  PhaseTimer timer(PHASE_DISPLAY);
+  ScreenContent content;
   String temperature = String(state.temperature_C, 1) + "°";
   String humidity = String(state.humidity_pct, 0) + "%";
-  display.clear();
-  display.setFont(ArialMT_Plain_24);
-  display.setTextAlignment(TEXT_ALIGN_LEFT);
-  display.drawString(0, 32, temperature);
-  display.setTextAlignment(TEXT_ALIGN_RIGHT);
-  display.drawString(128, 32, humidity);
-
-  display.setFont(Dialog_plain_10);
-  display.setTextAlignment(TEXT_ALIGN_LEFT);
+  String status;
+  content.icon = NULL;
   if (inLowPowerMode)
   {
-    display.drawString(0, 0, "Press button to connect");
+    status = statusLines[STATUS_LOW_POWER];
   }
   else if (WiFi.isConnected())
   {
-    display.drawString(0, 0, WiFi.localIP().toString());
-    display.drawXbm(120, 4, status_width, status_height, status_wifi_full_bits);
+    status = WiFi.localIP().toString();
+    content.icon = status_wifi_full_bits;
+  }
+  else if (connectingWifi)
+  {
+    status = statusLines[STATUS_CONNECTING];
+    content.icon = status_wifi_connecting_bits;
   }
   else
   {
-    display.drawString(0, 0, "Not connected");
+    status = statusLines[STATUS_NOT_CONNECTED];
   }
+  temperature.getBytes((unsigned char*) content.temperature, sizeof content.temperature, 0);
+  humidity.getBytes((unsigned char*) content.humidity, sizeof content.humidity, 0);
+  status.getBytes((unsigned char*) content.status, sizeof content.status, 0);
 
-  display.display();
+  screen.show(content);
 }
 
-void enterDeepSleep()
+ClimateSensor &halSensor()
 {
-  ESP.rtcUserMemoryWrite(0, (uint32_t*) &state, sizeof(state));
-  Serial.println("Sleeping for " + String(settings.deepSleepTimer) + " seconds");
-  ESP.deepSleep(1e6 * settings.deepSleepTimer);
+  return sensor;
+}
+
+// A driver for each address in sensorProbes
+class WireSensorBus : public SensorBus {
+public:
+  bool probe(uint8_t address) override {
+    Wire.beginTransmission(address);
+    return Wire.endTransmission() == 0;
+  }
+
+  SensorDriver *driver(uint8_t kind, uint8_t address) override {
+    if(kind == SENSOR_KIND_SHT31 && address == SENSOR_PRIMARY_ADDRESS) {
+      return &sht31;
+    } else if(kind == SENSOR_KIND_SHT31 && address == 0x45) {
+      return &sht31Second;
+    } else if(kind == SENSOR_KIND_BMP280 && address == 0x76) {
+      return &bmp280Low;
+    } else if(kind == SENSOR_KIND_BMP280 && address == 0x77) {
+      return &bmp280High;
+    }
+    return NULL;
+  }
+
+private:
+  SHT31Sensor sht31Second{0x45};
+  BMP280Sensor bmp280Low{0x76};
+  BMP280Sensor bmp280High{0x77};
+};
+
+SensorBus &halSensorBus()
+{
+  static WireSensorBus bus;
+  return bus;
+}
+
+bool halWifiConnect(WIFI_CACHE &cache, uint32_t now_s)
+{
+  if(fastConnect(cache, now_s)) {
+    return true;
+  }
+  wifiManager.autoConnect();
+  cacheWifi(cache, now_s);
+  return false;
+}
+
+void halDisplayOn()
+{
+  display.resume();
+}
+
+void halUpdateDisplay()
+{
+  updateDisplay();
+}
+
+uint32_t halDisplaySleep()
+{
+  Serial.println("Display transfers this wake: " + String(screen.transfers) + " (" + String(screen.pagesSent) + " pages)");
+  return screen.shownHash();
 }
 
 void http_root()
@@ -174,77 +221,112 @@ void http_root()
 
 void http_lowPower()
 {
+  if(settings.gatewayEnabled) {
+    httpServer.send(409, "text/plain", "A gateway has to stay powered to hear its nodes");
+    return;
+  }
   Serial.println("Entering low power mode");
   httpServer.send(200, "text/plain", "OK. Entering low power mode");
   display.setContrast(settings.lowPowerContrast);
   inLowPowerMode = true;
   updateDisplay();
+  // readings from before powered mode say nothing about the current trend
+  state.trend.clear();
+  // the estimate is about running on battery, not about the time spent powered
+  energyMeter.reset(millis());
   enterDeepSleep();
 }
 
+// Free heap at the start of a request and the lowest it went since, sampled whenever a request
+// handler gets the chance
+class HeapWatermark {
+public:
+  void start() {
+    initial = lowest = ESP.getFreeHeap();
+  }
+
+  void sample() {
+    uint32_t free = ESP.getFreeHeap();
+    if(free < lowest) {
+      lowest = free;
+    }
+  }
+
+  uint32_t used() {
+    sample();
+    return initial - lowest;
+  }
+
+private:
+  uint32_t initial = 0;
+  uint32_t lowest = 0;
+};
+
+HeapWatermark settingsHeap;
+
+// Sends writer output as the chunks of a response of unknown length
+class HttpSink : public OutputSink {
+public:
+  void write(const char *data, size_t length) override {
+    httpServer.sendContent(data, length);
+    settingsHeap.sample();
+  }
+};
+
+// The link to the nodes or the gateway, as the settings say
+void updateLink() {
+  if(settings.gatewayEnabled || settings.uploadProtocol == UPLOAD_GATEWAY) {
+    beginLink();
+  } else {
+    halGatewayLink().end();
+  }
+  // a gateway dozing off between beacons would miss the frames of its nodes
+  WiFi.setSleepMode(settings.gatewayEnabled ? WIFI_NONE_SLEEP : WIFI_LIGHT_SLEEP);
+  scheduler.setPeriod(gatewayTask, settings.gatewayEnabled ? GATEWAY_POLL_MS : 0);
+}
+
 void http_handleSettings() {
-    StaticJsonBuffer<512> jsonBuffer;
+    settingsHeap.start();
     if(httpServer.method() == HTTP_GET) {
-        JsonObject& root = jsonBuffer.createObject(); 
-        JsonObject& influx = root.createNestedObject("influx");
-        influx["enabled"] = settings.influxEnabled;
-        influx["host"] = settings.influxHost;
-        influx["port"] = settings.influxPort;
-        influx["database"] = settings.influxDatabase;
-        influx["series"] = settings.influxSeries;
-        influx["tags"] = settings.influxTags;
-        
-        JsonObject& lowPower = root.createNestedObject("lowpower");
-        lowPower["updateInterval"] = settings.deepSleepTimer;
-        lowPower["contrast"] = settings.lowPowerContrast;
-
-        JsonObject& general = root.createNestedObject("general");
-        general["contrast"] = settings.displayContrast;
-
-        String json;
-        root.printTo(json);
-        httpServer.send(200, "text/json", json);
+        HttpSink sink;
+        JsonWriter json(sink);
+        httpServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        httpServer.send(200, "text/json", "");
+        writeSettingsJson(json, settings);
+        json.flush();
+        httpServer.sendContent("");
+        Serial.println("Sent " + String(json.written) + " bytes of settings using " + String(settingsHeap.used()) + " bytes of heap");
     } else if(httpServer.method() == HTTP_POST) {
-        JsonObject& root = jsonBuffer.parseObject(httpServer.arg("plain"));
-        if(!root.success()) {
-          httpServer.send(400, "text/plain", "Body could not be parsed");
+        // ESP8266WebServer has read the whole body into this String already. A raw handler could
+        // feed the reader as the body comes in, but its buffer takes about 1.4 kB, more than
+        // a settings body does.
+        const String &body = httpServer.arg("plain");
+        Serial.println(body);
+        struct_settings update = settings;
+        SettingsJsonParser parser(update);
+        JsonReader reader(parser);
+        reader.feed(body.c_str(), body.length());
+        settingsHeap.sample();
+        if(!reader.finish()) {
+          httpServer.send(400, "text/plain", parser.error[0] ? parser.error : reader.error);
+          return;
         }
-        Serial.println(httpServer.arg("plain"));
-
-        int deepSleepTimer = root["lowpower"]["updateInterval"];
-        bool influxEnabled = root["influx"]["enabled"];
-        String influxDatabase = root["influx"]["database"];
-        String influxHost = root["influx"]["host"];
-        unsigned short influxPort = root["influx"]["port"];
-        String influxSeries = root["influx"]["series"];
-        String influxTags = root["influx"]["tags"];
-        unsigned char contrast = root["general"]["contrast"];
-        unsigned char lowPowerContrast = root["lowpower"]["contrast"];
-
-        // validation
-        if(influxEnabled && (
-            influxDatabase.length() == 0 ||
-            influxHost.length() == 0 ||
-            influxSeries.length() == 0 || 
-            influxPort == 0
-        )) {
-            httpServer.send(400, "text/plain", "Influx enabled but not enough details provided");
-            return;
+        if(!parser.validate()) {
+          httpServer.send(400, "text/plain", parser.error);
+          return;
         }
 
-        settings.deepSleepTimer = deepSleepTimer;
-        settings.influxEnabled = influxEnabled;
-        influxDatabase.getBytes((unsigned char*) &settings.influxDatabase, sizeof settings.influxDatabase, 0);
-        influxPort = influxPort;
-        influxHost.getBytes((unsigned char*) &settings.influxHost, sizeof settings.influxHost, 0);
-        influxSeries.getBytes((unsigned char*) &settings.influxSeries, sizeof settings.influxSeries, 0);
-        influxTags.getBytes((unsigned char*) &settings.influxTags, sizeof settings.influxTags, 0);
-        settings.displayContrast = contrast;
-        settings.lowPowerContrast = lowPowerContrast;
+        settings = update;
         saveSettings();
+        state.filter.clear();
+        updateUploadTarget();
+        updateLink();
 
         display.setContrast(settings.displayContrast);
+        sensor.configure(SENSOR_PERIODIC, (SensorRepeatability) settings.sensorRepeatability);
+        sensor.setHeater(settings.sensorHeater);
 
+        Serial.println("Settings request used " + String(settingsHeap.used()) + " bytes of heap");
         httpServer.send(200, "text/plain", "Settings saved");
     } else {
         httpServer.send(405, "text/plain", "Method not allowed");
@@ -259,78 +341,249 @@ void http_factoryReset() {
 }
 
 void http_influxLastResponse() {
-  httpServer.send(200, "text/plain", String(lastInfluxPostResult));
+  httpServer.send(200, "text/plain", String(activeUploader->lastResult));
 }
 
-bool readClimate() {
-  SHT31D data = sht3xd.periodicFetchData();
-  if(data.error != SHT3XD_NO_ERROR) {
-    Serial.println("[SHT3XD] Read error " + SHT3XD_Error_to_String(data.error));
-    return false;
+void http_influxConnections() {
+  httpServer.send(200, "text/plain", "opened " + String(activeUploader->connectionsOpened) + "\nreused " + String(activeUploader->connectionsReused));
+}
+
+void http_influxQueue() {
+  httpServer.send(200, "text/plain",
+    "queued " + String(state.samples.size()) +
+    "\ndropped " + String(state.samples.dropped) +
+    "\nsucceeded " + String(activeUploader->uploadsSucceeded) +
+    "\nfailed " + String(activeUploader->uploadsFailed) +
+    "\nrejected " + String(activeUploader->samplesRejected) +
+    "\nbackoff " + String(activeUploader->backoff()) +
+    "\nspooled " + String(influxSpool.recordsSpooled) +
+    "\nreplayed " + String(influxSpool.recordsReplayed) +
+    "\nspool pending " + String(influxSpool.pendingBytes() / SPOOL_RECORD_SIZE) +
+    "\nspool corrupt " + String(influxSpool.recordsCorrupt) +
+    "\nspool lost " + String(influxSpool.recordsLost));
+}
+
+// what the gateway took in and forwarded, and from which nodes
+void http_gateway() {
+  String response =
+    "queued " + String(gateway.queue.size()) +
+    "\nframes " + String(gateway.framesReceived) +
+    "\ninvalid " + String(gateway.framesInvalid) +
+    "\nrefused " + String(gateway.framesRefused) +
+    "\nforwarded " + String(gatewayForwarder.uploadsSucceeded) +
+    "\nfailed " + String(gatewayForwarder.uploadsFailed) +
+    "\nlastResponse " + String(gatewayForwarder.lastResult) + "\n";
+  char id[12];
+  for(uint8_t i = 0; i < GATEWAY_NODES; i++) {
+    const GatewayNode &node = gateway.node(i);
+    if(!node.known) {
+      continue;
+    }
+    snprintf(id, sizeof id, "%06lx", (unsigned long) node.id);
+    response += "node " + String(id) + " seen " + String(stationClock() - node.lastSeen_s) + " s ago, " +
+      String(node.frames) + " frames, " + String(node.samples) + " samples, " + String(node.duplicates) + " duplicates\n";
   }
-  Serial.println("read " + String(data.t) + " and " + String(data.rh) + ". Previous readings were " + String(state.humidity_pct) + " and " + String(state.temperature_C));
-  if(isnan(state.temperature_C) || isnan(state.humidity_pct) || fabs(data.t - state.temperature_C) > temperature_threshold || fabs(data.rh - state.humidity_pct) > humidity_threshold) {
-    state.temperature_C = data.t;
-    state.humidity_pct = data.rh;
-    return true;
+  httpServer.send(200, "text/plain", response);
+}
+
+// the sensors besides the climate sensor and their last readings, POST scans the bus again
+void http_sensors() {
+  if(httpServer.method() == HTTP_POST) {
+    if(sensorRegistry.scan(halSensorBus(), settings.sensorSlots)) {
+      saveSettings();
+    }
   }
-  return false;
+  measureSensors();
+  String response;
+  char name[16];
+  for(uint8_t i = 0; i < sensorRegistry.size(); i++) {
+    const SensorChannel &channel = sensorRegistry.at(i);
+    SensorRegistry::name(channel, name, sizeof name);
+    response += String(name);
+    if(!channel.valid) {
+      response += " " + String(channel.driver->lastError()) + "\n";
+      continue;
+    }
+    if(!isnan(channel.reading.temperature_C)) {
+      response += " " + String(channel.reading.temperature_C, 2) + " C";
+    }
+    if(!isnan(channel.reading.humidity_pct)) {
+      response += " " + String(channel.reading.humidity_pct, 1) + " %";
+    }
+    if(!isnan(channel.reading.pressure_hPa)) {
+      response += " " + String(channel.reading.pressure_hPa, 2) + " hPa";
+    }
+    response += "\n";
+  }
+  httpServer.send(200, "text/plain", response);
 }
 
-void sendUpdate()
-{
-  syncInflux(state.temperature_C, state.humidity_pct);
+void http_energy() {
+  if(httpServer.method() == HTTP_POST) {
+    const String &body = httpServer.arg("plain");
+    uint32_t current_uA[ENERGY_PHASES];
+    memcpy(current_uA, settings.phaseCurrent_uA, sizeof current_uA);
+    EnergyJsonParser parser(current_uA);
+    JsonReader reader(parser);
+    reader.feed(body.c_str(), body.length());
+    if(!reader.finish()) {
+      httpServer.send(400, "text/plain", parser.error[0] ? parser.error : reader.error);
+      return;
+    }
+    memcpy(settings.phaseCurrent_uA, current_uA, sizeof current_uA);
+    saveSettings();
+    if(parser.reset) {
+      energyMeter.reset(millis());
+    }
+  }
+  // brings the current phase up to date
+  PhaseTimer timer(PHASE_OTHER);
+
+  String response;
+  for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+    response += String(energyPhaseName(phase)) + " " + String((unsigned long) (state.energy.phase_ms[phase] / 1000)) + " s " +
+      String(state.energy.charge_mAh(phase, settings.phaseCurrent_uA), 3) + " mAh at " + String(settings.phaseCurrent_uA[phase]) + " uA\n";
+  }
+  response += "total " + String((unsigned long) (state.energy.total_ms() / 1000)) + " s " + String(state.energy.charge_mAh(settings.phaseCurrent_uA), 3) + " mAh\n";
+  response += "per day " + String(state.energy.mAhPerDay(settings.phaseCurrent_uA), 2) + " mAh";
+  httpServer.send(200, "text/plain", response);
+}
+
+void http_metrics() {
+  // brings the current phase up to date
+  PhaseTimer timer(PHASE_OTHER);
+  HttpSink sink;
+  MetricsWriter metrics(sink);
+  httpServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  httpServer.send(200, METRICS_CONTENT_TYPE, "");
+
+  metrics.gauge("climate_temperature_celsius", "Last reported temperature", state.temperature_C, 2);
+  metrics.gauge("climate_humidity_percent", "Last reported relative humidity", state.humidity_pct, 2);
+  metrics.gauge("climate_reading_age_seconds", "Time since the last successful sensor reading",
+    lastReadingValid ? (float) (stationClock() - lastReading.timestamp_s) : NAN, 0);
+  metrics.counter("climate_influx_uploads_succeeded_total", "Uploads the server accepted", activeUploader->uploadsSucceeded);
+  metrics.counter("climate_influx_uploads_failed_total", "Uploads that failed or were refused", activeUploader->uploadsFailed);
+  metrics.counter("climate_influx_samples_rejected_total", "Samples the server refused for good", activeUploader->samplesRejected);
+  metrics.counter("climate_influx_samples_dropped_total", "Samples dropped from the full queue", state.samples.dropped);
+  metrics.gauge("climate_influx_queue_samples", "Samples waiting for upload in RTC memory", (long) state.samples.size());
+  metrics.gauge("climate_spool_samples", "Samples waiting for upload on flash", (long) (influxSpool.pendingBytes() / SPOOL_RECORD_SIZE));
+  metrics.gauge("climate_wifi_rssi_dbm", "Signal strength of the access point", WiFi.isConnected() ? (float) WiFi.RSSI() : NAN, 0);
+  metrics.gauge("climate_heap_free_bytes", "Free heap", (long) ESP.getFreeHeap());
+  metrics.gauge("climate_heap_max_block_bytes", "Largest block the heap can allocate", (long) ESP.getMaxFreeBlockSize());
+  metrics.gauge("climate_heap_fragmentation_percent", "Heap fragmentation", (long) ESP.getHeapFragmentation());
+  metrics.begin("climate_task_runs_total", "counter", "Runs of each scheduled task");
+  for(uint8_t i = 0; i < scheduler.size(); i++) {
+    metrics.integer((long) scheduler.task(i).stats.runs, "task", scheduler.task(i).name);
+  }
+  metrics.begin("climate_task_seconds_total", "counter", "Time spent running each task");
+  for(uint8_t i = 0; i < scheduler.size(); i++) {
+    metrics.milliseconds(scheduler.task(i).stats.busy_us / 1000, "task", scheduler.task(i).name);
+  }
+  metrics.begin("climate_task_max_seconds", "gauge", "Longest run of each task since the previous scrape");
+  for(uint8_t i = 0; i < scheduler.size(); i++) {
+    metrics.real(scheduler.task(i).stats.max_us / 1e6f, 6, "task", scheduler.task(i).name);
+  }
+  metrics.begin("climate_task_late_max_seconds", "gauge", "Latest start of each task after it was due since the previous scrape");
+  for(uint8_t i = 0; i < scheduler.size(); i++) {
+    metrics.real(scheduler.task(i).stats.maxLate_us / 1e6f, 6, "task", scheduler.task(i).name);
+  }
+  metrics.begin("climate_task_deadline_missed_total", "counter", "Runs that started later than the task's deadline");
+  for(uint8_t i = 0; i < scheduler.size(); i++) {
+    metrics.integer((long) scheduler.task(i).stats.missed, "task", scheduler.task(i).name);
+  }
+  metrics.begin("climate_idle_seconds_total", "counter", "Time no task was due");
+  metrics.milliseconds(scheduler.idle_us / 1000);
+  metrics.begin("climate_uptime_seconds", "gauge", "Time since boot");
+  metrics.milliseconds(uptime_ms);
+  metrics.begin("climate_phase_seconds_total", "counter", "Time spent in each energy phase since the estimate was reset");
+  for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+    metrics.milliseconds(state.energy.phase_ms[phase], "phase", energyPhaseName(phase));
+  }
+  metrics.flush();
+  httpServer.sendContent("");
+  scheduler.resetMax();
 }
 
-void updateClimate() {
-  if(readClimate()) {
-    syncNeeded = true;
+void task_sensor() {
+  if(readClimate(1)) {
+    scheduler.wake(displayTask);
+    scheduler.wake(sampleTask);
   }
 }
 
+void task_display() {
+  updateDisplay();
+}
+
+// uploaded right away while powered, the other sensors go with it
+void task_sample() {
+  measureSensors();
+  queueSample();
+  scheduler.wake(uploadTask);
+}
+
+// in small steps so a slow influx server doesn't stall the web server and display, taking the
+// next one right away while a request is under way
+void task_upload() {
+  PhaseTimer timer(PHASE_UPLOAD);
+  syncClock(false);
+  serviceInflux(state.clock);
+  if(activeUploader->state() != Uploader::BACKOFF && (!activeUploader->idle() || influxReplaying)) {
+    scheduler.wake(uploadTask);
+  }
+}
+
+void task_gateway() {
+  PhaseTimer timer(PHASE_UPLOAD);
+  serviceGateway(state.clock, stationClock());
+  // connecting and sending go on right away, the response is polled for every GATEWAY_POLL_MS
+  // like the frames, which leaves the time in between to the tasks below
+  Uploader::State forwarding = gatewayForwarder.state();
+  if(forwarding == Uploader::CONNECT || forwarding == Uploader::SEND) {
+    scheduler.wake(gatewayTask);
+  }
+}
+
+void task_http() {
+  httpServer.handleClient();
+}
+
 void setup()
 {
   Wire.begin();
   Serial.begin(115200);
   loadSettings();
+  setInfluxQueue(state.samples, state.spool, stationClock);
+  setInfluxStatistics(state.aggregate, state.energy, settings.phaseCurrent_uA, sensorRegistry);
+  updateUploadTarget();
+  configTime(0, 0, "pool.ntp.org");
   pinMode(WAKE_UP_PIN, INPUT);
   
   rst_info* resetInfo = ESP.getResetInfoPtr();
   Serial.println("Reset reason " + String(resetInfo->reason, 16));
 
-  if(sht3xd.begin(0x44)) {
+  if(!sensor.begin()) {
     Serial.println("SHT31 failed to initialize");
   }
 
-  if (sht3xd.periodicStart(SHT3XD_REPEATABILITY_HIGH, SHT3XD_FREQUENCY_10HZ) != SHT3XD_NO_ERROR) {
-		Serial.println("[ERROR] Cannot start periodic mode");
+  // a single reading per wake, no point in having the sensor measure continuously
+  if (!sensor.configure(SENSOR_CLOCK_STRETCH, (SensorRepeatability) settings.sensorRepeatability)) {
+    Serial.println("[ERROR] Cannot configure sensor: " + String(sensor.lastError()));
   }
+  sensor.setHeater(settings.sensorHeater);
 
   int wakeUp = digitalRead(WAKE_UP_PIN);
 
   if((resetInfo->reason == REASON_DEEP_SLEEP_AWAKE)) {
-    ESP.rtcUserMemoryRead(0, (uint32_t*) &state, sizeof(state));
+    resumeFromDeepSleep();
+    screen.restore(state.displayHash);
+  } else if(coldBoot()) {
+    saveSettings();
   }
 
   if ((resetInfo->reason == REASON_DEEP_SLEEP_AWAKE) && !wakeUp)
   {
-    Serial.println("Waking up from deep sleep!");
-    // since we have no readings we're assuming they're always the same anyway
-    bool changed = readClimate();
-    if (changed)
-    {
-      inLowPowerMode = false;
-      display.resume();
-      updateDisplay();
-      wifiManager.autoConnect();
-      updateDisplay();
-
-      sendUpdate();
-
-      inLowPowerMode = true;
-      updateDisplay();
-    }
-    enterDeepSleep();
+    deepSleepWake();
   }
   else
   {
@@ -344,9 +597,12 @@ void setup()
       display.init();
       display.flipScreenVertically();
       display.setContrast(settings.displayContrast);
+      screen.invalidate();
     }
 
-    readClimate();
+    if(readClimate(settings.filterOversample)) {
+      queueSample();
+    }
 
     // setup callback for displaying setup instructions
     wifiManager.setAPCallback(displaySetUpWifi);
@@ -354,7 +610,13 @@ void setup()
     // update display to reflect current connection state
     updateDisplay();
 
-    wifiManager.autoConnect();
+    // stays connected for long, so go through DHCP to get a lease of its own
+    {
+      PhaseTimer timer(PHASE_WIFI);
+      wifiManager.autoConnect();
+      cacheWifi(state.wifi, stationClock());
+    }
+    updateLink();
 
     updateDisplay();
 
@@ -364,18 +626,32 @@ void setup()
     httpServer.on("/lowPower", http_lowPower);
     httpServer.on("/settings", http_handleSettings);
     httpServer.on("/influx/lastResponse", http_influxLastResponse);
+    httpServer.on("/influx/connections", http_influxConnections);
+    httpServer.on("/influx/queue", http_influxQueue);
+    httpServer.on("/energy", http_energy);
+    httpServer.on("/metrics", http_metrics);
+    httpServer.on("/sensors", http_sensors);
+    httpServer.on("/gateway", http_gateway);
     httpServer.begin();
 
-    ticker.attach(1, updateClimate);
+    // read every second from now on, so let the sensor measure on its own instead of waiting for each measurement
+    if (!sensor.configure(SENSOR_PERIODIC, (SensorRepeatability) settings.sensorRepeatability)) {
+      Serial.println("[ERROR] Cannot start periodic mode: " + String(sensor.lastError()));
+    }
+    // higher priorities go first, deadlines are how late a task may start before it counts as missed
+    scheduler.add("sensor", task_sensor, 1000, 5, 100);
+    gatewayTask = scheduler.add("gateway", task_gateway, settings.gatewayEnabled ? GATEWAY_POLL_MS : 0, 4, GATEWAY_ACK_TIMEOUT_MS / 2);
+    scheduler.add("http", task_http, 10, 3, 100);
+    displayTask = scheduler.add("display", task_display, 0, 2, 500);
+    sampleTask = scheduler.add("sample", task_sample, 0, 1, 1000);
+    uploadTask = scheduler.add("upload", task_upload, 100, 0, 1000);
   }
 }
 
 void loop()
 {
-  httpServer.handleClient();
-  if(syncNeeded) {
-    syncNeeded = false;
-    updateDisplay();
-    sendUpdate();
-  }
-}
\ No newline at end of file
+  uint32_t now = millis();
+  uptime_ms += now - uptimeMillis;
+  uptimeMillis = now;
+  scheduler.runOnce();
+}
@@ -0,0 +1,151 @@
+#ifndef __METRICS__
+#define __METRICS__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "sink.h"
+#include "numberformat.h"
+
+// Writes the Prometheus text exposition format through a fixed buffer, so a scrape never
+// allocates no matter how many metrics there are.
+
+#define METRICS_BUFFER 256
+#define METRICS_CONTENT_TYPE "text/plain; version=0.0.4"
+
+class MetricsWriter {
+public:
+    MetricsWriter(OutputSink &sink) : sink(sink) {
+    }
+
+    // Starts a metric with the HELP and TYPE lines, followed by its samples
+    void begin(const char *name, const char *type, const char *help) {
+        this->name = name;
+        text("# HELP ");
+        text(name);
+        put(' ');
+        text(help);
+        text("\n# TYPE ");
+        text(name);
+        put(' ');
+        text(type);
+        put('\n');
+    }
+
+    // A sample of the current metric, with an optional label. NaN stands for unknown.
+    void real(float value, uint8_t decimals, const char *label = NULL, const char *labelValue = NULL) {
+        labels(label, labelValue);
+        if(isnan(value)) {
+            text("NaN");
+        } else {
+            fixed(value, decimals);
+        }
+        put('\n');
+    }
+
+    void integer(long value, const char *label = NULL, const char *labelValue = NULL) {
+        labels(label, labelValue);
+        if(value < 0) {
+            put('-');
+            value = -value;
+        }
+        unsignedInteger(value);
+        put('\n');
+    }
+
+    // exact for any duration, where a float loses the milliseconds after a few hours
+    void milliseconds(uint64_t value_ms, const char *label = NULL, const char *labelValue = NULL) {
+        labels(label, labelValue);
+        unsignedInteger((unsigned long) (value_ms / 1000));
+        put('.');
+        unsigned long fraction = value_ms % 1000;
+        put('0' + fraction / 100);
+        put('0' + fraction / 10 % 10);
+        put('0' + fraction % 10);
+        put('\n');
+    }
+
+    void gauge(const char *name, const char *help, float value, uint8_t decimals) {
+        begin(name, "gauge", help);
+        real(value, decimals);
+    }
+
+    void gauge(const char *name, const char *help, long value) {
+        begin(name, "gauge", help);
+        integer(value);
+    }
+
+    // name should end in _total
+    void counter(const char *name, const char *help, unsigned long value) {
+        begin(name, "counter", help);
+        labels(NULL, NULL);
+        unsignedInteger(value);
+        put('\n');
+    }
+
+    // hands what's buffered to the sink, must be called at the end
+    void flush() {
+        if(length > 0) {
+            sink.write(buffer, length);
+            written += length;
+            length = 0;
+        }
+    }
+
+    size_t written = 0;
+
+private:
+    void labels(const char *label, const char *labelValue) {
+        text(name);
+        if(label != NULL) {
+            put('{');
+            text(label);
+            text("=\"");
+            for(const char *c = labelValue; *c; c++) {
+                if(*c == '"' || *c == '\\') {
+                    put('\\');
+                }
+                put(*c);
+            }
+            text("\"}");
+        }
+        put(' ');
+    }
+
+    void fixed(float value, uint8_t decimals) {
+        char digits[NUMBER_FORMAT_SIZE];
+        text(digits, formatFixed(digits, value, decimals));
+    }
+
+    void unsignedInteger(unsigned long value) {
+        char digits[NUMBER_FORMAT_SIZE];
+        text(digits, formatUnsigned(digits, value));
+    }
+
+    void text(const char *s, size_t n) {
+        for(size_t i = 0; i < n; i++) {
+            put(s[i]);
+        }
+    }
+
+    void text(const char *s) {
+        for(; *s; s++) {
+            put(*s);
+        }
+    }
+
+    void put(char c) {
+        if(length == sizeof buffer) {
+            flush();
+        }
+        buffer[length++] = c;
+    }
+
+    OutputSink &sink;
+    char buffer[METRICS_BUFFER];
+    size_t length = 0;
+    const char *name = "";
+};
+
+#endif
@@ -0,0 +1,420 @@
+#ifndef __MQTT__
+#define __MQTT__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "uploader.h"
+
+// Publishes the samples to an MQTT 3.1.1 broker, a line protocol message per sample, e.g. for
+// Telegraf's mqtt_consumer. A publish costs a few bytes of framing where an HTTP write costs a
+// few hundred of headers, and the connection stays open between uploads while powered. The
+// session is persistent (clean session off) under a fixed client id. With QoS 1 the samples are
+// only removed from the queue once the broker acknowledged all of them. The publishes it didn't
+// acknowledge before the connection was lost are sent again, with their packet ids and the DUP
+// flag, once it's back. A wake that ends first leaves the samples to be published anew.
+
+#define MQTT_KEEPALIVE_S 60
+#define MQTT_PROTOCOL_LEVEL 4  // 3.1.1
+
+#define MQTT_CONNECT 0x10
+#define MQTT_CONNACK 0x20
+#define MQTT_PUBLISH 0x30
+#define MQTT_PUBACK 0x40
+#define MQTT_PINGREQ 0xC0
+#define MQTT_PINGRESP 0xD0
+
+#define MQTT_RETAIN 0x01
+#define MQTT_DUP 0x08
+
+static_assert(SAMPLE_BUFFER_SIZE <= 32, "the uploader keeps a bit per publish in flight");
+
+// Replaces {id} and {series} in template. Returns false if dst is too small.
+inline bool expandMqttTopic(char *dst, size_t capacity, const char *topicTemplate, const char *id, const char *series) {
+    size_t length = 0;
+    while(*topicTemplate) {
+        const char *value = NULL;
+        if(strncmp(topicTemplate, "{id}", 4) == 0) {
+            value = id;
+            topicTemplate += 4;
+        } else if(strncmp(topicTemplate, "{series}", 8) == 0) {
+            value = series;
+            topicTemplate += 8;
+        }
+        size_t n = value != NULL ? strlen(value) : 1;
+        if(length + n >= capacity) {
+            return false;
+        }
+        memcpy(dst + length, value != NULL ? value : topicTemplate++, n);
+        length += n;
+    }
+    dst[length] = 0;
+    return true;
+}
+
+class MqttUploader : public Uploader {
+public:
+    MqttUploader(UploadTransport &transport, char *buffer, size_t capacity)
+        : transport(transport), buffer((uint8_t *) buffer), capacity(capacity) {
+    }
+
+    // host, clientId, topic and prefix must stay valid while the uploader is used. The newest
+    // live sample is published retained when retain is set, so subscribers get the current
+    // reading right away.
+    void setTarget(const char *host, uint16_t port, const char *clientId, const char *topic, const char *prefix, uint8_t qos, bool retain) {
+        this->host = host;
+        this->port = port;
+        this->clientId = clientId;
+        this->topic = topic;
+        this->prefix = prefix;
+        this->qos = qos > 0 ? 1 : 0;
+        this->retain = retain;
+        transport.stop();
+        sessionOpen = false;
+        redeliver = false;
+        reset();
+    }
+
+    void step(uint32_t now_ms, const ClockSync &clock) override {
+        switch(current) {
+        case IDLE:
+            keepAlive(now_ms);
+            if(ready(clock) && encode(clock)) {
+                current = CONNECT;
+            }
+            break;
+        case CONNECT:
+            reusedConnection = sessionOpen && transport.connected();
+            sent = 0;
+            if(reusedConnection) {
+                connectionsReused++;
+                current = SEND;
+                break;
+            }
+            connectionsOpened++;
+            sessionOpen = false;
+            if(!transport.connect(host, port)) {
+                fail(UPLOAD_ERROR_CONNECTION_FAILED, now_ms);
+                break;
+            }
+            if(!sendConnect()) {
+                fail(UPLOAD_ERROR_SEND_FAILED, now_ms);
+                break;
+            }
+            await(MQTT_CONNACK, now_ms);
+            break;
+        case SEND:
+            sendChunk(now_ms);
+            break;
+        case AWAIT_RESPONSE:
+            receive(now_ms);
+            break;
+        case BACKOFF:
+            if(now_ms - failedAt_ms >= backoff_ms) {
+                current = redeliver ? CONNECT : IDLE;
+            }
+            break;
+        }
+    }
+
+    unsigned long messagesPublished = 0;  // not counting redeliveries
+
+private:
+    // Encodes a PUBLISH for each of the oldest samples that fit, returns false if there was
+    // nothing to send
+    bool encode(const ClockSync &clock) {
+        bool timed = !live || clock.valid;
+        uint8_t count = 0;
+        size_t topicLength = strlen(topic);
+        // fixed header with up to 2 bytes of remaining length, topic and packet id
+        size_t header = 3 + 2 + topicLength + (qos > 0 ? 2 : 0);
+        length = 0;
+        for(uint8_t i = 0; i < queue->size(); i++) {
+            if(length + header >= capacity) {
+                break;
+            }
+            LineProtocolWriter line((char *) buffer + length + header, capacity - length - header);
+            if(!encodeLine(line, prefix, i, clock, timed)) {
+                break;
+            }
+            // without the newline
+            size_t payload = line.length() - 1;
+            size_t remaining = header - 3 + payload;
+            uint8_t *packet = buffer + length;
+            bool newest = i == queue->size() - 1;
+            packet[0] = MQTT_PUBLISH | qos << 1 | (retain && live && newest ? MQTT_RETAIN : 0);
+            size_t at = 1;
+            if(remaining < 128) {
+                // the remaining length takes one byte less, close the gap
+                memmove(packet + header - 1, packet + header, payload);
+                packet[at++] = remaining;
+            } else {
+                packet[at++] = 0x80 | (remaining & 0x7F);
+                packet[at++] = remaining >> 7;
+            }
+            at = putString(packet, at, topic, topicLength);
+            if(qos > 0) {
+                nextPacketId = nextPacketId == 0xFFFF ? 1 : nextPacketId + 1;
+                packetIds[count] = nextPacketId;
+                packet[at++] = nextPacketId >> 8;
+                packet[at++] = nextPacketId & 0xFF;
+            }
+            length += at + payload;
+            count++;
+        }
+        if(count == 0) {
+            // a single sample that doesn't fit never will, don't let it block the queue
+            queue->drop(1);
+            samplesRejected++;
+            return false;
+        }
+        inFlight = count;
+        published = count;
+        unacked = (uint32_t) ((1ull << count) - 1);
+        redeliver = false;
+        droppedAtEncode = queue->dropped;
+        retried = false;
+        return true;
+    }
+
+    bool sendConnect() {
+        uint8_t packet[64];
+        size_t idLength = strlen(clientId);
+        if(idLength > sizeof packet - 14) {
+            idLength = sizeof packet - 14;
+        }
+        size_t at = 0;
+        packet[at++] = MQTT_CONNECT;
+        packet[at++] = 10 + 2 + idLength;
+        at = putString(packet, at, "MQTT", 4);
+        packet[at++] = MQTT_PROTOCOL_LEVEL;
+        // a persistent session, so the broker keeps its state across deep sleep
+        packet[at++] = 0;
+        packet[at++] = MQTT_KEEPALIVE_S >> 8;
+        packet[at++] = MQTT_KEEPALIVE_S & 0xFF;
+        at = putString(packet, at, clientId, idLength);
+        return transport.write(packet, at) == at;
+    }
+
+    void sendChunk(uint32_t now_ms) {
+        size_t remaining = length - sent;
+        size_t n = transport.write(buffer + sent, remaining < UPLOAD_SEND_CHUNK ? remaining : UPLOAD_SEND_CHUNK);
+        if(n == 0) {
+            fail(UPLOAD_ERROR_SEND_FAILED, now_ms);
+            return;
+        }
+        sent += n;
+        lastActivity_ms = now_ms;
+        if(sent < length) {
+            return;
+        }
+        if(!redeliver) {
+            messagesPublished += published;
+        }
+        if(qos == 0) {
+            // nothing comes back, what went out is as good as delivered
+            lastResult = 0;
+            accepted();
+            return;
+        }
+        await(MQTT_PUBACK, now_ms);
+    }
+
+    void await(uint8_t type, uint32_t now_ms) {
+        awaiting = type;
+        requestSent_ms = now_ms;
+        packetLength = 0;
+        packetRead = 0;
+        lengthShift = 0;
+        parser = PACKET_TYPE;
+        current = AWAIT_RESPONSE;
+    }
+
+    void receive(uint32_t now_ms) {
+        while(current == AWAIT_RESPONSE && transport.available() > 0) {
+            int c = transport.read();
+            if(c < 0) {
+                break;
+            }
+            if(parse(c)) {
+                handlePacket(now_ms);
+            }
+        }
+        if(current != AWAIT_RESPONSE) {
+            return;
+        }
+        if(!transport.connected()) {
+            fail(UPLOAD_ERROR_CONNECTION_LOST, now_ms);
+        } else if(now_ms - requestSent_ms >= UPLOAD_RESPONSE_TIMEOUT_MS) {
+            fail(UPLOAD_ERROR_READ_TIMEOUT, now_ms);
+        }
+    }
+
+    // Returns true once a whole packet was read, only the start of its body is kept
+    bool parse(uint8_t c) {
+        switch(parser) {
+        case PACKET_TYPE:
+            packetType = c & 0xF0;
+            packetLength = 0;
+            packetRead = 0;
+            lengthShift = 0;
+            parser = PACKET_LENGTH;
+            return false;
+        case PACKET_LENGTH:
+            packetLength |= (uint32_t) (c & 0x7F) << lengthShift;
+            lengthShift += 7;
+            if(c & 0x80) {
+                return false;
+            }
+            parser = packetLength > 0 ? PACKET_BODY : PACKET_TYPE;
+            return packetLength == 0;
+        case PACKET_BODY:
+            if(packetRead < sizeof packet) {
+                packet[packetRead] = c;
+            }
+            if(++packetRead < packetLength) {
+                return false;
+            }
+            parser = PACKET_TYPE;
+            return true;
+        }
+        return false;
+    }
+
+    void handlePacket(uint32_t now_ms) {
+        if(packetType == MQTT_CONNACK && awaiting == MQTT_CONNACK) {
+            // the return code, 0 is accepted
+            lastResult = packetRead >= 2 ? packet[1] : UPLOAD_ERROR_BAD_RESPONSE;
+            if(lastResult != 0) {
+                // refused, e.g. for the client id, retrying soon won't change that
+                fail(lastResult, now_ms);
+                return;
+            }
+            sessionOpen = true;
+            current = SEND;
+        } else if(packetType == MQTT_PUBACK && awaiting == MQTT_PUBACK && packetRead >= 2) {
+            // by packet id, so a stray or repeated PUBACK doesn't release samples the broker
+            // hasn't got
+            uint16_t id = packet[0] << 8 | packet[1];
+            for(uint8_t i = 0; i < published; i++) {
+                if(packetIds[i] == id) {
+                    unacked &= ~((uint32_t) 1 << i);
+                    break;
+                }
+            }
+            if(unacked == 0) {
+                lastResult = 0;
+                accepted();
+            }
+        }
+    }
+
+    // Keeps an open session alive while there's nothing to send, and notices when it closed
+    void keepAlive(uint32_t now_ms) {
+        if(!sessionOpen) {
+            return;
+        }
+        while(transport.available() > 0 && transport.read() >= 0) {
+            // only PINGRESP arrives while idle
+        }
+        if(!transport.connected()) {
+            sessionOpen = false;
+        } else if(now_ms - lastActivity_ms >= MQTT_KEEPALIVE_S * 1000 / 2) {
+            const uint8_t ping[] = { MQTT_PINGREQ, 0 };
+            transport.write(ping, sizeof ping);
+            lastActivity_ms = now_ms;
+        }
+    }
+
+    void fail(int result, uint32_t now_ms) {
+        lastResult = result;
+        transport.stop();
+        sessionOpen = false;
+        if(qos > 0 && sent > 0) {
+            prepareRedelivery();
+        }
+        if(result < 0 && reusedConnection && !retried) {
+            // the broker may have dropped the idle connection, retry once on a new one
+            retried = true;
+            current = CONNECT;
+            return;
+        }
+        // the statistics go out again with the publishes, they're only put back if those are
+        // given up
+        backOff(now_ms, redeliver);
+    }
+
+    // Keeps only the publishes the broker didn't acknowledge, flagged DUP, for after the next
+    // CONNECT
+    void prepareRedelivery() {
+        size_t from = 0;
+        size_t to = 0;
+        uint8_t kept = 0;
+        uint32_t keptUnacked = 0;
+        for(uint8_t i = 0; i < published; i++) {
+            size_t size = packetSize(buffer + from);
+            if(unacked & (uint32_t) 1 << i) {
+                memmove(buffer + to, buffer + from, size);
+                buffer[to] |= MQTT_DUP;
+                packetIds[kept] = packetIds[i];
+                keptUnacked |= (uint32_t) 1 << kept;
+                kept++;
+                to += size;
+            }
+            from += size;
+        }
+        length = to;
+        published = kept;
+        unacked = keptUnacked;
+        redeliver = true;
+    }
+
+    // of a PUBLISH as encode() writes it, with up to 2 bytes of remaining length
+    static size_t packetSize(const uint8_t *packet) {
+        return packet[1] & 0x80 ? 3 + ((packet[1] & 0x7F) | packet[2] << 7) : 2 + packet[1];
+    }
+
+    static size_t putString(uint8_t *packet, size_t at, const char *text, size_t length) {
+        packet[at++] = length >> 8;
+        packet[at++] = length & 0xFF;
+        memcpy(packet + at, text, length);
+        return at + length;
+    }
+
+    enum Parser { PACKET_TYPE, PACKET_LENGTH, PACKET_BODY };
+
+    UploadTransport &transport;
+    uint8_t *buffer;
+    size_t capacity;
+    const char *host = "";
+    uint16_t port = 0;
+    const char *clientId = "";
+    const char *topic = "";
+    const char *prefix = "";
+    uint8_t qos = 0;
+    bool retain = false;
+
+    size_t length = 0;
+    size_t sent = 0;
+    uint8_t published = 0;
+    uint16_t packetIds[SAMPLE_BUFFER_SIZE];
+    uint32_t unacked = 0;  // a bit per publish in the buffer
+    uint16_t nextPacketId = 0;
+    bool redeliver = false;
+    bool sessionOpen = false;
+    bool reusedConnection = false;
+    bool retried = false;
+
+    Parser parser = PACKET_TYPE;
+    uint8_t awaiting = 0;
+    uint8_t packetType = 0;
+    uint32_t packetLength = 0;
+    uint32_t packetRead = 0;
+    uint8_t lengthShift = 0;
+    uint8_t packet[4];
+
+    uint32_t requestSent_ms = 0;
+    uint32_t lastActivity_ms = 0;
+};
+
+#endif
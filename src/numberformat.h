@@ -0,0 +1,51 @@
+#ifndef __NUMBER_FORMAT__
+#define __NUMBER_FORMAT__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+// Decimal numbers for the fixed buffer writers (lineprotocol.h, metrics.h), without printf's
+// float support and its stack. Both write to dst, which must hold NUMBER_FORMAT_SIZE characters,
+// and return how many they wrote, without a terminator.
+
+#define NUMBER_FORMAT_SIZE 32
+
+inline size_t formatUnsigned(char *dst, unsigned long value) {
+    char digits[NUMBER_FORMAT_SIZE];
+    size_t n = 0;
+    do {
+        digits[sizeof digits - 1 - n++] = '0' + value % 10;
+        value /= 10;
+    } while(value > 0);
+    for(size_t i = 0; i < n; i++) {
+        dst[i] = digits[sizeof digits - n + i];
+    }
+    return n;
+}
+
+// value rounded to decimals, which must leave 10^decimals in an unsigned long
+inline size_t formatFixed(char *dst, float value, uint8_t decimals) {
+    unsigned long scale = 1;
+    for(uint8_t i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+    long scaled = lroundf(value * scale);
+    size_t n = 0;
+    if(scaled < 0) {
+        dst[n++] = '-';
+        scaled = -scaled;
+    }
+    n += formatUnsigned(dst + n, scaled / scale);
+    if(decimals > 0) {
+        dst[n++] = '.';
+        unsigned long fraction = scaled % scale;
+        for(unsigned long digit = scale / 10; digit > 1 && fraction < digit; digit /= 10) {
+            dst[n++] = '0';
+        }
+        n += formatUnsigned(dst + n, fraction);
+    }
+    return n;
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef __SAMPLES__
+#define __SAMPLES__
+
+#include <stdint.h>
+#include <math.h>
+
+// Samples are kept in RTC user memory between deep sleep cycles, so this file must stay
+// free of Arduino dependencies and the structs must remain plain data.
+
+#define SAMPLE_BUFFER_SIZE 24
+
+struct Sample {
+    uint32_t timestamp_s;    // station clock, see stationClock() in station.h
+    int16_t temperature_cC;  // hundredths of a degree celsius
+    uint16_t humidity_cpct;  // hundredths of a percent
+};
+
+inline Sample makeSample(uint32_t timestamp_s, float temperature_C, float humidity_pct) {
+    Sample sample;
+    sample.timestamp_s = timestamp_s;
+    sample.temperature_cC = (int16_t) lroundf(temperature_C * 100);
+    sample.humidity_cpct = (uint16_t) lroundf(humidity_pct * 100);
+    return sample;
+}
+
+inline float sampleTemperature(const Sample &sample) {
+    return sample.temperature_cC / 100.0f;
+}
+
+inline float sampleHumidity(const Sample &sample) {
+    return sample.humidity_cpct / 100.0f;
+}
+
+// Fixed size ring buffer, drops the oldest sample when full
+struct SampleBuffer {
+    uint8_t head;      // index of the oldest sample
+    uint8_t count;
+    uint16_t dropped;  // samples lost to overflow since the last cold boot
+    Sample items[SAMPLE_BUFFER_SIZE];
+
+    void clear() {
+        head = 0;
+        count = 0;
+        dropped = 0;
+    }
+
+    uint8_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    bool full() const {
+        return count == SAMPLE_BUFFER_SIZE;
+    }
+
+    // i = 0 is the oldest sample
+    const Sample &at(uint8_t i) const {
+        return items[(head + i) % SAMPLE_BUFFER_SIZE];
+    }
+
+    const Sample &oldest() const {
+        return at(0);
+    }
+
+    const Sample &newest() const {
+        return at(count - 1);
+    }
+
+    void push(const Sample &sample) {
+        if(full()) {
+            head = (head + 1) % SAMPLE_BUFFER_SIZE;
+            count--;
+            dropped++;
+        }
+        items[(head + count) % SAMPLE_BUFFER_SIZE] = sample;
+        count++;
+    }
+
+    // removes the n oldest samples, typically after they were uploaded
+    void drop(uint8_t n) {
+        if(n >= count) {
+            head = 0;
+            count = 0;
+        } else {
+            head = (head + n) % SAMPLE_BUFFER_SIZE;
+            count -= n;
+        }
+    }
+};
+
+// Whether the buffer should be uploaded now: either it reached the configured fill level or
+// the oldest sample has been waiting for longer than maxAge_s.
+inline bool uploadDue(const SampleBuffer &buffer, uint32_t now_s, uint8_t fillLevel, uint32_t maxAge_s) {
+    if(buffer.empty()) {
+        return false;
+    }
+    if(buffer.size() >= fillLevel || buffer.full()) {
+        return true;
+    }
+    return now_s - buffer.oldest().timestamp_s >= maxAge_s;
+}
+
+#endif
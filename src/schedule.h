@@ -0,0 +1,92 @@
+#ifndef __SCHEDULE__
+#define __SCHEDULE__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "samples.h"
+
+#define TREND_HISTORY_SIZE 4
+
+// The readings of the last few deep sleep wakes, kept in RTC memory
+struct TrendHistory {
+    uint8_t head;
+    uint8_t count;
+    uint16_t interval_s;  // the interval the station is sleeping for now
+    Sample readings[TREND_HISTORY_SIZE];
+
+    void clear() {
+        head = 0;
+        count = 0;
+        interval_s = 0;
+    }
+
+    // i = 0 is the oldest reading
+    const Sample &at(uint8_t i) const {
+        return readings[(head + i) % TREND_HISTORY_SIZE];
+    }
+
+    void record(const Sample &reading) {
+        if(count == TREND_HISTORY_SIZE) {
+            head = (head + 1) % TREND_HISTORY_SIZE;
+            count--;
+        }
+        readings[(head + count) % TREND_HISTORY_SIZE] = reading;
+        count++;
+    }
+};
+
+struct ScheduleParams {
+    uint16_t min_s;
+    uint16_t max_s;
+    uint16_t temperatureThreshold_cC;
+    uint16_t humidityThreshold_cpct;
+};
+
+// Picks the next deep sleep interval so the station wakes about when the readings moved by one
+// threshold at their recent rate of change. Stable readings stretch the interval by at most
+// doubling it per wake, fast changes shorten it right away. With max_s <= min_s the interval
+// is fixed at min_s.
+inline uint16_t nextSleepInterval(const TrendHistory &trend, uint16_t current_s, const ScheduleParams &params) {
+    if(params.max_s <= params.min_s || trend.count < 2) {
+        return params.min_s;
+    }
+    if(current_s < params.min_s) {
+        current_s = params.min_s;
+    }
+
+    // total variation rather than net change, so oscillating readings count as unstable
+    uint32_t temperatureChange = 0;
+    uint32_t humidityChange = 0;
+    for(uint8_t i = 1; i < trend.count; i++) {
+        temperatureChange += abs(trend.at(i).temperature_cC - trend.at(i - 1).temperature_cC);
+        humidityChange += abs((int32_t) trend.at(i).humidity_cpct - (int32_t) trend.at(i - 1).humidity_cpct);
+    }
+    uint32_t elapsed_s = trend.at(trend.count - 1).timestamp_s - trend.at(0).timestamp_s;
+
+    uint32_t next_s = params.max_s;
+    if(temperatureChange > 0) {
+        uint32_t untilThreshold_s = (uint32_t) params.temperatureThreshold_cC * elapsed_s / temperatureChange;
+        if(untilThreshold_s < next_s) {
+            next_s = untilThreshold_s;
+        }
+    }
+    if(humidityChange > 0) {
+        uint32_t untilThreshold_s = (uint32_t) params.humidityThreshold_cpct * elapsed_s / humidityChange;
+        if(untilThreshold_s < next_s) {
+            next_s = untilThreshold_s;
+        }
+    }
+
+    if(next_s > 2 * (uint32_t) current_s) {
+        next_s = 2 * (uint32_t) current_s;
+    }
+    if(next_s < params.min_s) {
+        next_s = params.min_s;
+    }
+    if(next_s > params.max_s) {
+        next_s = params.max_s;
+    }
+    return next_s;
+}
+
+#endif
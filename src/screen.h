@@ -0,0 +1,186 @@
+#ifndef __SCREEN__
+#define __SCREEN__
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SSD1306.h>
+#include "fonts_subset.h"
+#include "images.h"
+
+#define SCREEN_WIDTH 128
+#define SCREEN_PAGES 8
+// the panel takes at most 16 data bytes per I2C transmission, see SSD1306Wire
+#define SCREEN_I2C_CHUNK 16
+
+// status line and wifi icon occupy pages 0-1, the readings pages 4-7
+#define SCREEN_STATUS_PAGES 0x03
+#define SCREEN_READINGS_PAGES 0xF0
+
+struct ScreenContent {
+  char temperature[12];
+  char humidity[8];
+  char status[32];
+  const uint8_t *icon;
+};
+
+// Keeps what's on the panel and only redraws and sends the pages whose content changed,
+// instead of clearing and sending the whole 1 KB framebuffer for every update.
+class Screen {
+public:
+  Screen(SSD1306 &display, uint8_t address) : display(display), address(address) {}
+
+  // FNV-1a over the content, identifies what's on the panel across deep sleep
+  static uint32_t hash(const ScreenContent &content) {
+    uint32_t h = 2166136261u;
+    const uint8_t *bytes[] = { (const uint8_t*) content.temperature, (const uint8_t*) content.humidity, (const uint8_t*) content.status };
+    for(uint8_t i = 0; i < 3; i++) {
+      for(const uint8_t *b = bytes[i]; ; b++) {
+        h = (h ^ *b) * 16777619u;
+        if(*b == 0) {
+          break;
+        }
+      }
+    }
+    uintptr_t icon = (uintptr_t) content.icon;
+    for(uint8_t i = 0; i < sizeof icon; i++) {
+      h = (h ^ ((icon >> (8 * i)) & 0xFF)) * 16777619u;
+    }
+    return h;
+  }
+
+  // the panel content is unknown, e.g. after init, so the next show() draws everything
+  void invalidate() {
+    valid = false;
+    restoredHash = 0;
+  }
+
+  // The panel kept showing content with this hash while the framebuffer was lost to deep sleep.
+  // Showing the same content again then doesn't need drawing or sending anything.
+  void restore(uint32_t hash) {
+    valid = false;
+    restoredHash = hash;
+  }
+
+  // hash of what's on the panel, 0 if unknown
+  uint32_t shownHash() const {
+    return valid ? hash(shown) : restoredHash;
+  }
+
+  // Returns whether anything had to be sent
+  bool show(const ScreenContent &content) {
+    uint8_t dirty = 0;
+    if(!valid && restoredHash != 0 && hash(content) == restoredHash) {
+      // only dirty pages are ever sent, so the missing framebuffer of the clean ones doesn't matter
+      shown = content;
+      valid = true;
+      return false;
+    }
+    if(!valid) {
+      display.clear();
+      dirty = 0xFF;
+    } else {
+      if(strcmp(content.status, shown.status) != 0 || content.icon != shown.icon) {
+        dirty |= SCREEN_STATUS_PAGES;
+      }
+      if(strcmp(content.temperature, shown.temperature) != 0 || strcmp(content.humidity, shown.humidity) != 0) {
+        dirty |= SCREEN_READINGS_PAGES;
+      }
+    }
+
+    if(dirty & SCREEN_STATUS_PAGES) {
+      clearPages(SCREEN_STATUS_PAGES);
+      display.setFont(Dialog_plain_10_subset);
+      display.setTextAlignment(TEXT_ALIGN_LEFT);
+      display.drawString(0, 0, content.status);
+      if(content.icon != NULL) {
+        display.drawXbm(120, 4, status_width, status_height, content.icon);
+      }
+    }
+    if(dirty & SCREEN_READINGS_PAGES) {
+      clearPages(SCREEN_READINGS_PAGES);
+      display.setFont(ArialMT_Plain_24_subset);
+      display.setTextAlignment(TEXT_ALIGN_LEFT);
+      display.drawString(0, 32, content.temperature);
+      display.setTextAlignment(TEXT_ALIGN_RIGHT);
+      display.drawString(128, 32, content.humidity);
+    }
+
+    shown = content;
+    valid = true;
+    sendPages(dirty);
+    return dirty != 0;
+  }
+
+  // Sends the whole framebuffer as drawn by the caller, for screens other than the readings
+  void showFrame() {
+    sendPages(0xFF);
+    invalidate();
+  }
+
+  unsigned long transfers = 0;
+  unsigned long pagesSent = 0;
+
+private:
+  void clearPages(uint8_t pages) {
+    for(uint8_t page = 0; page < SCREEN_PAGES; page++) {
+      if(pages & (1 << page)) {
+        memset(display.buffer + page * SCREEN_WIDTH, 0, SCREEN_WIDTH);
+      }
+    }
+  }
+
+  void sendCommand(uint8_t command) {
+    Wire.beginTransmission(address);
+    Wire.write(0x80);
+    Wire.write(command);
+    Wire.endTransmission();
+  }
+
+  // Sends each run of consecutive dirty pages with its own address window
+  void sendPages(uint8_t pages) {
+    if(pages == 0) {
+      return;
+    }
+    transfers++;
+    uint8_t page = 0;
+    while(page < SCREEN_PAGES) {
+      if(!(pages & (1 << page))) {
+        page++;
+        continue;
+      }
+      uint8_t last = page;
+      while(last + 1 < SCREEN_PAGES && (pages & (1 << (last + 1)))) {
+        last++;
+      }
+
+      sendCommand(0x21); // COLUMNADDR
+      sendCommand(0);
+      sendCommand(SCREEN_WIDTH - 1);
+      sendCommand(0x22); // PAGEADDR
+      sendCommand(page);
+      sendCommand(last);
+
+      const uint8_t *data = display.buffer + page * SCREEN_WIDTH;
+      uint16_t length = (last - page + 1) * SCREEN_WIDTH;
+      for(uint16_t i = 0; i < length; i += SCREEN_I2C_CHUNK) {
+        Wire.beginTransmission(address);
+        Wire.write(0x40);
+        for(uint8_t j = 0; j < SCREEN_I2C_CHUNK; j++) {
+          Wire.write(data[i + j]);
+        }
+        Wire.endTransmission();
+      }
+
+      pagesSent += last - page + 1;
+      page = last + 1;
+    }
+  }
+
+  SSD1306 &display;
+  uint8_t address;
+  bool valid = false;
+  uint32_t restoredHash = 0;
+  ScreenContent shown;
+};
+
+#endif
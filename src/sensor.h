@@ -0,0 +1,65 @@
+#ifndef __SENSOR__
+#define __SENSOR__
+
+#include <stdint.h>
+#include <math.h>
+
+enum SensorMode {
+    SENSOR_SINGLE_SHOT,       // measure on every read, the sensor idles in between
+    SENSOR_CLOCK_STRETCH,     // single shot, the sensor holds the bus until the result is ready
+    SENSOR_PERIODIC           // the sensor measures on its own, reads fetch the latest result
+};
+
+enum SensorRepeatability {
+    SENSOR_REPEATABILITY_HIGH,
+    SENSOR_REPEATABILITY_MEDIUM,
+    SENSOR_REPEATABILITY_LOW
+};
+
+// What a sensor measured, NAN for the quantities it doesn't have
+struct SensorReading {
+    float temperature_C;
+    float humidity_pct;
+    float pressure_hPa;
+};
+
+// Any sensor the registry in sensors.h can hold. Kept free of Arduino dependencies so simulated
+// sensors can stand in for the hardware.
+class SensorDriver {
+public:
+    virtual ~SensorDriver() {}
+    virtual bool begin() = 0;
+    // takes a measurement and waits for the result
+    virtual bool measure(SensorReading &reading) = 0;
+    // stops periodic measurements so the sensor draws its idle current while the station sleeps
+    virtual void sleep() = 0;
+    virtual const char *lastError() = 0;
+};
+
+// A temperature and humidity sensor
+class ClimateSensor : public SensorDriver {
+public:
+    // Selects how measurements are taken. Periodic mode only makes sense when reading often,
+    // otherwise single shot leaves the sensor idle between reads.
+    virtual bool configure(SensorMode mode, SensorRepeatability repeatability) = 0;
+    virtual bool read(float &temperature_C, float &humidity_pct) = 0;
+    virtual bool setHeater(bool on) = 0;
+
+    bool measure(SensorReading &reading) override {
+        reading.pressure_hPa = NAN;
+        return read(reading.temperature_C, reading.humidity_pct);
+    }
+};
+
+inline const char *sensorRepeatabilityName(SensorRepeatability repeatability) {
+    switch(repeatability) {
+    case SENSOR_REPEATABILITY_MEDIUM:
+        return "medium";
+    case SENSOR_REPEATABILITY_LOW:
+        return "low";
+    default:
+        return "high";
+    }
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef __SENSORS__
+#define __SENSORS__
+
+#include <stdint.h>
+#include <stdio.h>
+#include "sensor.h"
+
+// The sensors on the I2C bus besides the station's own climate sensor, which stays the one the
+// samples, filter and display are about. The bus is scanned on cold boot only, the slots found
+// are cached in the settings so deep sleep wakes set up the drivers without probing. Only their
+// newest readings go out, a line per sensor in the same write as the newest sample, so all of
+// them are read in one pass right before an upload rather than on every wake.
+
+#define SENSOR_SLOTS 4
+// read through halSensor(), the scan leaves it out
+#define SENSOR_PRIMARY_ADDRESS 0x44
+
+enum SensorKind {
+    SENSOR_KIND_NONE,
+    SENSOR_KIND_SHT31,
+    SENSOR_KIND_BMP280
+};
+
+inline const char *sensorKindName(uint8_t kind) {
+    switch(kind) {
+    case SENSOR_KIND_SHT31:
+        return "sht31";
+    case SENSOR_KIND_BMP280:
+        return "bmp280";
+    default:
+        return "none";
+    }
+}
+
+struct SensorProbe {
+    uint8_t address;
+    uint8_t kind;
+};
+
+// the addresses the supported sensors can have, in the order they're scanned
+const SensorProbe sensorProbes[] = {
+    { 0x44, SENSOR_KIND_SHT31 },
+    { 0x45, SENSOR_KIND_SHT31 },
+    { 0x76, SENSOR_KIND_BMP280 },
+    { 0x77, SENSOR_KIND_BMP280 },
+};
+
+// a slot as cached in the settings, 0 for none
+inline uint16_t makeSensorSlot(uint8_t kind, uint8_t address) {
+    return (uint16_t) kind << 8 | address;
+}
+
+// The I2C bus and the drivers for what's on it, supplied by the platform
+class SensorBus {
+public:
+    virtual ~SensorBus() {}
+    // whether a device acknowledges its address
+    virtual bool probe(uint8_t address) = 0;
+    // the driver of kind at address, NULL if there is none
+    virtual SensorDriver *driver(uint8_t kind, uint8_t address) = 0;
+};
+
+struct SensorChannel {
+    uint8_t kind;
+    uint8_t address;
+    SensorDriver *driver;
+    SensorReading reading;
+    uint32_t timestamp_s;  // station clock of the reading
+    bool valid;            // whether the last measurement worked
+};
+
+class SensorRegistry {
+public:
+    // Probes the known addresses but the climate sensor's and sets up what answers. Writes the
+    // slots found to slots, returns whether they differ from what was there.
+    bool scan(SensorBus &bus, uint16_t *slots) {
+        count = 0;
+        for(size_t i = 0; i < sizeof sensorProbes / sizeof sensorProbes[0] && count < SENSOR_SLOTS; i++) {
+            const SensorProbe &probe = sensorProbes[i];
+            if(probe.address != SENSOR_PRIMARY_ADDRESS && bus.probe(probe.address)) {
+                // something else may sit at the address, the driver's begin() checks
+                add(bus, probe.kind, probe.address);
+            }
+        }
+        bool changed = false;
+        for(uint8_t i = 0; i < SENSOR_SLOTS; i++) {
+            uint16_t slot = i < count ? makeSensorSlot(channels[i].kind, channels[i].address) : 0;
+            changed |= slots[i] != slot;
+            slots[i] = slot;
+        }
+        return changed;
+    }
+
+    // Sets up the drivers of slots found by an earlier scan
+    void load(SensorBus &bus, const uint16_t *slots) {
+        count = 0;
+        for(uint8_t i = 0; i < SENSOR_SLOTS; i++) {
+            if(slots[i] != 0) {
+                add(bus, slots[i] >> 8, slots[i] & 0xFF);
+            }
+        }
+    }
+
+    // Measures every sensor, returns how many of them worked
+    uint8_t measure(uint32_t timestamp_s) {
+        uint8_t measured = 0;
+        for(uint8_t i = 0; i < count; i++) {
+            SensorChannel &channel = channels[i];
+            channel.valid = channel.driver->measure(channel.reading);
+            channel.timestamp_s = timestamp_s;
+            measured += channel.valid;
+        }
+        return measured;
+    }
+
+    void sleep() {
+        for(uint8_t i = 0; i < count; i++) {
+            channels[i].driver->sleep();
+        }
+    }
+
+    uint8_t size() const {
+        return count;
+    }
+
+    const SensorChannel &at(uint8_t i) const {
+        return channels[i];
+    }
+
+    // e.g. "sht31_45", the sensor tag of its lines
+    static void name(const SensorChannel &channel, char *dst, size_t capacity) {
+        snprintf(dst, capacity, "%s_%02x", sensorKindName(channel.kind), channel.address);
+    }
+
+private:
+    void add(SensorBus &bus, uint8_t kind, uint8_t address) {
+        SensorDriver *driver = bus.driver(kind, address);
+        if(driver == NULL || !driver->begin()) {
+            return;
+        }
+        SensorChannel &channel = channels[count++];
+        channel.kind = kind;
+        channel.address = address;
+        channel.driver = driver;
+        channel.valid = false;
+    }
+
+    SensorChannel channels[SENSOR_SLOTS];
+    uint8_t count = 0;
+};
+
+#endif
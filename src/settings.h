@@ -3,52 +3,48 @@
 
 #include <EEPROM.h>
 #include <ESP8266WebServer.h>
-#include <ArduinoJson.h>
-
-struct struct_settings
-{
-    int magicNumber;
-    int deepSleepTimer;
-    bool influxEnabled;
-    char influxHost[20];
-    unsigned short influxPort;
-    char influxDatabase[20];
-    char influxSeries[20];
-    char influxTags[30];
-    char displayContrast;
-    char lowPowerContrast;
-};
-
-const int MAGIC_NUMBER = 0x1a512f59;
-
-struct_settings settings;
+#include "config.h"
+#include "settingsstore.h"
 
+// Only commits when the encoded settings differ from what's in EEPROM, every commit erases and
+// rewrites the whole flash sector
 void saveSettings()
 {
-    Serial.println("Storing settings");
-    EEPROM.put(0, settings);
+    uint8_t data[SETTINGS_STORE_SIZE];
+    size_t length = encodeSettings(settings, data, sizeof data);
+    bool changed = false;
+    for(size_t i = 0; i < length; i++) {
+        if(EEPROM.read(i) != data[i]) {
+            EEPROM.write(i, data[i]);
+            changed = true;
+        }
+    }
+    if(!changed) {
+        Serial.println("Settings unchanged");
+        return;
+    }
+    Serial.println("Storing settings, " + String(length) + " bytes");
     EEPROM.commit();
 }
 
 void resetSettings() {
     Serial.println("Resetting settings");
-    settings.magicNumber = MAGIC_NUMBER;
-    settings.deepSleepTimer = 10; // every 10 seconds
-    settings.influxEnabled = false;
-    settings.influxHost[0] = 0;
-    settings.influxPort = 8086;
-    String("climate").getBytes((unsigned char*) &(settings.influxSeries), sizeof settings.influxSeries, 0);
-    String("name=Sensor 1").getBytes((unsigned char*) &(settings.influxTags), sizeof settings.influxSeries, 0);
+    defaultSettings(settings);
     saveSettings();
 }
 
 void loadSettings()
 {
-    EEPROM.begin(sizeof settings);
-    EEPROM.get(0, settings);
-    Serial.println("Settings magic number is " + String(settings.magicNumber, 16));
-    if (settings.magicNumber != MAGIC_NUMBER)
-    {
+    EEPROM.begin(SETTINGS_STORE_SIZE);
+    uint8_t data[SETTINGS_STORE_SIZE];
+    for(size_t i = 0; i < sizeof data; i++) {
+        data[i] = EEPROM.read(i);
+    }
+    SettingsLoad result = decodeSettings(data, sizeof data, settings);
+    if(result == SETTINGS_MIGRATED) {
+        Serial.println("Migrating settings");
+        saveSettings();
+    } else if(result == SETTINGS_DEFAULTS) {
         resetSettings();
     }
 }
@@ -0,0 +1,296 @@
+#ifndef __SETTINGS_JSON__
+#define __SETTINGS_JSON__
+
+#include <stdlib.h>
+#include "config.h"
+#include "jsonstream.h"
+#include "samples.h"
+#include "filter.h"
+#include "sensor.h"
+#include "uploader.h"
+
+// The settings as the JSON of the /settings endpoint, written and read with jsonstream.h so
+// neither direction keeps a copy of the document in memory.
+
+enum SettingsJsonType {
+    SETTINGS_JSON_NUMBER,
+    SETTINGS_JSON_BOOL,
+    SETTINGS_JSON_STRING
+};
+
+struct SettingsJsonField {
+    const char *path;
+    uint16_t offset;
+    uint8_t size;
+    uint8_t type;   // see SettingsJsonType
+    long min;       // range of numbers
+    long max;
+};
+
+#define SETTINGS_JSON_FIELD(path, field, type, min, max) { path, offsetof(struct_settings, field), sizeof(((struct_settings *) 0)->field), type, min, max }
+
+// everything but the names of enums, which need a lookup
+const SettingsJsonField settingsJsonFields[] = {
+    SETTINGS_JSON_FIELD("influx.enabled", influxEnabled, SETTINGS_JSON_BOOL, 0, 1),
+    SETTINGS_JSON_FIELD("influx.host", influxHost, SETTINGS_JSON_STRING, 0, 0),
+    SETTINGS_JSON_FIELD("influx.port", influxPort, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("influx.udpPort", influxUdpPort, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("influx.database", influxDatabase, SETTINGS_JSON_STRING, 0, 0),
+    SETTINGS_JSON_FIELD("influx.series", influxSeries, SETTINGS_JSON_STRING, 0, 0),
+    SETTINGS_JSON_FIELD("influx.tags", influxTags, SETTINGS_JSON_STRING, 0, 0),
+    // the schedule works with 16 bit intervals
+    SETTINGS_JSON_FIELD("lowpower.updateInterval", deepSleepTimer, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("lowpower.maxUpdateInterval", deepSleepMaxTimer, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("lowpower.contrast", lowPowerContrast, SETTINGS_JSON_NUMBER, 0, 255),
+    SETTINGS_JSON_FIELD("lowpower.batchSize", batchSize, SETTINGS_JSON_NUMBER, 1, SAMPLE_BUFFER_SIZE),
+    SETTINGS_JSON_FIELD("lowpower.batchMaxAge", batchMaxAge, SETTINGS_JSON_NUMBER, 0, 65535),
+    SETTINGS_JSON_FIELD("lowpower.clockSyncWakes", clockSyncWakes, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("general.contrast", displayContrast, SETTINGS_JSON_NUMBER, 0, 255),
+    SETTINGS_JSON_FIELD("sensor.heater", sensorHeater, SETTINGS_JSON_BOOL, 0, 1),
+    SETTINGS_JSON_FIELD("filter.window", filterWindow, SETTINGS_JSON_NUMBER, 1, FILTER_WINDOW_MAX),
+    SETTINGS_JSON_FIELD("filter.emaShift", filterEmaShift, SETTINGS_JSON_NUMBER, 0, 8),
+    SETTINGS_JSON_FIELD("filter.hysteresis", filterHysteresis, SETTINGS_JSON_NUMBER, 0, 255),
+    SETTINGS_JSON_FIELD("filter.oversample", filterOversample, SETTINGS_JSON_NUMBER, 1, 255),
+    SETTINGS_JSON_FIELD("mqtt.host", mqttHost, SETTINGS_JSON_STRING, 0, 0),
+    SETTINGS_JSON_FIELD("mqtt.port", mqttPort, SETTINGS_JSON_NUMBER, 1, 65535),
+    SETTINGS_JSON_FIELD("mqtt.topic", mqttTopic, SETTINGS_JSON_STRING, 0, 0),
+    SETTINGS_JSON_FIELD("mqtt.qos", mqttQos, SETTINGS_JSON_NUMBER, 0, 1),
+    SETTINGS_JSON_FIELD("mqtt.retain", mqttRetain, SETTINGS_JSON_BOOL, 0, 1),
+    SETTINGS_JSON_FIELD("gateway.enabled", gatewayEnabled, SETTINGS_JSON_BOOL, 0, 1),
+};
+
+const char *filterModeName(uint8_t mode) {
+    return mode == FILTER_MEDIAN ? "median" : mode == FILTER_EMA ? "ema" : "none";
+}
+
+void writeSettingsJson(JsonWriter &json, const struct_settings &s) {
+    json.beginObject();
+    json.beginObject("influx");
+    json.boolean("enabled", s.influxEnabled);
+    json.string("host", s.influxHost);
+    json.number("port", s.influxPort);
+    json.number("udpPort", s.influxUdpPort);
+    json.string("database", s.influxDatabase);
+    json.string("series", s.influxSeries);
+    json.string("tags", s.influxTags);
+    json.endObject();
+
+    json.beginObject("lowpower");
+    json.number("updateInterval", s.deepSleepTimer);
+    json.number("maxUpdateInterval", s.deepSleepMaxTimer);
+    json.number("contrast", (unsigned char) s.lowPowerContrast);
+    json.number("batchSize", s.batchSize);
+    json.number("batchMaxAge", s.batchMaxAge);
+    json.number("clockSyncWakes", s.clockSyncWakes);
+    json.endObject();
+
+    json.beginObject("general");
+    json.number("contrast", (unsigned char) s.displayContrast);
+    json.endObject();
+
+    json.beginObject("sensor");
+    json.string("repeatability", sensorRepeatabilityName((SensorRepeatability) s.sensorRepeatability));
+    json.boolean("heater", s.sensorHeater);
+    json.endObject();
+
+    json.beginObject("filter");
+    json.string("mode", filterModeName(s.filterMode));
+    json.number("window", s.filterWindow);
+    json.number("emaShift", s.filterEmaShift);
+    json.number("hysteresis", s.filterHysteresis);
+    json.number("oversample", s.filterOversample);
+    json.endObject();
+
+    json.beginObject("upload");
+    json.string("protocol", uploadProtocolName(s.uploadProtocol));
+    json.endObject();
+
+    json.beginObject("mqtt");
+    json.string("host", s.mqttHost);
+    json.number("port", s.mqttPort);
+    json.string("topic", s.mqttTopic);
+    json.number("qos", s.mqttQos);
+    json.boolean("retain", s.mqttRetain);
+    json.endObject();
+
+    json.beginObject("gateway");
+    json.boolean("enabled", s.gatewayEnabled);
+    json.endObject();
+    json.endObject();
+}
+
+// Writes the values of a /settings body into target as JsonReader comes across them. Settings
+// the body leaves out keep their value, unknown ones are ignored.
+class SettingsJsonParser : public JsonHandler {
+public:
+    SettingsJsonParser(struct_settings &target) : target(target) {
+    }
+
+    bool value(const char *path, const char *value, bool quoted) override {
+        if(strcmp(path, "sensor.repeatability") == 0) {
+            for(uint8_t repeatability = SENSOR_REPEATABILITY_HIGH; repeatability <= SENSOR_REPEATABILITY_LOW; repeatability++) {
+                if(quoted && strcmp(value, sensorRepeatabilityName((SensorRepeatability) repeatability)) == 0) {
+                    target.sensorRepeatability = repeatability;
+                    return true;
+                }
+            }
+            return invalid(path);
+        }
+        if(strcmp(path, "filter.mode") == 0) {
+            for(uint8_t mode = FILTER_NONE; mode <= FILTER_EMA; mode++) {
+                if(quoted && strcmp(value, filterModeName(mode)) == 0) {
+                    target.filterMode = mode;
+                    return true;
+                }
+            }
+            return invalid(path);
+        }
+        if(strcmp(path, "upload.protocol") == 0) {
+            for(uint8_t protocol = UPLOAD_INFLUX; protocol <= UPLOAD_GATEWAY; protocol++) {
+                if(quoted && strcmp(value, uploadProtocolName(protocol)) == 0) {
+                    target.uploadProtocol = protocol;
+                    return true;
+                }
+            }
+            return invalid(path);
+        }
+        for(size_t i = 0; i < sizeof settingsJsonFields / sizeof settingsJsonFields[0]; i++) {
+            if(strcmp(path, settingsJsonFields[i].path) == 0) {
+                return store(settingsJsonFields[i], value, quoted) || invalid(path);
+            }
+        }
+        return true;
+    }
+
+    // Checks what depends on more than one setting, after the whole body was read
+    bool validate() {
+        if(target.influxEnabled && target.uploadProtocol == UPLOAD_INFLUX && (
+            target.influxDatabase[0] == 0 ||
+            target.influxHost[0] == 0 ||
+            target.influxSeries[0] == 0
+        )) {
+            snprintf(error, sizeof error, "Influx enabled but not enough details provided");
+            return false;
+        }
+        // the UDP listener writes to the database it's configured with
+        if(target.influxEnabled && target.uploadProtocol == UPLOAD_UDP && (
+            target.influxHost[0] == 0 ||
+            target.influxSeries[0] == 0
+        )) {
+            snprintf(error, sizeof error, "UDP enabled but not enough details provided");
+            return false;
+        }
+        if(target.influxEnabled && target.uploadProtocol == UPLOAD_MQTT && (
+            target.mqttHost[0] == 0 ||
+            target.mqttTopic[0] == 0 ||
+            target.influxSeries[0] == 0
+        )) {
+            snprintf(error, sizeof error, "MQTT enabled but not enough details provided");
+            return false;
+        }
+        // forwards with the InfluxDB settings, whatever its own samples go out with
+        if(target.gatewayEnabled && (
+            target.influxDatabase[0] == 0 ||
+            target.influxHost[0] == 0 ||
+            target.influxSeries[0] == 0
+        )) {
+            snprintf(error, sizeof error, "Gateway enabled but not enough details provided");
+            return false;
+        }
+        if(target.gatewayEnabled && target.uploadProtocol == UPLOAD_GATEWAY) {
+            snprintf(error, sizeof error, "A gateway can't upload through a gateway");
+            return false;
+        }
+        // wildcards are only for subscribing
+        if(strpbrk(target.mqttTopic, "+#") != NULL) {
+            snprintf(error, sizeof error, "MQTT topic can't contain + or #");
+            return false;
+        }
+        return true;
+    }
+
+    char error[JSON_PATH_SIZE + 24] = "";
+
+private:
+    bool invalid(const char *path) {
+        snprintf(error, sizeof error, "Invalid value for %s", path);
+        return false;
+    }
+
+    bool store(const SettingsJsonField &field, const char *value, bool quoted) {
+        uint8_t *at = (uint8_t *) &target + field.offset;
+        if(field.type == SETTINGS_JSON_STRING) {
+            if(!quoted || strlen(value) >= field.size) {
+                return false;
+            }
+            memset(at, 0, field.size);
+            memcpy(at, value, strlen(value));
+            return true;
+        }
+        long number;
+        if(field.type == SETTINGS_JSON_BOOL) {
+            if(quoted || (strcmp(value, "true") != 0 && strcmp(value, "false") != 0)) {
+                return false;
+            }
+            number = value[0] == 't';
+        } else {
+            char *end;
+            number = strtol(value, &end, 10);
+            if(quoted || end == value || *end != 0 || number < field.min || number > field.max) {
+                return false;
+            }
+        }
+        // little-endian, like settingsstore.h
+        memcpy(at, &number, field.size);
+        return true;
+    }
+
+    struct_settings &target;
+};
+
+// Reads a /energy body: the supply current of each phase by name under current_uA, and reset
+// to start the account over. Phases the body leaves out keep their current, other keys are ignored.
+// The currents are written as they're read, so current_uA is a copy until finish() said yes.
+class EnergyJsonParser : public JsonHandler {
+public:
+    EnergyJsonParser(uint32_t *current_uA) : current_uA(current_uA) {
+    }
+
+    bool value(const char *path, const char *value, bool quoted) override {
+        if(strcmp(path, "reset") == 0) {
+            if(quoted || (strcmp(value, "true") != 0 && strcmp(value, "false") != 0)) {
+                return invalid(path);
+            }
+            reset = value[0] == 't';
+            return true;
+        }
+        if(strncmp(path, "current_uA.", 11) != 0) {
+            return true;
+        }
+        for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+            if(strcmp(path + 11, energyPhaseName(phase)) == 0) {
+                char *end;
+                unsigned long current = strtoul(value, &end, 10);
+                if(quoted || value[0] == '-' || end == value || *end != 0 || current > ENERGY_MAX_CURRENT_UA) {
+                    return invalid(path);
+                }
+                current_uA[phase] = current;
+                return true;
+            }
+        }
+        return true;
+    }
+
+    bool reset = false;
+    char error[JSON_PATH_SIZE + 24] = "";
+
+private:
+    bool invalid(const char *path) {
+        snprintf(error, sizeof error, "Invalid value for %s", path);
+        return false;
+    }
+
+    uint32_t *current_uA;
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef __SETTINGS_STORE__
+#define __SETTINGS_STORE__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "config.h"
+#include "crc.h"
+
+// Binary format of the settings in EEPROM, without the EEPROM itself so it can run on the host.
+//
+//   'S' 'T' version length(u16) { tag(u8) size(u8) value }* crc16
+//
+// The crc covers everything before it. Unknown tags are skipped and missing ones keep their
+// default, so adding a setting only needs a new tag and an older firmware still reads what it
+// knows. A tag is never reused: a setting that changes meaning or unit gets a new one, and the
+// version goes up when the meaning of existing entries changes in a way the tags can't tell.
+// Integers are stored in the byte order of the board, which is little-endian like the hosts the
+// simulator runs on, and may be read into a field of another width. Strings are stored without
+// their terminating zero.
+//
+// Before, the struct was written as is behind a magic number, see LegacySettings.
+
+#define SETTINGS_STORE_SIZE 512  // bytes of EEPROM reserved, also covers the legacy struct
+#define SETTINGS_STORE_VERSION 1
+#define SETTINGS_HEADER_SIZE 5
+#define SETTINGS_CRC_SIZE 2
+
+enum SettingsLoad {
+    SETTINGS_LOADED,
+    SETTINGS_MIGRATED,  // from an older format, should be stored again
+    SETTINGS_DEFAULTS   // nothing usable was stored
+};
+
+struct SettingsField {
+    uint8_t tag;
+    uint16_t offset;
+    uint8_t size;
+    uint8_t element;  // bytes of each integer, 0 for a string
+};
+
+#define SETTING_VALUE(tag, field) { tag, offsetof(struct_settings, field), sizeof(((struct_settings *) 0)->field), sizeof(((struct_settings *) 0)->field) }
+#define SETTING_ARRAY(tag, field) { tag, offsetof(struct_settings, field), sizeof(((struct_settings *) 0)->field), sizeof(((struct_settings *) 0)->field[0]) }
+#define SETTING_STRING(tag, field) { tag, offsetof(struct_settings, field), sizeof(((struct_settings *) 0)->field), 0 }
+
+// tags are part of the format, add new ones at the end
+const SettingsField settingsFields[] = {
+    SETTING_VALUE(1, deepSleepTimer),
+    SETTING_VALUE(2, deepSleepMaxTimer),
+    SETTING_VALUE(3, influxEnabled),
+    SETTING_STRING(4, influxHost),
+    SETTING_VALUE(5, influxPort),
+    SETTING_STRING(6, influxDatabase),
+    SETTING_STRING(7, influxSeries),
+    SETTING_STRING(8, influxTags),
+    SETTING_VALUE(9, displayContrast),
+    SETTING_VALUE(10, lowPowerContrast),
+    SETTING_VALUE(11, batchSize),
+    SETTING_VALUE(12, batchMaxAge),
+    SETTING_VALUE(13, sensorRepeatability),
+    SETTING_VALUE(14, sensorHeater),
+    SETTING_VALUE(15, filterMode),
+    SETTING_VALUE(16, filterWindow),
+    SETTING_VALUE(17, filterEmaShift),
+    SETTING_VALUE(18, filterHysteresis),
+    SETTING_VALUE(19, filterOversample),
+    SETTING_ARRAY(20, phaseCurrent_uA),
+    SETTING_VALUE(21, clockSyncWakes),
+    SETTING_VALUE(22, uploadProtocol),
+    SETTING_STRING(23, mqttHost),
+    SETTING_VALUE(24, mqttPort),
+    SETTING_STRING(25, mqttTopic),
+    SETTING_VALUE(26, mqttQos),
+    SETTING_VALUE(27, mqttRetain),
+    SETTING_VALUE(28, influxUdpPort),
+    SETTING_ARRAY(29, sensorSlots),
+    SETTING_VALUE(30, gatewayEnabled),
+};
+
+const size_t SETTINGS_FIELDS = sizeof settingsFields / sizeof settingsFields[0];
+
+// The struct as it was stored raw with magic number 0x1a512f59, before this format
+struct LegacySettings {
+    int magicNumber;
+    int deepSleepTimer;
+    bool influxEnabled;
+    char influxHost[20];
+    unsigned short influxPort;
+    char influxDatabase[20];
+    char influxSeries[20];
+    char influxTags[30];
+    char displayContrast;
+    char lowPowerContrast;
+};
+
+const int LEGACY_MAGIC = 0x1a512f59;
+
+static_assert(sizeof(LegacySettings) <= SETTINGS_STORE_SIZE, "legacy settings must fit in the store");
+
+// Upper bound of what encodeSettings() writes
+constexpr size_t settingsMaxSize() {
+    return SETTINGS_HEADER_SIZE + SETTINGS_CRC_SIZE + 2 * SETTINGS_FIELDS + sizeof(struct_settings);
+}
+
+static_assert(settingsMaxSize() <= SETTINGS_STORE_SIZE, "settings must fit in the store");
+
+// Writes s to data, returns the bytes used or 0 if size is too small
+size_t encodeSettings(const struct_settings &s, uint8_t *data, size_t size) {
+    const uint8_t *base = (const uint8_t *) &s;
+    size_t length = SETTINGS_HEADER_SIZE;
+    for(size_t i = 0; i < SETTINGS_FIELDS; i++) {
+        const SettingsField &field = settingsFields[i];
+        size_t valueSize = field.element == 0 ? strnlen((const char *) base + field.offset, field.size - 1) : field.size;
+        if(length + 2 + valueSize + SETTINGS_CRC_SIZE > size) {
+            return 0;
+        }
+        data[length++] = field.tag;
+        data[length++] = (uint8_t) valueSize;
+        memcpy(data + length, base + field.offset, valueSize);
+        length += valueSize;
+    }
+    size_t payload = length - SETTINGS_HEADER_SIZE;
+    data[0] = 'S';
+    data[1] = 'T';
+    data[2] = SETTINGS_STORE_VERSION;
+    data[3] = payload & 0xFF;
+    data[4] = payload >> 8;
+    uint16_t crc = crc16(data, length);
+    data[length++] = crc & 0xFF;
+    data[length++] = crc >> 8;
+    return length;
+}
+
+// Copies a stored value to its field, integers of another width are truncated or zero extended
+void decodeSettingsField(const SettingsField &field, const uint8_t *value, uint8_t valueSize, struct_settings &s) {
+    uint8_t *target = (uint8_t *) &s + field.offset;
+    if(field.element == 0) {
+        memset(target, 0, field.size);
+        memcpy(target, value, valueSize < field.size - 1 ? valueSize : field.size - 1);
+    } else if(field.element == field.size) {
+        memset(target, 0, field.size);
+        memcpy(target, value, valueSize < field.size ? valueSize : field.size);
+    } else {
+        // arrays keep their element width, a longer one has entries this firmware doesn't know
+        size_t length = valueSize - valueSize % field.element;
+        memcpy(target, value, length < field.size ? length : field.size);
+    }
+}
+
+// Strings of the legacy struct are terminated within their field, unless it was written without
+void copyLegacyString(char *target, size_t targetSize, const char *source, size_t sourceSize) {
+    size_t length = strnlen(source, sourceSize - 1);
+    memset(target, 0, targetSize);
+    memcpy(target, source, length < targetSize - 1 ? length : targetSize - 1);
+}
+
+SettingsLoad decodeLegacySettings(const uint8_t *data, size_t size, struct_settings &s) {
+    LegacySettings old;
+    memset(&old, 0, sizeof old);
+    memcpy(&old, data, size < sizeof old ? size : sizeof old);
+    s.deepSleepTimer = old.deepSleepTimer;
+    s.influxEnabled = old.influxEnabled;
+    copyLegacyString(s.influxHost, sizeof s.influxHost, old.influxHost, sizeof old.influxHost);
+    s.influxPort = old.influxPort;
+    copyLegacyString(s.influxDatabase, sizeof s.influxDatabase, old.influxDatabase, sizeof old.influxDatabase);
+    copyLegacyString(s.influxSeries, sizeof s.influxSeries, old.influxSeries, sizeof old.influxSeries);
+    copyLegacyString(s.influxTags, sizeof s.influxTags, old.influxTags, sizeof old.influxTags);
+    s.displayContrast = old.displayContrast;
+    s.lowPowerContrast = old.lowPowerContrast;
+    return SETTINGS_MIGRATED;
+}
+
+// Reads settings stored by encodeSettings() or the legacy struct into s. Whatever isn't
+// stored takes its default.
+SettingsLoad decodeSettings(const uint8_t *data, size_t size, struct_settings &s) {
+    defaultSettings(s);
+    int magic = 0;
+    memcpy(&magic, data, size < sizeof magic ? size : sizeof magic);
+    if(magic == LEGACY_MAGIC) {
+        return decodeLegacySettings(data, size, s);
+    }
+
+    if(size < SETTINGS_HEADER_SIZE + SETTINGS_CRC_SIZE || data[0] != 'S' || data[1] != 'T') {
+        return SETTINGS_DEFAULTS;
+    }
+    size_t payload = data[3] | (size_t) data[4] << 8;
+    size_t end = SETTINGS_HEADER_SIZE + payload;
+    if(end + SETTINGS_CRC_SIZE > size || (data[end] | (uint16_t) data[end + 1] << 8) != crc16(data, end)) {
+        return SETTINGS_DEFAULTS;
+    }
+    for(size_t at = SETTINGS_HEADER_SIZE; at + 2 <= end && at + 2 + data[at + 1] <= end; at += 2 + data[at + 1]) {
+        for(size_t i = 0; i < SETTINGS_FIELDS; i++) {
+            if(settingsFields[i].tag == data[at]) {
+                decodeSettingsField(settingsFields[i], data + at + 2, data[at + 1], s);
+                break;
+            }
+        }
+    }
+    // a newer version is read as far as it's understood, but not overwritten until it's changed
+    return data[2] < SETTINGS_STORE_VERSION ? SETTINGS_MIGRATED : SETTINGS_LOADED;
+}
+
+#endif
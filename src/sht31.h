@@ -0,0 +1,136 @@
+#ifndef __SHT31__
+#define __SHT31__
+
+#include "sensor.h"
+#include <Arduino.h>
+#include <ClosedCube_SHT31D.h>
+
+// periodic reads happen once a second, measuring twice as fast guarantees fresh data each time
+#define SHT31_PERIODIC_FREQUENCY SHT3XD_FREQUENCY_2HZ
+#define SHT31_POLLING_TIMEOUT_MS 50
+#define SHT31_BREAK_MS 1   // to abort a periodic measurement, from the datasheet
+#define SHT31_RESET_MS 2   // to reload the calibration after a soft reset, 1.5 ms at most
+
+const char *SHT3XD_Error_to_String(SHT31D_ErrorCode err)
+{
+  switch (err)
+  {
+  case SHT3XD_NO_ERROR:
+    return "SHT3XD_NO_ERROR";
+  case SHT3XD_CRC_ERROR:
+    return "SHT3XD_CRC_ERROR ";
+  case SHT3XD_TIMEOUT_ERROR:
+    return "SHT3XD_TIMEOUT_ERROR ";
+  case SHT3XD_PARAM_WRONG_MODE:
+    return "SHT3XD_PARAM_WRONG_MODE ";
+  case SHT3XD_PARAM_WRONG_REPEATABILITY:
+    return "SHT3XD_PARAM_WRONG_REPEATABILITY ";
+  case SHT3XD_PARAM_WRONG_FREQUENCY:
+    return "SHT3XD_PARAM_WRONG_FREQUENCY ";
+  case SHT3XD_PARAM_WRONG_ALERT:
+    return "SHT3XD_PARAM_WRONG_ALERT ";
+  case SHT3XD_WIRE_I2C_DATA_TOO_LOG:
+    return "SHT3XD_WIRE_I2C_DATA_TOO_LOG ";
+  case SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_ADDRESS:
+    return "SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_ADDRESS ";
+  case SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_DATA:
+    return "SHT3XD_WIRE_I2C_RECEIVED_NACK_ON_DATA ";
+  case SHT3XD_WIRE_I2C_UNKNOW_ERROR:
+    return "SHT3XD_WIRE_I2C_UNKNOW_ERROR ";
+  default: return "WTF?";
+  }
+}
+
+class SHT31Sensor : public ClimateSensor {
+public:
+    SHT31Sensor(uint8_t address) : address(address) {
+    }
+
+    // The sensor stays powered through an ESP.restart() and may still be measuring periodically,
+    // when it doesn't take single shot commands. It's stopped and soft reset to its power up state.
+    bool begin() override {
+        if(!check(sht3xd.begin(address)) || !check(sht3xd.periodicStop())) {
+            return false;
+        }
+        delay(SHT31_BREAK_MS);
+        if(!check(sht3xd.softReset())) {
+            return false;
+        }
+        delay(SHT31_RESET_MS);
+        mode = SENSOR_SINGLE_SHOT;
+        return true;
+    }
+
+    bool configure(SensorMode mode, SensorRepeatability repeatability) override {
+        if(this->mode == SENSOR_PERIODIC && !check(sht3xd.periodicStop())) {
+            return false;
+        }
+        this->mode = mode;
+        this->repeatability = toSHT31(repeatability);
+        if(mode == SENSOR_PERIODIC) {
+            return check(sht3xd.periodicStart(this->repeatability, SHT31_PERIODIC_FREQUENCY));
+        }
+        return true;
+    }
+
+    bool read(float &temperature_C, float &humidity_pct) override {
+        SHT31D data;
+        switch(mode) {
+        case SENSOR_PERIODIC:
+            data = sht3xd.periodicFetchData();
+            break;
+        case SENSOR_CLOCK_STRETCH:
+            data = sht3xd.readTempAndHumidity(repeatability, SHT3XD_MODE_CLOCK_STRETCH, 0);
+            break;
+        default:
+            data = sht3xd.readTempAndHumidity(repeatability, SHT3XD_MODE_POLLING, SHT31_POLLING_TIMEOUT_MS);
+            break;
+        }
+        if(!check(data.error)) {
+            return false;
+        }
+        temperature_C = data.t;
+        humidity_pct = data.rh;
+        return true;
+    }
+
+    bool setHeater(bool on) override {
+        return check(on ? sht3xd.heaterEnable() : sht3xd.heaterDisable());
+    }
+
+    void sleep() override {
+        if(mode == SENSOR_PERIODIC) {
+            check(sht3xd.periodicStop());
+            mode = SENSOR_SINGLE_SHOT;
+        }
+    }
+
+    const char *lastError() override {
+        return SHT3XD_Error_to_String(error);
+    }
+
+private:
+    bool check(SHT31D_ErrorCode result) {
+        error = result;
+        return result == SHT3XD_NO_ERROR;
+    }
+
+    static SHT31D_Repeatability toSHT31(SensorRepeatability repeatability) {
+        switch(repeatability) {
+        case SENSOR_REPEATABILITY_MEDIUM:
+            return SHT3XD_REPEATABILITY_MEDIUM;
+        case SENSOR_REPEATABILITY_LOW:
+            return SHT3XD_REPEATABILITY_LOW;
+        default:
+            return SHT3XD_REPEATABILITY_HIGH;
+        }
+    }
+
+    ClosedCube_SHT31D sht3xd;
+    uint8_t address;
+    SensorMode mode = SENSOR_SINGLE_SHOT;
+    SHT31D_Repeatability repeatability = SHT3XD_REPEATABILITY_HIGH;
+    SHT31D_ErrorCode error = SHT3XD_NO_ERROR;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef __HAL_SIM__
+#define __HAL_SIM__
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include "../hal.h"
+
+// Every wake runs in a forked process that exits on deep sleep, so nothing but the RTC blob
+// survives from one wake to the next, as on the board. The blob, the simulated clock and the
+// statistics live in a shared mapping the runner keeps across the wakes. With the nodes of a
+// gateway there's a blob for each, and their wakes take turns on the one clock.
+
+// what the operations cost in simulated time
+#define SIM_BOOT_MS 120            // ROM and SDK init before setup(), already on millis() when it starts
+#define SIM_SENSOR_READ_MS 15      // clock stretched measurement at high repeatability
+#define SIM_PRESSURE_READ_MS 7     // forced BMP280 measurement at 1x oversampling
+#define SIM_FAST_CONNECT_MS 300    // cached channel, BSSID and IP
+#define SIM_FULL_CONNECT_MS 3000   // scan, association and DHCP
+#define SIM_RTT_MS 100             // round trip to the server
+#define SIM_DATAGRAM_MS 2          // handing a datagram to the stack and getting it on air
+#define SIM_DISPLAY_UPDATE_MS 10
+#define SIM_LINK_BEGIN_MS 15       // radio up without associating, for ESP-NOW
+#define SIM_LINK_FRAME_MS 2        // an ESP-NOW frame on air and the SDK's callback
+
+#define SIM_RTC_SIZE 512
+#define SIM_NODES 16
+
+struct SimShared {
+    uint64_t now_ms;        // simulated time since the start of the run
+    uint64_t wakeStart_ms;
+    uint32_t epoch_s;       // unix time at the start of the run
+    uint64_t wakeEnd_ms;    // when the last wake went to sleep
+    int32_t sleepDrift_ppm; // how much longer deep sleep takes than asked for, as the RTC oscillator is off
+    uint8_t node;           // whose wake it is
+    bool rtcValid[SIM_NODES];
+    uint8_t rtc[SIM_NODES][SIM_RTC_SIZE];
+
+    uint64_t wakes;
+    uint64_t awake_ms;
+    uint64_t radio_ms;
+    uint64_t sleep_ms;
+    uint64_t fastConnects;
+    uint64_t fullConnects;
+    uint64_t fastWakes;         // wakes that connected through the cache
+    uint64_t fastWake_ms;       // and how long they took, the critical path of an upload
+    uint64_t displayUpdates;
+    uint64_t requests;
+    uint64_t bytesSent;
+    uint64_t samplesAccepted;
+    uint64_t framesSent;        // by the nodes over the link to the gateway
+    uint64_t framesLost;
+};
+
+SimShared *sim;
+bool simVerbose = false;
+bool simWifiConnected = false;
+bool simRadioOn = false;
+bool simFastConnect = false;
+uint64_t simRadioOn_ms = 0;
+
+unsigned long halMillis() {
+    return (unsigned long) (sim->now_ms - sim->wakeStart_ms);
+}
+
+void halDelay(unsigned long ms) {
+    sim->now_ms += ms;
+}
+
+void halYield() {
+    sim->now_ms++;
+}
+
+time_t halTime() {
+    // SNTP syncs as soon as there's a connection
+    return simWifiConnected ? (time_t) (sim->epoch_s + sim->now_ms / 1000) : 0;
+}
+
+void halLog(const char *format, ...) {
+    if(!simVerbose) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    printf("%10.3f ", sim->now_ms / 1000.0);
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+uint32_t halRandom() {
+    // the same run gives the same results
+    return (uint32_t) (sim->now_ms * 2654435761u);
+}
+
+uint32_t halDeviceId() {
+    return 0x5137a1 + sim->node;
+}
+
+void halRtcRead(void *data, size_t size) {
+    memcpy(data, sim->rtc[sim->node], size < SIM_RTC_SIZE ? size : SIM_RTC_SIZE);
+}
+
+void halRtcWrite(const void *data, size_t size) {
+    memcpy(sim->rtc[sim->node], data, size < SIM_RTC_SIZE ? size : SIM_RTC_SIZE);
+    sim->rtcValid[sim->node] = true;
+}
+
+void halDeepSleep(uint32_t seconds) {
+    sim->awake_ms += sim->now_ms - sim->wakeStart_ms;
+    if(simRadioOn) {
+        sim->radio_ms += sim->now_ms - simRadioOn_ms;
+    }
+    if(simFastConnect) {
+        sim->fastWakes++;
+        sim->fastWake_ms += sim->now_ms - sim->wakeStart_ms;
+    }
+    uint64_t sleep_ms = seconds * 1000ULL + (int64_t) seconds * sim->sleepDrift_ppm / 1000;
+    sim->wakeEnd_ms = sim->now_ms;
+    sim->sleep_ms += sleep_ms;
+    sim->now_ms += sleep_ms;
+    fflush(stdout);
+    _exit(0);
+}
+
+bool halWifiBegin(WIFI_CACHE &cache, uint32_t now_s) {
+    if(simRadioOn) {
+        return true;
+    }
+    if(!wifiCacheUsable(cache, now_s)) {
+        return false;
+    }
+    simRadioOn = true;
+    simRadioOn_ms = sim->now_ms;
+    return true;
+}
+
+bool halWifiConnect(WIFI_CACHE &cache, uint32_t now_s) {
+    bool fast = halWifiBegin(cache, now_s);
+    if(fast) {
+        // whatever happened since it began overlapped with the association
+        sim->fastConnects++;
+        simFastConnect = true;
+        if(sim->now_ms < simRadioOn_ms + SIM_FAST_CONNECT_MS) {
+            halDelay(simRadioOn_ms + SIM_FAST_CONNECT_MS - sim->now_ms);
+        }
+    } else {
+        simRadioOn = true;
+        simRadioOn_ms = sim->now_ms;
+        sim->fullConnects++;
+        halDelay(SIM_FULL_CONNECT_MS);
+        memset(&cache, 0, sizeof cache);
+        cache.channel = 6;
+        cache.ip = 0x0a01a8c0;
+        cache.cachedAt_s = now_s;
+        cache.valid = true;
+    }
+    simWifiConnected = true;
+    return fast;
+}
+
+bool halWifiConnected() {
+    return simWifiConnected;
+}
+
+void halWifiOff() {
+    if(simRadioOn) {
+        sim->radio_ms += sim->now_ms - simRadioOn_ms;
+        simRadioOn = false;
+        simWifiConnected = false;
+    }
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef __LINK_SIM__
+#define __LINK_SIM__
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../gateway.h"
+#include "hal_sim.h"
+
+// how long a node waits in real time for the runner to answer a frame, once after sending it
+#define SIM_LINK_POLL_MS 20
+
+// The gateway link as UDP datagrams on the loopback interface, which stands in for the air:
+// whatever the address, what a node sends reaches the gateway. The gateway listens in the
+// runner, each wake of a node opens a socket of its own. Addresses are the IPv4 address and
+// port, in network byte order. Frames get lost at the rate given, in both directions.
+class SimLink : public GatewayLink {
+public:
+    // The gateway's end, before the first wake
+    bool listen() {
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof address;
+        if(fd < 0 || bind(fd, (struct sockaddr *) &address, sizeof address) != 0 ||
+                getsockname(fd, (struct sockaddr *) &address, &length) != 0) {
+            return false;
+        }
+        gatewayPort = address.sin_port;
+        gateway = true;
+        random = 1;
+        return true;
+    }
+
+    // A node of gateway without forking from it, for nodes in the same process
+    void sendTo(const SimLink &gateway) {
+        gatewayPort = gateway.gatewayPort;
+    }
+
+    void setLoss(uint8_t percent) {
+        loss = percent;
+    }
+
+    // Lets real time pass until a frame came in, for the runner while a node is awake
+    void wait(int ms) {
+        struct pollfd p = { fd, POLLIN, 0 };
+        poll(&p, 1, ms);
+    }
+
+    bool begin(uint8_t /* channel */) {
+        if(!gateway && fd >= 0) {
+            return true;
+        }
+        // a node, the socket of the gateway came along with the fork
+        if(fd >= 0) {
+            close(fd);
+        }
+        gateway = false;
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        random = (uint32_t) sim->now_ms * 2654435761u | 1;
+        if(!simRadioOn) {
+            simRadioOn = true;
+            simRadioOn_ms = sim->now_ms;
+        }
+        halDelay(SIM_LINK_BEGIN_MS);
+        return fd >= 0;
+    }
+
+    bool ready() {
+        return fd >= 0;
+    }
+
+    bool send(const uint8_t *address, const uint8_t *data, size_t length) {
+        struct sockaddr_in to = {};
+        to.sin_family = AF_INET;
+        if(gateway) {
+            memcpy(&to.sin_addr.s_addr, address, 4);
+            memcpy(&to.sin_port, address + 4, 2);
+        } else {
+            // the runner's clock stands still while it answers
+            halDelay(SIM_LINK_FRAME_MS);
+            sim->framesSent++;
+            answer = true;
+            to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            to.sin_port = gatewayPort;
+        }
+        if(lost()) {
+            sim->framesLost++;
+            return true;
+        }
+        return sendto(fd, data, length, 0, (struct sockaddr *) &to, sizeof to) == (ssize_t) length;
+    }
+
+    size_t receive(uint8_t *address, uint8_t *data, size_t capacity) {
+        struct pollfd p = { fd, POLLIN, 0 };
+        int wait_ms = answer ? SIM_LINK_POLL_MS : 0;
+        answer = false;
+        if(fd < 0 || poll(&p, 1, wait_ms) <= 0) {
+            return 0;
+        }
+        struct sockaddr_in from = {};
+        socklen_t length = sizeof from;
+        ssize_t n = recvfrom(fd, data, capacity, MSG_DONTWAIT, (struct sockaddr *) &from, &length);
+        if(n <= 0) {
+            return 0;
+        }
+        memcpy(address, &from.sin_addr.s_addr, 4);
+        memcpy(address + 4, &from.sin_port, 2);
+        return n;
+    }
+
+    void end() {
+        if(gateway || fd < 0) {
+            return;
+        }
+        close(fd);
+        fd = -1;
+    }
+
+private:
+    // xorshift, reproducible for the same run
+    bool lost() {
+        if(loss == 0) {
+            return false;
+        }
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        return random % 100 < loss;
+    }
+
+    int fd = -1;
+    bool gateway = false;
+    bool answer = false;  // a node sent and the runner may still be answering
+    uint16_t gatewayPort = 0;
+    uint8_t loss = 0;
+    uint32_t random = 1;
+};
+
+#endif
@@ -0,0 +1,401 @@
+// Runs the station's deep sleep wake cycles on a Linux host, see hal_sim.h. Every wake is a
+// forked process, the simulated clock only advances by what the operations would take on the
+// board, so a year of wakes takes seconds.
+//
+//   sim [--days N] [--csv readings.csv] [--out requests.txt | --server host:port] [--rtc rtc.bin]
+//       [--interval s] [--max-interval s] [--batch n] [--batch-age s] [--filter none|median|ema]
+//       [--oversample n] [--spool dir] [--outage from:to] [--sleep-drift ppm]
+//       [--mqtt qos | --udp port | --nodes n [--link-loss pct]] [--sensors 45,76] [--verbose]
+//
+// --outage makes the server unreachable between the two days, to exercise the spool. --mqtt
+// publishes to a broker instead of writing to InfluxDB, with --server e.g. a local mosquitto.
+// --udp sends datagrams to InfluxDB's UDP listener instead, compare the awake and radio on times
+// with a run without it to see what not waiting for responses saves. --sensors puts more sensors
+// on the bus besides the SHT31 at 0x44, by their hex address. --nodes runs that many stations
+// as nodes of a gateway, which the runner plays in between their wakes and which forwards to
+// the file or server. --link-loss drops that percentage of the frames between them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "hal_sim.h"
+#include "sensor_sim.h"
+#include "transport_sim.h"
+#include "storage_sim.h"
+#include "link_sim.h"
+
+// defined ahead of the uploader in station.h, which keeps a reference to the transport
+SimSensor simSensor;
+SimSensorBus simSensorBus(simSensor);
+SimTransport simTransport;
+SimStorage simStorage;
+SimLink simLink;
+
+#include "../station.h"
+
+ClimateSensor &halSensor() {
+    return simSensor;
+}
+
+SensorBus &halSensorBus() {
+    return simSensorBus;
+}
+
+UploadTransport &halUploadTransport() {
+    return simTransport;
+}
+
+DatagramTransport &halDatagramTransport() {
+    return simTransport;
+}
+
+GatewayLink &halGatewayLink() {
+    return simLink;
+}
+
+// the nodes don't use it, so the gateway can have it to itself
+UploadTransport &halForwardTransport() {
+    return simTransport;
+}
+
+SpoolStorage &halSpoolStorage() {
+    return simStorage;
+}
+
+void halDisplayOn() {
+}
+
+void halUpdateDisplay() {
+    PhaseTimer timer(PHASE_DISPLAY);
+    sim->displayUpdates++;
+    halDelay(SIM_DISPLAY_UPDATE_MS);
+}
+
+uint32_t halDisplaySleep() {
+    return 0;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: sim [--days N] [--csv file] [--out file | --server host:port] [--rtc file]\n"
+        "           [--interval s] [--max-interval s] [--batch n] [--batch-age s]\n"
+        "           [--filter none|median|ema] [--oversample n] [--spool dir] [--outage from:to]\n"
+        "           [--sleep-drift ppm] [--mqtt qos | --udp port | --nodes n [--link-loss pct]]\n"
+        "           [--sensors 45,76] [--verbose]\n");
+    exit(2);
+}
+
+static void loadRtc(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) {
+        return;
+    }
+    sim->rtcValid[0] = fread(sim->rtc[0], 1, sizeof sim->rtc[0], file) == sizeof sim->rtc[0];
+    fclose(file);
+}
+
+static void saveRtc(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if(file == NULL || fwrite(sim->rtc[0], 1, sizeof sim->rtc[0], file) != sizeof sim->rtc[0]) {
+        fprintf(stderr, "Can't write %s\n", path);
+    }
+    if(file != NULL) {
+        fclose(file);
+    }
+}
+
+// The charge is the station's own estimate, see energy.h, so this also checks its instrumentation.
+// With nodes, the wakes and the charge are those of an average node.
+static void report(double days, uint8_t nodes, bool viaGateway) {
+    STATE last;
+    memcpy(&last, sim->rtc[0], sizeof last);
+    EnergyAccount energy = {};
+    unsigned dropped = 0;
+    for(uint8_t node = 0; node < nodes; node++) {
+        STATE each;
+        memcpy(&each, sim->rtc[node], sizeof each);
+        for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+            energy.phase_ms[phase] += each.energy.phase_ms[phase] / nodes;
+        }
+        dropped += each.samples.dropped;
+    }
+    double charge_mAh = energy.charge_mAh(settings.phaseCurrent_uA);
+    printf("simulated        %.1f days\n", days);
+    if(viaGateway) {
+        printf("nodes            %u, per node up to the display updates\n", (unsigned) nodes);
+    }
+    printf("wakes            %llu\n", (unsigned long long) (sim->wakes / nodes));
+    printf("awake            %.1f s\n", sim->awake_ms / 1000.0 / nodes);
+    printf("radio on         %.1f s\n", sim->radio_ms / 1000.0 / nodes);
+    printf("connects         %llu fast, %llu full\n", (unsigned long long) (sim->fastConnects / nodes), (unsigned long long) (sim->fullConnects / nodes));
+    if(sim->fastWakes > 0) {
+        printf("fast wakes       %.0f ms average\n", (double) sim->fastWake_ms / sim->fastWakes);
+    }
+    printf("display updates  %llu\n", (unsigned long long) (sim->displayUpdates / nodes));
+    for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+        printf("  %-14s %.1f s, %.3f mAh\n", energyPhaseName(phase), energy.phase_ms[phase] / 1000.0, energy.charge_mAh(phase, settings.phaseCurrent_uA));
+    }
+    printf("requests         %llu\n", (unsigned long long) sim->requests);
+    printf("samples reported %llu\n", (unsigned long long) sim->samplesAccepted);
+    printf("bytes sent       %llu", (unsigned long long) sim->bytesSent);
+    if(sim->samplesAccepted > 0) {
+        printf(", %.1f per sample", (double) sim->bytesSent / sim->samplesAccepted);
+    }
+    printf("\n");
+    if(viaGateway) {
+        printf("frames           %llu sent, %llu lost\n", (unsigned long long) sim->framesSent, (unsigned long long) sim->framesLost);
+        unsigned long duplicates = 0;
+        for(uint8_t i = 0; i < GATEWAY_NODES; i++) {
+            duplicates += gateway.node(i).duplicates;
+        }
+        printf("gateway          %lu frames, %lu refused, %lu duplicate samples, %u queued\n",
+            gateway.framesReceived, gateway.framesRefused, duplicates, (unsigned) gateway.queue.size());
+    }
+    printf("samples dropped  %u\n", dropped);
+    printf("spool pending    %u bytes\n", (unsigned) (last.spool.end - last.spool.offset));
+    if(last.clock.valid) {
+        // what a sample taken now would be stamped with
+        long error = (long) last.clock.unixTime(last.clock_s) - (long) (sim->epoch_s + sim->now_ms / 1000);
+        printf("clock            %ld s off, drift %ld ppm\n", error, (long) last.clock.drift_ppm);
+    }
+    printf("charge           %.2f mAh, %.1f uA average\n", charge_mAh, charge_mAh * 1000 / (days * 24));
+    if(sim->samplesAccepted > 0) {
+        printf("per sample       %.2f uAh\n", charge_mAh * 1000 * nodes / sim->samplesAccepted);
+    }
+}
+
+// what the gateway stamps with, the runner's clock since the start of the run
+static uint32_t gatewayClock() {
+    return sim->now_ms / 1000;
+}
+
+// Waits for the wake to end. A gateway answers the frames of the node in the meantime, but only
+// forwards after, as the clock is the node's while it's awake.
+static bool waitForWake(pid_t pid, bool viaGateway) {
+    int status;
+    pid_t done;
+    while((done = waitpid(pid, &status, viaGateway ? WNOHANG : 0)) == 0) {
+        simLink.wait(1);
+        gateway.receive(gatewayClock());
+    }
+    return done == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv) {
+    double days = 365;
+    const char *csv = NULL;
+    const char *out = "-";
+    const char *server = NULL;
+    const char *rtc = NULL;
+    const char *spool = NULL;
+    double outageFrom = 0, outageTo = 0;
+    int32_t sleepDrift_ppm = 20000;
+    int nodes = 1;
+    bool viaGateway = false;
+
+    defaultSettings(settings);
+    settings.influxEnabled = true;
+    strncpy(settings.influxHost, "localhost", sizeof settings.influxHost - 1);
+    strncpy(settings.influxDatabase, "sim", sizeof settings.influxDatabase - 1);
+    strncpy(settings.mqttHost, "localhost", sizeof settings.mqttHost - 1);
+
+    for(int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if(strcmp(arg, "--verbose") == 0) {
+            simVerbose = true;
+            continue;
+        }
+        if(i + 1 >= argc) {
+            usage();
+        }
+        const char *value = argv[++i];
+        if(strcmp(arg, "--days") == 0) {
+            days = atof(value);
+        } else if(strcmp(arg, "--csv") == 0) {
+            csv = value;
+        } else if(strcmp(arg, "--out") == 0) {
+            out = value;
+        } else if(strcmp(arg, "--server") == 0) {
+            server = value;
+        } else if(strcmp(arg, "--spool") == 0) {
+            spool = value;
+        } else if(strcmp(arg, "--sleep-drift") == 0) {
+            sleepDrift_ppm = atoi(value);
+        } else if(strcmp(arg, "--outage") == 0) {
+            if(sscanf(value, "%lf:%lf", &outageFrom, &outageTo) != 2) {
+                usage();
+            }
+        } else if(strcmp(arg, "--rtc") == 0) {
+            rtc = value;
+        } else if(strcmp(arg, "--interval") == 0) {
+            settings.deepSleepTimer = atoi(value);
+        } else if(strcmp(arg, "--max-interval") == 0) {
+            settings.deepSleepMaxTimer = atoi(value);
+        } else if(strcmp(arg, "--batch") == 0) {
+            settings.batchSize = atoi(value);
+        } else if(strcmp(arg, "--batch-age") == 0) {
+            settings.batchMaxAge = atoi(value);
+        } else if(strcmp(arg, "--filter") == 0) {
+            settings.filterMode = strcmp(value, "median") == 0 ? FILTER_MEDIAN : strcmp(value, "ema") == 0 ? FILTER_EMA : FILTER_NONE;
+        } else if(strcmp(arg, "--oversample") == 0) {
+            settings.filterOversample = atoi(value);
+        } else if(strcmp(arg, "--mqtt") == 0) {
+            settings.uploadProtocol = UPLOAD_MQTT;
+            settings.mqttQos = atoi(value);
+            simTransport.setMqtt(true);
+        } else if(strcmp(arg, "--sensors") == 0) {
+            static char addresses[64];
+            strncpy(addresses, value, sizeof addresses - 1);
+            for(char *address = strtok(addresses, ","); address != NULL; address = strtok(NULL, ",")) {
+                if(!simSensorBus.add(address)) {
+                    usage();
+                }
+            }
+        } else if(strcmp(arg, "--udp") == 0) {
+            settings.uploadProtocol = UPLOAD_UDP;
+            settings.influxUdpPort = atoi(value);
+        } else if(strcmp(arg, "--nodes") == 0) {
+            settings.uploadProtocol = UPLOAD_GATEWAY;
+            nodes = atoi(value);
+            viaGateway = true;
+        } else if(strcmp(arg, "--link-loss") == 0) {
+            simLink.setLoss(atoi(value));
+        } else {
+            usage();
+        }
+    }
+    if(settings.batchSize == 0 || settings.batchSize > SAMPLE_BUFFER_SIZE || settings.filterOversample == 0 ||
+            nodes < 1 || nodes > SIM_NODES) {
+        usage();
+    }
+
+    sim = (SimShared*) mmap(NULL, sizeof(SimShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(sim == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    memset(sim, 0, sizeof(SimShared));
+    sim->epoch_s = 1700000000;
+    sim->sleepDrift_ppm = sleepDrift_ppm;
+    if(rtc != NULL) {
+        loadRtc(rtc);
+    }
+    if(csv != NULL && !simSensor.load(csv)) {
+        fprintf(stderr, "Can't read %s\n", csv);
+        return 1;
+    }
+    if(server != NULL) {
+        static char host[64];
+        strncpy(host, server, sizeof host - 1);
+        char *port = strrchr(host, ':');
+        if(port == NULL) {
+            usage();
+        }
+        *port = 0;
+        simTransport.toServer(host, port + 1);
+    } else if(!simTransport.toFile(out)) {
+        fprintf(stderr, "Can't open %s\n", out);
+        return 1;
+    }
+
+    simTransport.setOutage((uint64_t) (outageFrom * 86400000), (uint64_t) (outageTo * 86400000));
+    char spoolDir[] = "/tmp/sim-spool-XXXXXX";
+    if(spool == NULL) {
+        spool = mkdtemp(spoolDir);
+    }
+    simStorage.setRoot(spool);
+
+    // what setup() does on every boot, the wakes inherit it
+    setInfluxStatistics(state.aggregate, state.energy, settings.phaseCurrent_uA, sensorRegistry);
+    // the scan of the first cold boot, as cached in EEPROM
+    sensorRegistry.scan(simSensorBus, settings.sensorSlots);
+    updateUploadTarget();
+
+    // the gateway has been up for long, with the time from SNTP
+    ClockSync forwardClock;
+    forwardClock.clear();
+    if(viaGateway) {
+        settings.gatewayEnabled = true;
+        forwardClock.sync(0, sim->epoch_s);
+        simWifiConnected = true;
+        if(!simLink.listen()) {
+            perror("gateway link");
+            return 1;
+        }
+    }
+
+    // the nodes start spread over their first interval, the wakes of one are in turn
+    uint64_t nextWake_ms[SIM_NODES] = {};
+    for(int node = 0; node < nodes; node++) {
+        nextWake_ms[node] = (uint64_t) node * settings.deepSleepTimer * 1000 / nodes;
+    }
+    uint64_t end_ms = (uint64_t) (days * 86400000);
+    while(true) {
+        uint8_t node = 0;
+        for(int i = 1; i < nodes; i++) {
+            if(nextWake_ms[i] < nextWake_ms[node]) {
+                node = i;
+            }
+        }
+        if(nextWake_ms[node] >= end_ms) {
+            sim->now_ms = nextWake_ms[node];
+            break;
+        }
+        if(sim->now_ms < nextWake_ms[node]) {
+            sim->now_ms = nextWake_ms[node];
+        }
+        sim->node = node;
+        fflush(stdout);
+        pid_t pid = fork();
+        if(pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if(pid == 0) {
+            sim->wakes++;
+            sim->wakeStart_ms = sim->now_ms;
+            simWifiConnected = false;
+            settings.gatewayEnabled = false;
+            if(node > 0) {
+                simSensor.place(0.5f * node - 2, 10 + 2 * node);
+            }
+            halDelay(SIM_BOOT_MS);
+            // the node id is the wake's
+            setInfluxQueue(state.samples, state.spool, stationClock);
+            if(sim->rtcValid[node]) {
+                resumeFromDeepSleep();
+            } else {
+                coldBoot();
+            }
+            deepSleepWake();
+            // deep sleep exits the process
+            _exit(1);
+        }
+        if(!waitForWake(pid, viaGateway)) {
+            fprintf(stderr, "Wake %llu at %.3f s failed\n", (unsigned long long) sim->wakes, sim->now_ms / 1000.0);
+            return 1;
+        }
+        nextWake_ms[node] = sim->now_ms;
+        sim->now_ms = sim->wakeEnd_ms;
+        if(viaGateway) {
+            // the clock is the gateway's until the next wake
+            sim->wakeStart_ms = 0;
+            do {
+                serviceGateway(forwardClock, gatewayClock());
+                halYield();
+            } while(!gatewayForwarder.idle() && gatewayForwarder.state() != Uploader::BACKOFF);
+        }
+    }
+
+    if(rtc != NULL) {
+        saveRtc(rtc);
+    }
+    report(days, nodes, viaGateway);
+    if(spool == spoolDir) {
+        simStorage.remove("/spool.log");
+        simStorage.remove("/spool.tmp");
+        rmdir(spoolDir);
+    }
+    return 0;
+}
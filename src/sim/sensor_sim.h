@@ -0,0 +1,179 @@
+#ifndef __SENSOR_SIM__
+#define __SENSOR_SIM__
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include "../sensor.h"
+#include "../sensors.h"
+#include "hal_sim.h"
+
+struct SimReading {
+    uint32_t time_s;  // since the start of the run
+    float temperature_C;
+    float humidity_pct;
+};
+
+// Replays readings from a CSV of "seconds,temperature,humidity" lines, interpolating between
+// them. Without one, a daily cycle with some measurement noise stands in. Sensors in other
+// places differ by offset_C and have noise of their own.
+class SimSensor : public ClimateSensor {
+public:
+    SimSensor(float offset_C = 0, uint32_t noiseChannel = 1) : offset_C(offset_C), noiseChannel(noiseChannel) {
+    }
+
+    // moves the sensor elsewhere, e.g. to another node
+    void place(float offset_C, uint32_t noiseChannel) {
+        this->offset_C = offset_C;
+        this->noiseChannel = noiseChannel;
+    }
+
+    // Returns false if the file can't be read. Lines that don't parse, like a header, are skipped.
+    bool load(const char *path) {
+        FILE *file = fopen(path, "r");
+        if(file == NULL) {
+            return false;
+        }
+        char line[128];
+        while(fgets(line, sizeof line, file) != NULL) {
+            SimReading reading;
+            if(sscanf(line, "%u,%f,%f", &reading.time_s, &reading.temperature_C, &reading.humidity_pct) == 3) {
+                readings.push_back(reading);
+            }
+        }
+        fclose(file);
+        return true;
+    }
+
+    bool begin() {
+        return true;
+    }
+
+    bool configure(SensorMode /* mode */, SensorRepeatability /* repeatability */) {
+        return true;
+    }
+
+    bool read(float &temperature_C, float &humidity_pct) {
+        halDelay(SIM_SENSOR_READ_MS);
+        bool ok = interpolate(sim->now_ms / 1000.0, temperature_C, humidity_pct);
+        temperature_C += offset_C;
+        return ok;
+    }
+
+    bool setHeater(bool /* on */) {
+        return true;
+    }
+
+    void sleep() {
+    }
+
+    const char *lastError() {
+        return "none";
+    }
+
+    // uniform in [-1, 1], the same for the same time so runs are reproducible
+    static float noise(double t, uint32_t channel) {
+        uint32_t x = (uint32_t) (t * 1000) * 2654435761u ^ channel * 40503u;
+        x ^= x >> 15;
+        x *= 2246822519u;
+        x ^= x >> 13;
+        return (x & 0xFFFF) / 32767.5f - 1;
+    }
+
+private:
+    bool interpolate(double t, float &temperature_C, float &humidity_pct) {
+        if(readings.empty()) {
+            double day = 2 * M_PI * t / 86400;
+            temperature_C = 21 + 2 * sin(day) + 0.05f * noise(t, noiseChannel);
+            humidity_pct = 45 - 5 * sin(day) + 0.3f * noise(t, noiseChannel + 1);
+            return true;
+        }
+        // each wake is a new process, so there's no position to continue from
+        size_t i = std::upper_bound(readings.begin(), readings.end(), t, laterThan) - readings.begin();
+        if(i == 0 || i == readings.size()) {
+            const SimReading &held = readings[i == 0 ? 0 : i - 1];
+            temperature_C = held.temperature_C;
+            humidity_pct = held.humidity_pct;
+            return true;
+        }
+        const SimReading &a = readings[i - 1];
+        const SimReading &b = readings[i];
+        float f = (float) ((t - a.time_s) / (b.time_s - a.time_s));
+        temperature_C = a.temperature_C + f * (b.temperature_C - a.temperature_C);
+        humidity_pct = a.humidity_pct + f * (b.humidity_pct - a.humidity_pct);
+        return true;
+    }
+
+    static bool laterThan(double t, const SimReading &reading) {
+        return t < reading.time_s;
+    }
+
+    std::vector<SimReading> readings;
+    float offset_C;
+    uint32_t noiseChannel;
+};
+
+// A barometer with the weather going through over a few days
+class SimPressureSensor : public SensorDriver {
+public:
+    bool begin() {
+        return true;
+    }
+
+    bool measure(SensorReading &reading) {
+        halDelay(SIM_PRESSURE_READ_MS);
+        double t = sim->now_ms / 1000.0;
+        reading.temperature_C = 21 + 2 * sin(2 * M_PI * t / 86400) + 0.01f * SimSensor::noise(t, 3);
+        reading.humidity_pct = NAN;
+        reading.pressure_hPa = 1013 + 8 * sin(2 * M_PI * t / (3.5 * 86400)) + 0.05f * SimSensor::noise(t, 4);
+        return true;
+    }
+
+    void sleep() {
+    }
+
+    const char *lastError() {
+        return "none";
+    }
+};
+
+// The climate sensor is always there, the others only when added. Every address gets its own
+// driver, the SHT31 at 0x45 sits in a cooler place.
+class SimSensorBus : public SensorBus {
+public:
+    SimSensorBus(SimSensor &primary) : primary(primary) {
+    }
+
+    // address is hex like on the command line, returns false for one no sensor can have
+    bool add(const char *address) {
+        uint8_t value = (uint8_t) strtoul(address, NULL, 16);
+        for(const SensorProbe &probe : sensorProbes) {
+            if(probe.address == value) {
+                present.push_back(value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool probe(uint8_t address) {
+        return address == SENSOR_PRIMARY_ADDRESS || std::find(present.begin(), present.end(), address) != present.end();
+    }
+
+    SensorDriver *driver(uint8_t kind, uint8_t address) {
+        if(kind == SENSOR_KIND_SHT31) {
+            return address == SENSOR_PRIMARY_ADDRESS ? (SensorDriver *) &primary : &second;
+        }
+        return kind == SENSOR_KIND_BMP280 ? &barometer[address & 1] : NULL;
+    }
+
+private:
+    SimSensor &primary;
+    SimSensor second = SimSensor(-1.5f, 5);
+    SimPressureSensor barometer[2];
+    std::vector<uint8_t> present;
+};
+
+#endif
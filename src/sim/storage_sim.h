@@ -0,0 +1,61 @@
+#ifndef __STORAGE_SIM__
+#define __STORAGE_SIM__
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../spool.h"
+
+// The spool's files as plain files below a directory of the host
+class SimStorage : public SpoolStorage {
+public:
+    void setRoot(const char *root) {
+        this->root = root;
+    }
+
+    uint32_t size(const char *path) {
+        struct stat st;
+        return stat(full(path), &st) == 0 ? (uint32_t) st.st_size : 0;
+    }
+
+    bool append(const char *path, const uint8_t *data, size_t length) {
+        FILE *file = fopen(full(path), "ab");
+        if(file == NULL) {
+            return false;
+        }
+        bool ok = fwrite(data, 1, length, file) == length;
+        return fclose(file) == 0 && ok;
+    }
+
+    size_t read(const char *path, uint32_t offset, uint8_t *data, size_t length) {
+        FILE *file = fopen(full(path), "rb");
+        if(file == NULL) {
+            return 0;
+        }
+        size_t n = fseek(file, offset, SEEK_SET) == 0 ? fread(data, 1, length, file) : 0;
+        fclose(file);
+        return n;
+    }
+
+    bool remove(const char *path) {
+        return unlink(full(path)) == 0;
+    }
+
+    bool rename(const char *from, const char *to) {
+        char target[sizeof name];
+        strcpy(target, full(to));
+        return ::rename(full(from), target) == 0;
+    }
+
+private:
+    const char *full(const char *path) {
+        snprintf(name, sizeof name, "%s%s", root, path);
+        return name;
+    }
+
+    const char *root = ".";
+    char name[256];
+};
+
+#endif
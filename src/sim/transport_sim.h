@@ -0,0 +1,361 @@
+#ifndef __TRANSPORT_SIM__
+#define __TRANSPORT_SIM__
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "../uploader.h"
+#include "../mqtt.h"
+#include "../udp.h"
+#include "hal_sim.h"
+
+// Sends the uploads either to a file, answering every request itself, or to a server on a local
+// socket. Counts the lines of every request and the ones a 2xx accepted. In MQTT mode it stands
+// in for the broker instead, acknowledging the connection, QoS 1 publishes and pings, and counts
+// a sample per publish. Datagrams go the same way, every line in one counts as accepted unless
+// it was sent during an outage, when it's lost without the station knowing.
+class SimTransport : public UploadTransport, public DatagramTransport {
+public:
+    void setMqtt(bool mqtt) {
+        this->mqtt = mqtt;
+    }
+
+    // appends the requests to path, "-" for none
+    bool toFile(const char *path) {
+        fd = strcmp(path, "-") == 0 ? -1 : open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        socketMode = false;
+        return strcmp(path, "-") == 0 || fd >= 0;
+    }
+
+    void toServer(const char *host, const char *port) {
+        serverHost = host;
+        serverPort = port;
+        socketMode = true;
+    }
+
+    // the server can't be reached in between, in simulated time
+    void setOutage(uint64_t from_ms, uint64_t to_ms) {
+        outageFrom_ms = from_ms;
+        outageTo_ms = to_ms;
+    }
+
+    bool connect(const char * /* host */, uint16_t /* port */) {
+        stop();
+        halDelay(SIM_RTT_MS);
+        if(sim->now_ms >= outageFrom_ms && sim->now_ms < outageTo_ms) {
+            return false;
+        }
+        if(socketMode) {
+            struct addrinfo hints = {}, *address;
+            hints.ai_socktype = SOCK_STREAM;
+            if(getaddrinfo(serverHost, serverPort, &hints, &address) != 0) {
+                return false;
+            }
+            sock = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if(sock >= 0 && ::connect(sock, address->ai_addr, address->ai_addrlen) != 0) {
+                close(sock);
+                sock = -1;
+            }
+            freeaddrinfo(address);
+            if(sock < 0) {
+                return false;
+            }
+        }
+        open_ = true;
+        request = HEADER;
+        headerLength = 0;
+        incoming.state = PACKET_TYPE;
+        outgoing.state = PACKET_TYPE;
+        return true;
+    }
+
+    bool connected() {
+        if(socketMode && sock >= 0) {
+            char c;
+            if(recv(sock, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 0) {
+                stop();
+            }
+        }
+        return open_;
+    }
+
+    size_t write(const uint8_t *data, size_t length) {
+        if(!open_) {
+            return 0;
+        }
+        if(socketMode) {
+            ssize_t n = ::send(sock, data, length, MSG_NOSIGNAL);
+            if(n <= 0) {
+                return 0;
+            }
+            length = n;
+        } else if(fd >= 0 && ::write(fd, data, length) != (ssize_t) length) {
+            return 0;
+        }
+        sim->bytesSent += length;
+        for(size_t i = 0; i < length; i++) {
+            if(mqtt) {
+                parsePacket(incoming, data[i]);
+            } else {
+                parseRequest(data[i]);
+            }
+        }
+        return length;
+    }
+
+    int available() {
+        if(socketMode) {
+            // real time passes for a real server, let it answer
+            struct pollfd p = { sock, POLLIN, 0 };
+            int n = 0;
+            if(sock >= 0 && poll(&p, 1, 1) > 0) {
+                ioctl(sock, FIONREAD, &n);
+            }
+            return n;
+        }
+        return sim->now_ms >= responseAt_ms ? responseLength - responseRead : 0;
+    }
+
+    int read() {
+        int c = -1;
+        if(socketMode) {
+            unsigned char b;
+            if(sock >= 0 && recv(sock, &b, 1, MSG_DONTWAIT) == 1) {
+                c = b;
+            }
+        } else if(available() > 0) {
+            c = response[responseRead++];
+        }
+        if(c >= 0 && mqtt) {
+            parsePacket(outgoing, c);
+        } else if(c >= 0) {
+            parseStatus(c);
+        }
+        return c;
+    }
+
+    bool send(const char * /* host */, uint16_t /* port */, const uint8_t *data, size_t length) {
+        halDelay(SIM_DATAGRAM_MS);
+        if(socketMode) {
+            struct addrinfo hints = {}, *address;
+            hints.ai_socktype = SOCK_DGRAM;
+            if(getaddrinfo(serverHost, serverPort, &hints, &address) != 0) {
+                return false;
+            }
+            int udp = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            bool sent = udp >= 0 && sendto(udp, data, length, 0, address->ai_addr, address->ai_addrlen) == (ssize_t) length;
+            if(udp >= 0) {
+                close(udp);
+            }
+            freeaddrinfo(address);
+            if(!sent) {
+                return false;
+            }
+        } else if(fd >= 0 && ::write(fd, data, length) != (ssize_t) length) {
+            return false;
+        }
+        sim->requests++;
+        sim->bytesSent += length;
+        if(sim->now_ms >= outageFrom_ms && sim->now_ms < outageTo_ms) {
+            return true;
+        }
+        for(size_t i = 0; i < length; i++) {
+            if(data[i] == '\n' || i == length - 1) {
+                sim->samplesAccepted++;
+            }
+        }
+        return true;
+    }
+
+    void stop() {
+        if(sock >= 0) {
+            close(sock);
+            sock = -1;
+        }
+        open_ = false;
+        responseLength = responseRead = 0;
+    }
+
+private:
+    enum Request { HEADER, BODY };
+
+    void parseRequest(uint8_t c) {
+        if(request == HEADER) {
+            if(headerLength < sizeof header - 1) {
+                header[headerLength++] = c;
+                header[headerLength] = 0;
+            }
+            if(headerLength < 4 || strcmp(header + headerLength - 4, "\r\n\r\n") != 0) {
+                return;
+            }
+            const char *length = strcasestr(header, "Content-Length:");
+            bodyRemaining = length != NULL ? strtoul(length + 15, NULL, 10) : 0;
+            headerLength = 0;
+            lines = 0;
+            last = '\n';
+            request = BODY;
+            if(bodyRemaining > 0) {
+                return;
+            }
+        } else {
+            if(c == '\n') {
+                lines++;
+            }
+            last = c;
+            if(--bodyRemaining > 0) {
+                return;
+            }
+        }
+        // request complete
+        if(last != '\n') {
+            lines++;
+        }
+        sim->requests++;
+        pendingLines = lines;
+        statusLength = 0;
+        statusDone = false;
+        request = HEADER;
+        static const char reply[] = "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n";
+        respond((const uint8_t *) reply, sizeof reply - 1);
+    }
+
+    void respond(const uint8_t *data, size_t length) {
+        if(socketMode) {
+            return;
+        }
+        if(responseRead == responseLength) {
+            responseLength = responseRead = 0;
+        }
+        if(responseLength + length <= sizeof response) {
+            memcpy(response + responseLength, data, length);
+            responseLength += length;
+        }
+        responseAt_ms = sim->now_ms + SIM_RTT_MS;
+    }
+
+    enum PacketState { PACKET_TYPE, PACKET_LENGTH, PACKET_BODY };
+
+    // the framing of an MQTT packet, the start of its body is kept
+    struct Packet {
+        PacketState state;
+        uint8_t type;
+        uint32_t length;
+        uint32_t read;
+        uint8_t shift;
+        uint8_t body[64];
+    };
+
+    void parsePacket(Packet &packet, uint8_t c) {
+        switch(packet.state) {
+        case PACKET_TYPE:
+            packet.type = c;
+            packet.length = packet.read = packet.shift = 0;
+            packet.state = PACKET_LENGTH;
+            return;
+        case PACKET_LENGTH:
+            packet.length |= (uint32_t) (c & 0x7F) << packet.shift;
+            packet.shift += 7;
+            if(c & 0x80) {
+                return;
+            }
+            packet.state = PACKET_BODY;
+            if(packet.length > 0) {
+                return;
+            }
+            break;
+        case PACKET_BODY:
+            if(packet.read < sizeof packet.body) {
+                packet.body[packet.read] = c;
+            }
+            if(++packet.read < packet.length) {
+                return;
+            }
+            break;
+        }
+        packet.state = PACKET_TYPE;
+        if(&packet == &incoming) {
+            brokerReceived(packet);
+        } else if((packet.type & 0xF0) == MQTT_PUBACK) {
+            sim->samplesAccepted++;
+        }
+    }
+
+    // what the broker does with a packet of the station
+    void brokerReceived(const Packet &packet) {
+        uint8_t type = packet.type & 0xF0;
+        if(type == MQTT_CONNECT) {
+            const uint8_t connack[] = { MQTT_CONNACK, 2, 0, 0 };
+            respond(connack, sizeof connack);
+        } else if(type == MQTT_PUBLISH) {
+            sim->requests++;
+            uint8_t qos = packet.type >> 1 & 3;
+            if(qos == 0) {
+                sim->samplesAccepted++;
+                return;
+            }
+            size_t at = 2 + (packet.body[0] << 8 | packet.body[1]);
+            if(at + 2 <= sizeof packet.body) {
+                const uint8_t puback[] = { MQTT_PUBACK, 2, packet.body[at], packet.body[at + 1] };
+                respond(puback, sizeof puback);
+            }
+        } else if(type == MQTT_PINGREQ) {
+            const uint8_t pingresp[] = { MQTT_PINGRESP, 0 };
+            respond(pingresp, sizeof pingresp);
+        }
+    }
+
+    void parseStatus(int c) {
+        if(statusDone) {
+            return;
+        }
+        if(c != '\n') {
+            if(statusLength < sizeof status - 1) {
+                status[statusLength++] = c;
+            }
+            return;
+        }
+        status[statusLength] = 0;
+        statusDone = true;
+        const char *code = strchr(status, ' ');
+        if(code != NULL && code[1] == '2') {
+            sim->samplesAccepted += pendingLines;
+        }
+        pendingLines = 0;
+    }
+
+    bool socketMode = false;
+    bool mqtt = false;
+    Packet incoming = {};
+    Packet outgoing = {};
+    const char *serverHost = "";
+    const char *serverPort = "";
+    int fd = -1;
+    int sock = -1;
+    bool open_ = false;
+    uint64_t outageFrom_ms = 0;
+    uint64_t outageTo_ms = 0;
+
+    Request request = HEADER;
+    char header[256];
+    size_t headerLength = 0;
+    unsigned long bodyRemaining = 0;
+    unsigned long lines = 0;
+    unsigned long pendingLines = 0;
+    uint8_t last = '\n';
+
+    char status[40];
+    size_t statusLength = 0;
+    bool statusDone = true;
+
+    uint8_t response[128];
+    int responseLength = 0;
+    int responseRead = 0;
+    uint64_t responseAt_ms = 0;
+};
+
+#endif
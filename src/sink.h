@@ -0,0 +1,14 @@
+#ifndef __SINK__
+#define __SINK__
+
+#include <stddef.h>
+
+// Where the fixed buffer writers (jsonstream.h, metrics.h) hand their output, e.g. the chunks of
+// an HTTP response
+class OutputSink {
+public:
+    virtual ~OutputSink() {}
+    virtual void write(const char *data, size_t length) = 0;
+};
+
+#endif
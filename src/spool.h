@@ -0,0 +1,223 @@
+#ifndef __SPOOL__
+#define __SPOOL__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "samples.h"
+#include "crc.h"
+#include "clock.h"
+
+// Append-only log on flash for samples that couldn't be uploaded before the queue in RTC memory
+// overflowed. Records have a fixed size, so a torn write only costs the record it hit, and are
+// written a whole queue at a time since every append rewrites the file's last block.
+
+#define SPOOL_RECORD_SIZE 16
+#define SPOOL_MAX_BYTES 65536  // 4096 samples, the oldest are dropped beyond that
+#define SPOOL_COPY_CHUNK 256
+#define SPOOL_MAGIC 0x5A
+#define SPOOL_UNIX_TIME 0x01   // time_s is unix time rather than the station clock of boot
+
+// Files of the platform, LittleFS on the board
+class SpoolStorage {
+public:
+    virtual ~SpoolStorage() {}
+    // 0 if the file doesn't exist
+    virtual uint32_t size(const char *path) = 0;
+    virtual bool append(const char *path, const uint8_t *data, size_t length) = 0;
+    virtual size_t read(const char *path, uint32_t offset, uint8_t *data, size_t length) = 0;
+    virtual bool remove(const char *path) = 0;
+    // replaces to if it exists
+    virtual bool rename(const char *from, const char *to) = 0;
+};
+
+// Kept in RTC memory, so deep sleep wakes know whether there's anything to replay without
+// mounting the file system
+struct SpoolCursor {
+    uint32_t offset;  // bytes of the log that were uploaded
+    uint32_t end;     // size of the log
+    uint16_t boot;    // identifies the cold boot the station clock counts from
+    bool known;       // end was read from the file since the last cold boot
+
+    void clear(uint16_t boot) {
+        offset = 0;
+        end = 0;
+        this->boot = boot;
+        known = false;
+    }
+};
+
+class SampleSpool {
+public:
+    SampleSpool(SpoolStorage &storage, const char *path, const char *tempPath)
+        : storage(storage), path(path), tempPath(tempPath) {
+    }
+
+    // must be set before anything else is called
+    void setCursor(SpoolCursor &cursor) {
+        this->cursor = &cursor;
+    }
+
+    // Whether there are records left to upload, reads the size of the log once per cold boot
+    bool pending() {
+        refresh();
+        return cursor->offset < cursor->end;
+    }
+
+    uint32_t pendingBytes() const {
+        return cursor->end - cursor->offset;
+    }
+
+    // Appends all samples, with unix timestamps when the clock is valid. Drops the oldest
+    // records beyond SPOOL_MAX_BYTES.
+    bool append(const SampleBuffer &samples, const ClockSync &clock) {
+        refresh();
+        // with room for the padding below
+        uint32_t needed = (samples.size() + 1) * SPOOL_RECORD_SIZE;
+        if(cursor->end + needed > SPOOL_MAX_BYTES) {
+            uint32_t start = cursor->end + needed - SPOOL_MAX_BYTES;
+            start += (SPOOL_RECORD_SIZE - start % SPOOL_RECORD_SIZE) % SPOOL_RECORD_SIZE;
+            if(start > cursor->offset) {
+                recordsLost += (start - cursor->offset) / SPOOL_RECORD_SIZE;
+            }
+            compact(start > cursor->offset ? start : cursor->offset);
+        }
+
+        uint8_t data[SAMPLE_BUFFER_SIZE * SPOOL_RECORD_SIZE + SPOOL_RECORD_SIZE];
+        size_t length = 0;
+        if(cursor->end % SPOOL_RECORD_SIZE != 0) {
+            // after a torn write, keep the records aligned with an invalid one
+            length = SPOOL_RECORD_SIZE - cursor->end % SPOOL_RECORD_SIZE;
+            memset(data, 0xFF, length);
+        }
+        for(uint8_t i = 0; i < samples.size(); i++) {
+            encode(samples.at(i), clock, data + length);
+            length += SPOOL_RECORD_SIZE;
+        }
+        bool ok = storage.append(path, data, length);
+        // a failed append may still have written part of the data
+        cursor->end = storage.size(path);
+        if(ok) {
+            recordsSpooled += samples.size();
+        }
+        return ok;
+    }
+
+    // Fills queue with the records after the cursor, with unix timestamps. The clock must be
+    // valid. Records without unix time from before the last cold boot can't be placed in time
+    // and are dropped. Returns the bytes read, for consumed() once the queue was uploaded.
+    uint32_t load(SampleBuffer &queue, const ClockSync &clock) {
+        refresh();
+        uint8_t data[SAMPLE_BUFFER_SIZE * SPOOL_RECORD_SIZE];
+        uint32_t available = cursor->end - cursor->offset;
+        size_t length = (SAMPLE_BUFFER_SIZE - queue.size()) * SPOOL_RECORD_SIZE;
+        if(length > available) {
+            length = available;
+        }
+        length = storage.read(path, cursor->offset, data, length);
+        length -= length % SPOOL_RECORD_SIZE;
+        for(size_t i = 0; i + SPOOL_RECORD_SIZE <= length; i += SPOOL_RECORD_SIZE) {
+            Sample sample;
+            if(!decode(data + i, clock, sample)) {
+                continue;
+            }
+            queue.push(sample);
+        }
+        return length;
+    }
+
+    // The records load() returned were uploaded, removes the log once all of them were
+    void consumed(uint32_t bytes) {
+        cursor->offset += bytes;
+        recordsReplayed += bytes / SPOOL_RECORD_SIZE;
+        if(cursor->offset >= cursor->end) {
+            storage.remove(path);
+            cursor->offset = 0;
+            cursor->end = 0;
+        }
+    }
+
+    unsigned long recordsSpooled = 0;
+    unsigned long recordsReplayed = 0;
+    unsigned long recordsCorrupt = 0;
+    unsigned long recordsLost = 0;  // to the size limit or without a usable timestamp
+
+private:
+    void refresh() {
+        if(cursor->known) {
+            return;
+        }
+        cursor->end = storage.size(path);
+        cursor->offset = 0;
+        cursor->known = true;
+    }
+
+    void encode(const Sample &sample, const ClockSync &clock, uint8_t *record) {
+        uint32_t time_s = clock.valid ? clock.unixTime(sample.timestamp_s) : sample.timestamp_s;
+        record[0] = SPOOL_MAGIC;
+        record[1] = clock.valid ? SPOOL_UNIX_TIME : 0;
+        put16(record + 2, cursor->boot);
+        put16(record + 4, (uint16_t) time_s);
+        put16(record + 6, (uint16_t) (time_s >> 16));
+        put16(record + 8, (uint16_t) sample.temperature_cC);
+        put16(record + 10, sample.humidity_cpct);
+        put16(record + 12, 0);
+        put16(record + 14, crc16(record, SPOOL_RECORD_SIZE - 2));
+    }
+
+    bool decode(const uint8_t *record, const ClockSync &clock, Sample &sample) {
+        if(record[0] != SPOOL_MAGIC || get16(record + 14) != crc16(record, SPOOL_RECORD_SIZE - 2)) {
+            recordsCorrupt++;
+            return false;
+        }
+        uint32_t time_s = get16(record + 4) | (uint32_t) get16(record + 6) << 16;
+        if(record[1] & SPOOL_UNIX_TIME) {
+            sample.timestamp_s = time_s;
+        } else if(get16(record + 2) == cursor->boot) {
+            sample.timestamp_s = clock.unixTime(time_s);
+        } else {
+            recordsLost++;
+            return false;
+        }
+        sample.temperature_cC = (int16_t) get16(record + 8);
+        sample.humidity_cpct = get16(record + 10);
+        return true;
+    }
+
+    // Rewrites the log from start on, records before it are gone
+    void compact(uint32_t start) {
+        uint8_t chunk[SPOOL_COPY_CHUNK];
+        if(start >= cursor->end) {
+            storage.remove(path);
+            cursor->end = 0;
+            cursor->offset = 0;
+            return;
+        }
+        storage.remove(tempPath);
+        for(uint32_t at = start; at < cursor->end; at += SPOOL_COPY_CHUNK) {
+            size_t length = storage.read(path, at, chunk, SPOOL_COPY_CHUNK);
+            if(length == 0 || !storage.append(tempPath, chunk, length)) {
+                break;
+            }
+        }
+        storage.rename(tempPath, path);
+        cursor->end = storage.size(path);
+        cursor->offset = cursor->offset > start ? cursor->offset - start : 0;
+    }
+
+    static void put16(uint8_t *p, uint16_t value) {
+        p[0] = value & 0xFF;
+        p[1] = value >> 8;
+    }
+
+    static uint16_t get16(const uint8_t *p) {
+        return p[0] | (uint16_t) p[1] << 8;
+    }
+
+    SpoolStorage &storage;
+    const char *path;
+    const char *tempPath;
+    SpoolCursor *cursor = NULL;
+};
+
+#endif
@@ -0,0 +1,366 @@
+#ifndef __STATION__
+#define __STATION__
+
+#include <math.h>
+#include <time.h>
+#include "config.h"
+#include "hal.h"
+#include "samples.h"
+#include "schedule.h"
+#include "filter.h"
+#include "aggregate.h"
+#include "energy.h"
+#include "clock.h"
+#include "wificache.h"
+#include "sensors.h"
+#include "influx.h"
+
+// The station logic of a deep sleep wake cycle, on top of hal.h so it runs the same on the board
+// and in the simulator.
+
+// in hundredths of a degree / percent
+const uint16_t temperature_threshold = 20;
+const uint16_t humidity_threshold = 100;
+
+struct STATE {
+    float temperature_C;
+    float humidity_pct;
+    uint32_t clock_s; // seconds of station time accumulated over previous wake cycles
+    uint16_t clock_ms; // and the milliseconds on top
+    SampleBuffer samples;
+    WIFI_CACHE wifi;
+    TrendHistory trend;
+    ClimateFilter filter;
+    ClimateAggregate aggregate; // every reading since the last upload
+    uint32_t displayHash; // of what the display kept showing during deep sleep, see Screen
+    EnergyAccount energy;
+    SpoolCursor spool;
+    ClockSync clock;
+};
+
+static_assert(sizeof(STATE) <= 512, "STATE must fit in RTC user memory");
+
+// unix times before this mean SNTP hasn't synced yet
+const time_t MIN_VALID_TIME = 1500000000;
+
+// nothing reported yet, the first reading counts as changed
+STATE initialState() {
+    STATE initial = {};
+    initial.temperature_C = NAN;
+    initial.humidity_pct = NAN;
+    return initial;
+}
+
+STATE state = initialState();
+
+// the most recent successful sensor reading, whether it changed enough to be reported or not
+Sample lastReading;
+bool lastReadingValid = false;
+
+// the sensors besides halSensor(), in RAM only as the newest readings go out with the next upload
+SensorRegistry sensorRegistry;
+
+bool inLowPowerMode = false;
+bool connectingWifi = false;
+
+EnergyMeter energyMeter(state.energy);
+
+// When the steps of a deep sleep wake completed, in ms since it started, 0 for the ones it
+// skipped. Logged before going back to sleep to show the critical path.
+struct WakeTimeline {
+    unsigned long wifiBegun_ms;
+    unsigned long sensor_ms;
+    unsigned long display_ms;
+    unsigned long encoded_ms;
+    unsigned long connected_ms;
+    unsigned long uploaded_ms;
+};
+
+WakeTimeline wakeTimeline;
+
+// Attributes the time of its scope to phase, nested timers pause the outer ones
+class PhaseTimer {
+public:
+    PhaseTimer(uint8_t phase) {
+        previous = energyMeter.enter(phase, halMillis());
+    }
+
+    ~PhaseTimer() {
+        energyMeter.enter(previous, halMillis());
+    }
+
+private:
+    uint8_t previous;
+};
+
+// Monotonic seconds since the last cold boot, kept across deep sleep
+uint32_t stationClock() {
+    return state.clock_s + (state.clock_ms + halMillis()) / 1000;
+}
+
+// Takes the time from SNTP when a sync is due, see ClockSync. With wait set, gives SNTP a
+// moment to complete after connecting.
+void syncClock(bool wait) {
+    if(!halWifiConnected() || !state.clock.due(stationClock(), settings.clockSyncWakes)) {
+        return;
+    }
+    unsigned long start = halMillis();
+    time_t now = halTime();
+    while(wait && now < MIN_VALID_TIME && halMillis() - start < 2000) {
+        halDelay(50);
+        now = halTime();
+    }
+    if(now < MIN_VALID_TIME) {
+        if(wait) {
+            halLog("No time from SNTP");
+        }
+        return;
+    }
+    bool known = state.clock.valid;
+    int32_t error = state.clock.sync(stationClock(), (uint32_t) now);
+    if(known) {
+        halLog("Clock synced, was off by %ld s, drift %ld ppm", (long) error, (long) state.clock.drift_ppm);
+    }
+}
+
+// Starts associating in the background, the time until connectWifi() counts as wifi
+void beginWifi() {
+    if(wakeTimeline.wifiBegun_ms == 0 && halWifiBegin(state.wifi, stationClock())) {
+        wakeTimeline.wifiBegun_ms = halMillis();
+        energyMeter.background(PHASE_WIFI, halMillis());
+    }
+}
+
+void connectWifi() {
+    PhaseTimer timer(PHASE_WIFI);
+    unsigned long start = halMillis();
+    unsigned long begun = wakeTimeline.wifiBegun_ms > 0 ? wakeTimeline.wifiBegun_ms : start;
+    bool fast = halWifiConnect(state.wifi, stationClock());
+    energyMeter.background(ENERGY_PHASES, halMillis());
+    wakeTimeline.connected_ms = halMillis();
+    halLog("%s wifi connect took %lu ms, %lu of them waiting", fast ? "Fast" : "Full", halMillis() - begun, halMillis() - start);
+}
+
+// Brings up the link to the gateway or the nodes. They're on the channel of the access point the
+// gateway is connected to, which is what the nodes were connected to last as well.
+bool beginLink() {
+    return halGatewayLink().begin(state.wifi.channel);
+}
+
+// the radio isn't needed for the rest of the wake
+void wifiOff() {
+    halGatewayLink().end();
+    halWifiOff();
+    energyMeter.background(ENERGY_PHASES, halMillis());
+}
+
+FilterParams filterParams() {
+    FilterParams params = { settings.filterMode, settings.filterWindow, settings.filterEmaShift, settings.filterHysteresis };
+    return params;
+}
+
+// Averages oversample readings, filters them and returns whether the result changed enough to be reported
+bool readClimate(uint8_t oversample) {
+    PhaseTimer timer(PHASE_SENSOR);
+    ClimateSensor &sensor = halSensor();
+    float temperature_C = 0, humidity_pct = 0;
+    uint8_t readings = 0;
+    for(uint8_t i = 0; i < oversample; i++) {
+        float t, rh;
+        if(sensor.read(t, rh)) {
+            temperature_C += t;
+            humidity_pct += rh;
+            readings++;
+        }
+    }
+    if(readings == 0) {
+        halLog("[SHT3XD] Read error %s", sensor.lastError());
+        return false;
+    }
+    Sample raw = makeSample(stationClock(), temperature_C / readings, humidity_pct / readings);
+    if(settings.influxEnabled) {
+        state.aggregate.add(raw);
+    }
+
+    FilterParams params = filterParams();
+    lastReading = raw;
+    lastReading.temperature_cC = state.filter.temperature.apply(raw.temperature_cC, params);
+    lastReading.humidity_cpct = state.filter.humidity.apply(raw.humidity_cpct, params);
+    lastReadingValid = true;
+    halLog("read %.2f and %.2f, filtered %.2f and %.2f. Previous readings were %.2f and %.2f",
+        sampleTemperature(raw), sampleHumidity(raw), sampleTemperature(lastReading), sampleHumidity(lastReading),
+        state.temperature_C, state.humidity_pct);
+
+    bool changed = isnan(state.temperature_C) || isnan(state.humidity_pct);
+    if(!changed) {
+        Sample reported = makeSample(0, state.temperature_C, state.humidity_pct);
+        // check both so each channel keeps track of the direction of its last change
+        bool temperatureChanged = state.filter.temperature.changed(lastReading.temperature_cC, reported.temperature_cC, temperature_threshold, params);
+        bool humidityChanged = state.filter.humidity.changed(lastReading.humidity_cpct, reported.humidity_cpct, humidity_threshold, params);
+        changed = temperatureChanged || humidityChanged;
+    }
+    if(changed) {
+        state.temperature_C = sampleTemperature(lastReading);
+        state.humidity_pct = sampleHumidity(lastReading);
+    }
+    return changed;
+}
+
+// Reads the other sensors, only their newest readings are sent so only before an upload
+void measureSensors() {
+    PhaseTimer timer(PHASE_SENSOR);
+    uint8_t measured = sensorRegistry.measure(stationClock());
+    if(measured < sensorRegistry.size()) {
+        halLog("%u of %u sensors failed", (unsigned) (sensorRegistry.size() - measured), (unsigned) sensorRegistry.size());
+    }
+}
+
+void queueSample() {
+    if(settings.influxEnabled) {
+        spoolInflux(state.clock);
+        uint16_t dropped = state.samples.dropped;
+        state.samples.push(makeSample(stationClock(), state.temperature_C, state.humidity_pct));
+        // once when it happens, the count stays for the metrics
+        if(state.samples.dropped != dropped) {
+            halLog("Lost the oldest sample to buffer overflow, %u since cold boot", (unsigned) state.samples.dropped);
+        }
+    }
+}
+
+void sendUpdate() {
+    PhaseTimer timer(PHASE_UPLOAD);
+    syncClock(true);
+    syncInflux(state.clock);
+    wakeTimeline.uploaded_ms = halMillis();
+}
+
+// Hands the queue to the gateway, which takes a frame and its ack instead of associating and a
+// round trip to the server. The samples stay queued when there's no ack.
+void sendToGateway() {
+    {
+        PhaseTimer timer(PHASE_WIFI);
+        if(!beginLink()) {
+            halLog("Link to the gateway failed");
+            return;
+        }
+    }
+    wakeTimeline.connected_ms = halMillis();
+    PhaseTimer timer(PHASE_UPLOAD);
+    if(!syncInflux(state.clock)) {
+        halLog("No ack from the gateway, %u samples stay queued", (unsigned) state.samples.size());
+    }
+    wakeTimeline.uploaded_ms = halMillis();
+}
+
+// After a power cycle, RTC memory holds garbage. Looks for the sensors on the bus, which may
+// have changed while the power was off. Returns whether that changed the settings, the caller
+// stores them.
+bool coldBoot() {
+    state.samples.clear();
+    state.aggregate.clear();
+    state.energy.clear();
+    state.spool.clear(halRandom());
+    state.clock.clear();
+    bool changed = sensorRegistry.scan(halSensorBus(), settings.sensorSlots);
+    halLog("Found %u more sensors", (unsigned) sensorRegistry.size());
+    return changed;
+}
+
+void resumeFromDeepSleep() {
+    halRtcRead(&state, sizeof(state));
+    sensorRegistry.load(halSensorBus(), settings.sensorSlots);
+}
+
+void enterDeepSleep() {
+    halSensor().sleep();
+    sensorRegistry.sleep();
+    ScheduleParams params = {
+        (uint16_t) settings.deepSleepTimer,
+        (uint16_t) settings.deepSleepMaxTimer,
+        temperature_threshold,
+        humidity_threshold
+    };
+    state.trend.interval_s = nextSleepInterval(state.trend, state.trend.interval_s, params);
+    uint32_t awake_ms = state.clock_ms + halMillis();
+    state.clock_s += awake_ms / 1000 + state.trend.interval_s;
+    state.clock_ms = awake_ms % 1000;
+    state.displayHash = halDisplaySleep();
+    energyMeter.sleep(halMillis(), state.trend.interval_s);
+    halRtcWrite(&state, sizeof(state));
+    halLog("Sleeping for %u seconds", (unsigned) state.trend.interval_s);
+    halDeepSleep(state.trend.interval_s);
+}
+
+void logWakeTimeline() {
+    halLog("Wake timeline: wifi begun %lu, sensor %lu, display %lu, encoded %lu, connected %lu, uploaded %lu, sleep %lu ms",
+        wakeTimeline.wifiBegun_ms, wakeTimeline.sensor_ms, wakeTimeline.display_ms, wakeTimeline.encoded_ms,
+        wakeTimeline.connected_ms, wakeTimeline.uploaded_ms, halMillis());
+}
+
+// A wake from deep sleep that wasn't through the button: read, upload when due and sleep again.
+// Associating takes longest, so it starts as soon as the upload is known to be due and the
+// reading, display and encoding happen while it's under way. Most uploads are due by the age
+// of the oldest sample, which is known before the reading. Guessing that the reading fills the
+// batch instead would bring up the radio for nothing on most wakes, as most readings don't
+// change enough to be queued. A node of a gateway has no association to overlap, its link is
+// up in milliseconds once the reading is queued.
+void deepSleepWake() {
+    halLog("Waking up from deep sleep!");
+    if(state.clock.wakes < UINT16_MAX) {
+        state.clock.wakes++;
+    }
+    bool viaGateway = settings.uploadProtocol == UPLOAD_GATEWAY;
+    if(settings.influxEnabled && !viaGateway && uploadDue(state.samples, stationClock(), settings.batchSize, settings.batchMaxAge)) {
+        beginWifi();
+    }
+    // since we have no readings we're assuming they're always the same anyway
+    bool changed = readClimate(settings.filterOversample);
+    if(changed) {
+        queueSample();
+    }
+    if(lastReadingValid) {
+        state.trend.record(lastReading);
+    }
+    wakeTimeline.sensor_ms = halMillis();
+    if(viaGateway && uploadDue(state.samples, stationClock(), settings.batchSize, settings.batchMaxAge)) {
+        // over before a frame on the display would be
+        sendToGateway();
+    }
+    // only bring up wifi once enough samples were collected, associating is what costs the most energy
+    if(!viaGateway && uploadDue(state.samples, stationClock(), settings.batchSize, settings.batchMaxAge)) {
+        beginWifi();
+        measureSensors();
+        // a single frame while connecting and uploading, then back to the low power screen
+        inLowPowerMode = false;
+        connectingWifi = true;
+        halDisplayOn();
+        halUpdateDisplay();
+        wakeTimeline.display_ms = halMillis();
+        if(!state.clock.due(stationClock(), settings.clockSyncWakes)) {
+            prepareInflux(state.clock);
+            wakeTimeline.encoded_ms = halMillis();
+        }
+        connectWifi();
+        connectingWifi = false;
+
+        sendUpdate();
+        // nothing else needs the network this wake, the display can update without it
+        wifiOff();
+
+        inLowPowerMode = true;
+        halUpdateDisplay();
+    } else {
+        // nothing to send after all
+        wifiOff();
+        if(changed) {
+            inLowPowerMode = true;
+            halDisplayOn();
+            halUpdateDisplay();
+            wakeTimeline.display_ms = halMillis();
+        }
+    }
+    logWakeTimeline();
+    enterDeepSleep();
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __STATUS__
+#define __STATUS__
+
+// The status lines the display shows, besides the IP address. scripts/subset_fonts.py reads this
+// table to keep their glyphs in the status font, so status text shown anywhere has to come from
+// here or the characters it needs go missing.
+
+enum StatusLine {
+    STATUS_LOW_POWER,
+    STATUS_CONNECTING,
+    STATUS_NOT_CONNECTED,
+    STATUS_LINES
+};
+
+const char *const statusLines[STATUS_LINES] = {
+    "Press button to connect",
+    "Connecting",
+    "Not connected",
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef __TASKS__
+#define __TASKS__
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Cooperative scheduling of what runs while powered. A task is a function that does a bounded
+// piece of work and returns. Each pass runs the most important task that is due, or hands the
+// time until the next one is due to the idle hook, which may sleep through it. Times are
+// microseconds of a clock that wraps at 32 bits like micros() on the board, so periods and
+// deadlines have to stay below half of that, about 35 minutes.
+
+#define SCHEDULER_TASKS 8
+#define SCHEDULER_NONE 0xFF
+// what the idle hook gets at most when no task is waiting for its time
+#define SCHEDULER_IDLE_MAX_US 100000
+
+typedef void (*TaskFunction)();
+
+struct TaskStats {
+    unsigned long runs;
+    unsigned long missed;  // runs that started later than the deadline after they were due
+    uint64_t busy_us;
+    uint32_t max_us;       // longest run since resetMax()
+    uint32_t maxLate_us;   // latest start since resetMax()
+};
+
+struct Task {
+    const char *name;
+    TaskFunction run;
+    uint32_t period_us;    // 0 for a task that only runs when woken
+    uint32_t deadline_us;  // how late after it was due it may start
+    uint8_t priority;      // higher goes first when several are due
+    bool pending;
+    uint32_t due_us;
+    TaskStats stats;
+};
+
+class Scheduler {
+public:
+    Scheduler(uint32_t (*clock_us)(), void (*idle)(uint32_t us)) : clock_us(clock_us), idle(idle) {
+    }
+
+    // Returns the id of the task, SCHEDULER_NONE when all SCHEDULER_TASKS are taken. A periodic
+    // task is first due right away.
+    uint8_t add(const char *name, TaskFunction run, uint32_t period_ms, uint8_t priority, uint32_t deadline_ms) {
+        if(count == SCHEDULER_TASKS) {
+            return SCHEDULER_NONE;
+        }
+        Task &task = tasks[count];
+        task = {};
+        task.name = name;
+        task.run = run;
+        task.priority = priority;
+        task.deadline_us = deadline_ms * 1000;
+        task.period_us = period_ms * 1000;
+        task.pending = task.period_us > 0;
+        task.due_us = clock_us();
+        return count++;
+    }
+
+    // From the next run on, 0 stops a task until it's woken
+    void setPeriod(uint8_t id, uint32_t period_ms) {
+        if(id >= count) {
+            return;
+        }
+        Task &task = tasks[id];
+        bool wasPeriodic = task.period_us > 0;
+        task.period_us = period_ms * 1000;
+        if(task.period_us > 0 && !task.pending) {
+            wake(id);
+        } else if(task.period_us == 0 && wasPeriodic) {
+            task.pending = false;
+        }
+    }
+
+    // Makes a task due now, a periodic one keeps its period from then on
+    void wake(uint8_t id) {
+        if(id >= count) {
+            return;
+        }
+        Task &task = tasks[id];
+        uint32_t now = clock_us();
+        if(!task.pending || (int32_t) (task.due_us - now) > 0) {
+            task.due_us = now;
+        }
+        task.pending = true;
+    }
+
+    // Runs one task, or idles when none is due
+    void runOnce() {
+        uint32_t now = clock_us();
+        Task *next = NULL;
+        uint32_t wait_us = SCHEDULER_IDLE_MAX_US;
+        for(uint8_t i = 0; i < count; i++) {
+            Task &task = tasks[i];
+            if(!task.pending) {
+                continue;
+            }
+            int32_t until = (int32_t) (task.due_us - now);
+            if(until > 0) {
+                if((uint32_t) until < wait_us) {
+                    wait_us = until;
+                }
+            } else if(next == NULL || task.priority > next->priority ||
+                    (task.priority == next->priority && (int32_t) (task.due_us - next->due_us) < 0)) {
+                next = &task;
+            }
+        }
+        if(next == NULL) {
+            idle(wait_us);
+            idle_us += clock_us() - now;
+            return;
+        }
+
+        TaskStats &stats = next->stats;
+        uint32_t late = now - next->due_us;
+        if(late > stats.maxLate_us) {
+            stats.maxLate_us = late;
+        }
+        if(late > next->deadline_us) {
+            stats.missed++;
+        }
+        // before running, so the task can wake itself; one that fell a period behind skips what
+        // it missed instead of catching up in a burst
+        if(next->period_us == 0) {
+            next->pending = false;
+        } else if(late < next->period_us) {
+            next->due_us += next->period_us;
+        } else {
+            next->due_us = now + next->period_us;
+        }
+        next->run();
+        uint32_t took = clock_us() - now;
+        stats.runs++;
+        stats.busy_us += took;
+        if(took > stats.max_us) {
+            stats.max_us = took;
+        }
+    }
+
+    uint8_t size() const {
+        return count;
+    }
+
+    const Task &task(uint8_t id) const {
+        return tasks[id];
+    }
+
+    void resetMax() {
+        for(uint8_t i = 0; i < count; i++) {
+            tasks[i].stats.max_us = 0;
+            tasks[i].stats.maxLate_us = 0;
+        }
+    }
+
+    uint64_t idle_us = 0;
+
+private:
+    uint32_t (*clock_us)();
+    void (*idle)(uint32_t us);
+    Task tasks[SCHEDULER_TASKS];
+    uint8_t count = 0;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef __UDP__
+#define __UDP__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "uploader.h"
+
+// Sends the samples to InfluxDB's UDP listener, fire and forget. There's no connection to set
+// up and no response to wait for, so the radio can go off as soon as the last datagram left.
+// Nothing tells whether a sample arrived: it leaves the queue once the network stack took it,
+// and a lost datagram is a lost sample. The database is the one the listener is configured for.
+
+// Ethernet MTU less the IP and UDP headers, so a datagram never gets fragmented
+#define UDP_DATAGRAM_MAX 1472
+
+// Single datagrams to a host. send() must not block.
+class DatagramTransport {
+public:
+    virtual ~DatagramTransport() {}
+    virtual bool send(const char *host, uint16_t port, const uint8_t *data, size_t length) = 0;
+};
+
+// Packs as many lines into each datagram as fit, one datagram per call to step()
+class UdpUploader : public Uploader {
+public:
+    UdpUploader(DatagramTransport &transport, char *buffer, size_t capacity)
+        : transport(transport), body(buffer, capacity < UDP_DATAGRAM_MAX ? capacity : UDP_DATAGRAM_MAX) {
+    }
+
+    // host and prefix must stay valid while the uploader is used
+    void setTarget(const char *host, uint16_t port, const char *prefix) {
+        this->host = host;
+        this->port = port;
+        this->prefix = prefix;
+        reset();
+    }
+
+    void step(uint32_t now_ms, const ClockSync &clock) override {
+        switch(current) {
+        case IDLE:
+            if(ready(clock) && encode(clock)) {
+                current = SEND;
+            }
+            break;
+        case SEND:
+            if(!transport.send(host, port, (const uint8_t *) body.c_str(), body.length())) {
+                lastResult = UPLOAD_ERROR_SEND_FAILED;
+                backOff(now_ms);
+                break;
+            }
+            datagramsSent++;
+            lastResult = 0;
+            accepted();
+            break;
+        case CONNECT:
+        case AWAIT_RESPONSE:
+            // not used without a connection
+            current = IDLE;
+            break;
+        case BACKOFF:
+            if(now_ms - failedAt_ms >= backoff_ms) {
+                current = IDLE;
+            }
+            break;
+        }
+    }
+
+    unsigned long datagramsSent = 0;
+
+private:
+    // Encodes as many of the oldest samples as fit a datagram, returns false if there was
+    // nothing to send
+    bool encode(const ClockSync &clock) {
+        bool timed = !live || clock.valid;
+        uint8_t count = 0;
+        body.reset();
+        for(uint8_t i = 0; i < queue->size(); i++) {
+            if(!encodeLine(body, prefix, i, clock, timed)) {
+                break;
+            }
+            count++;
+        }
+        if(count == 0) {
+            // a single line that doesn't fit never will, don't let it block the queue
+            queue->drop(1);
+            samplesRejected++;
+            return false;
+        }
+        inFlight = count;
+        droppedAtEncode = queue->dropped;
+        return true;
+    }
+
+    DatagramTransport &transport;
+    LineProtocolWriter body;
+    const char *host = "";
+    uint16_t port = 0;
+    const char *prefix = "";
+};
+
+#endif
@@ -0,0 +1,498 @@
+#ifndef __UPLOADER__
+#define __UPLOADER__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "samples.h"
+#include "lineprotocol.h"
+#include "aggregate.h"
+#include "energy.h"
+#include "clock.h"
+#include "sensors.h"
+
+// Error results, the same values ESP8266HTTPClient uses so /influx/lastResponse keeps its meaning
+#define UPLOAD_ERROR_CONNECTION_FAILED -1
+#define UPLOAD_ERROR_SEND_FAILED -2
+#define UPLOAD_ERROR_CONNECTION_LOST -5
+#define UPLOAD_ERROR_TOO_LARGE -8  // the request doesn't fit its buffer
+#define UPLOAD_ERROR_BAD_RESPONSE -7
+#define UPLOAD_ERROR_READ_TIMEOUT -11
+
+#define UPLOAD_RESPONSE_TIMEOUT_MS 5000
+#define UPLOAD_MIN_BACKOFF_MS 1000
+#define UPLOAD_MAX_BACKOFF_MS 300000
+#define UPLOAD_SEND_CHUNK 512
+
+// Byte stream to the server. connect() is the only call allowed to block (bounded by the
+// implementation's timeout), all others must return immediately. write() may take less than
+// length, and only waits, up to the same timeout, when the send buffer is already full.
+class UploadTransport {
+public:
+    virtual ~UploadTransport() {}
+    virtual bool connect(const char *host, uint16_t port) = 0;
+    virtual bool connected() = 0;
+    virtual size_t write(const uint8_t *data, size_t length) = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual void stop() = 0;
+};
+
+enum UploadProtocol {
+    UPLOAD_INFLUX,  // InfluxDB line protocol over HTTP, see InfluxUploader
+    UPLOAD_MQTT,    // line protocol messages to an MQTT broker, see MqttUploader in mqtt.h
+    UPLOAD_UDP,     // InfluxDB line protocol datagrams, see UdpUploader in udp.h
+    UPLOAD_GATEWAY  // binary frames to a gateway station, see GatewayUploader in gateway.h
+};
+
+inline const char *uploadProtocolName(uint8_t protocol) {
+    switch(protocol) {
+    case UPLOAD_MQTT:
+        return "mqtt";
+    case UPLOAD_UDP:
+        return "udp";
+    case UPLOAD_GATEWAY:
+        return "gateway";
+    default:
+        return "influx";
+    }
+}
+
+// Takes the samples of a queue to a server, one small step per call to step() so the caller's
+// loop stays responsive. Samples are only removed from the queue once the server accepted them;
+// failures are retried with exponential backoff. The queue itself drops its oldest samples when
+// it overflows in the meantime. The samples go out as line protocol, with the statistics and
+// energy fields on the newest one, except to a gateway.
+class Uploader {
+public:
+    enum State { IDLE, CONNECT, SEND, AWAIT_RESPONSE, BACKOFF };
+
+    virtual ~Uploader() {}
+
+    // The queue the samples are taken from, must be set before the first step() and only be
+    // changed while idle(). The live queue has samples timestamped with the station clock and
+    // gets the aggregate and energy fields. Others, replayed from the past, have unix timestamps.
+    void setQueue(SampleBuffer &queue, bool live = true) {
+        this->queue = &queue;
+        this->live = live;
+    }
+
+    // statistics of the readings since the last upload, sent as extra fields on the newest sample
+    void setAggregate(ClimateAggregate &aggregate) {
+        this->aggregate = &aggregate;
+    }
+
+    // cumulative charge estimates, sent as extra fields on the newest sample
+    void setEnergy(const EnergyAccount &account, const uint32_t *current_uA) {
+        energy = &account;
+        this->current_uA = current_uA;
+    }
+
+    // the other sensors on the bus, a line each with the newest sample
+    void setSensors(const SensorRegistry &registry) {
+        sensors = &registry;
+    }
+
+    // clock converts the station clock of the samples to unix time, see ready()
+    virtual void step(uint32_t now_ms, const ClockSync &clock) = 0;
+
+    // Whether there's anything step() can send. Without a valid clock the server stamps a line
+    // on arrival, which is only right for a sample that was just taken, so the live queue only
+    // goes out then while it holds a single sample. More wait for the clock to place them.
+    virtual bool ready(const ClockSync &clock) const {
+        return pending() && (!live || clock.valid || queue->size() == 1);
+    }
+
+    State state() const {
+        return current;
+    }
+
+    bool idle() const {
+        return current == IDLE;
+    }
+
+    uint32_t backoff() const {
+        return backoff_ms;
+    }
+
+    int lastResult = 0;
+    unsigned long uploadsSucceeded = 0;
+    unsigned long uploadsFailed = 0;
+    unsigned long samplesRejected = 0;  // samples the server refused for good
+    unsigned long connectionsOpened = 0;
+    unsigned long connectionsReused = 0;
+
+protected:
+    // whether there's anything to upload
+    virtual bool pending() const {
+        return !queue->empty();
+    }
+
+    // Appends the line of the sample at index i of the queue. Returns false, with nothing
+    // appended, when it didn't fit.
+    bool encodeLine(LineProtocolWriter &body, const char *prefix, uint8_t i, const ClockSync &clock, bool timed) {
+        const Sample &sample = queue->at(i);
+        body.beginLine(prefix);
+        body.field("temperature_C", sampleTemperature(sample), 1);
+        body.field("humidity", sampleHumidity(sample), 0);
+        bool newest = i == queue->size() - 1 && live;
+        bool withAggregate = newest && aggregate != NULL && aggregate->count > 0;
+        if(withAggregate) {
+            addAggregateFields(body, *aggregate);
+        }
+        if(newest && energy != NULL) {
+            addEnergyFields(body);
+        }
+        if(timed) {
+            body.timestamp(live ? clock.unixTime(sample.timestamp_s) : sample.timestamp_s);
+        }
+        if(!body.endLine()) {
+            return false;
+        }
+        if(withAggregate) {
+            // readings that come in while this is in flight start the next window
+            aggregateInFlight = *aggregate;
+            aggregate->clear();
+        }
+        if(newest && sensors != NULL) {
+            addSensorLines(body, prefix, clock, timed);
+        }
+        return true;
+    }
+
+    // Sensors whose lines don't fit anymore are left out of this upload, they're read again
+    void addSensorLines(LineProtocolWriter &body, const char *prefix, const ClockSync &clock, bool timed) {
+        char name[16];
+        for(uint8_t i = 0; i < sensors->size(); i++) {
+            const SensorChannel &channel = sensors->at(i);
+            if(!channel.valid) {
+                continue;
+            }
+            SensorRegistry::name(channel, name, sizeof name);
+            body.beginLine(prefix);
+            body.tag("sensor", name);
+            body.field("temperature_C", channel.reading.temperature_C, 2);
+            body.field("humidity", channel.reading.humidity_pct, 1);
+            body.field("pressure_hPa", channel.reading.pressure_hPa, 2);
+            if(timed) {
+                body.timestamp(clock.unixTime(channel.timestamp_s));
+            }
+            body.endLine();
+        }
+    }
+
+    void addAggregateFields(LineProtocolWriter &body, const ClimateAggregate &statistics) {
+        body.field("temperature_min", statistics.temperature.min / 100.0f, 2);
+        body.field("temperature_max", statistics.temperature.max / 100.0f, 2);
+        body.field("temperature_mean", statistics.temperature.mean(statistics.count), 2);
+        body.field("humidity_min", statistics.humidity.min / 100.0f, 2);
+        body.field("humidity_max", statistics.humidity.max / 100.0f, 2);
+        body.field("humidity_mean", statistics.humidity.mean(statistics.count), 2);
+        body.field("readings", (long) statistics.count);
+    }
+
+    void addEnergyFields(LineProtocolWriter &body) {
+        char name[24];
+        body.field("charge_mAh", energy->charge_mAh(current_uA), 3);
+        for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+            snprintf(name, sizeof name, "charge_%s_mAh", energyPhaseName(phase));
+            body.field(name, energy->charge_mAh(phase, current_uA), 3);
+        }
+    }
+
+    // puts the statistics of a failed upload back so they're part of the next one
+    void restoreAggregate() {
+        if(aggregate != NULL) {
+            aggregate->merge(aggregateInFlight);
+        }
+        aggregateInFlight.clear();
+    }
+
+    // samples that overflowed from the queue since encoding were part of the upload
+    virtual void removeInFlight() {
+        uint16_t overflowed = queue->dropped - droppedAtEncode;
+        if(inFlight > overflowed) {
+            queue->drop(inFlight - overflowed);
+        }
+    }
+
+    void accepted() {
+        uploadsSucceeded++;
+        removeInFlight();
+        aggregateInFlight.clear();
+        backoff_ms = 0;
+        current = IDLE;
+    }
+
+    // keepInFlight leaves the statistics with the failed upload, for one that's sent again as it was
+    void backOff(uint32_t now_ms, bool keepInFlight = false) {
+        uploadsFailed++;
+        if(!keepInFlight) {
+            restoreAggregate();
+        }
+        backoff_ms = backoff_ms == 0 ? UPLOAD_MIN_BACKOFF_MS : backoff_ms * 2;
+        if(backoff_ms > UPLOAD_MAX_BACKOFF_MS) {
+            backoff_ms = UPLOAD_MAX_BACKOFF_MS;
+        }
+        failedAt_ms = now_ms;
+        current = BACKOFF;
+    }
+
+    void reset() {
+        restoreAggregate();
+        current = IDLE;
+        backoff_ms = 0;
+    }
+
+    SampleBuffer *queue = NULL;
+    bool live = true;
+    ClimateAggregate *aggregate = NULL;
+    ClimateAggregate aggregateInFlight = {};
+    const EnergyAccount *energy = NULL;
+    const uint32_t *current_uA = NULL;
+    const SensorRegistry *sensors = NULL;
+
+    State current = IDLE;
+    uint8_t inFlight = 0;
+    uint16_t droppedAtEncode = 0;
+    uint32_t failedAt_ms = 0;
+    uint32_t backoff_ms = 0;
+};
+
+// Uploads to InfluxDB over HTTP/1.1 keep-alive, as many samples per request as fit the buffer
+class InfluxUploader : public Uploader {
+public:
+    InfluxUploader(UploadTransport &transport, char *buffer, size_t capacity)
+        : body(buffer, capacity), transport(transport) {
+    }
+
+    // host, url and prefix must stay valid while the uploader is used
+    void setTarget(const char *host, uint16_t port, const char *url, const char *prefix) {
+        this->host = host;
+        this->port = port;
+        this->url = url;
+        this->prefix = prefix;
+        transport.stop();
+        reset();
+    }
+
+    void step(uint32_t now_ms, const ClockSync &clock) override {
+        switch(current) {
+        case IDLE:
+            if(ready(clock) && encode(clock, now_ms)) {
+                current = CONNECT;
+            }
+            break;
+        case CONNECT:
+            reusedConnection = transport.connected();
+            if(reusedConnection) {
+                connectionsReused++;
+            } else {
+                connectionsOpened++;
+                if(!transport.connect(host, port)) {
+                    fail(UPLOAD_ERROR_CONNECTION_FAILED, now_ms);
+                    break;
+                }
+            }
+            sent = 0;
+            current = SEND;
+            break;
+        case SEND:
+            sendChunk(now_ms);
+            break;
+        case AWAIT_RESPONSE:
+            receive(now_ms);
+            break;
+        case BACKOFF:
+            if(now_ms - failedAt_ms >= backoff_ms) {
+                current = IDLE;
+            }
+            break;
+        }
+    }
+
+protected:
+    // Encodes as many of the oldest samples as fit into body, returns false if there was
+    // nothing to send
+    virtual bool encodeBody(const ClockSync &clock) {
+        bool timed = !live || clock.valid;
+        uint8_t count = 0;
+        body.reset();
+        for(uint8_t i = 0; i < queue->size(); i++) {
+            if(!encodeLine(body, prefix, i, clock, timed)) {
+                break;
+            }
+            count++;
+        }
+        if(count == 0) {
+            // a single line that doesn't fit never will, don't let it block the queue
+            queue->drop(1);
+            samplesRejected++;
+            return false;
+        }
+        inFlight = count;
+        droppedAtEncode = queue->dropped;
+        return true;
+    }
+
+    LineProtocolWriter body;
+    const char *prefix = "";
+
+private:
+    bool encode(const ClockSync &clock, uint32_t now_ms) {
+        if(!encodeBody(clock)) {
+            return false;
+        }
+        int length = snprintf(header, sizeof header,
+            "POST %s HTTP/1.1\r\nHost: %s:%u\r\nContent-Type: text/plain\r\nContent-Length: %u\r\nConnection: keep-alive\r\n\r\n",
+            url, host, port, (unsigned) body.length());
+        if(length < 0 || (size_t) length >= sizeof header) {
+            // a truncated header is a corrupt request, keep the samples for when the settings are fixed
+            lastResult = UPLOAD_ERROR_TOO_LARGE;
+            backOff(now_ms);
+            return false;
+        }
+        headerLength = length;
+        retried = false;
+        return true;
+    }
+
+    void sendChunk(uint32_t now_ms) {
+        size_t total = headerLength + body.length();
+        size_t n;
+        if(sent < headerLength) {
+            n = transport.write((const uint8_t*) header + sent, headerLength - sent);
+        } else {
+            size_t remaining = total - sent;
+            n = transport.write((const uint8_t*) body.c_str() + sent - headerLength, remaining < UPLOAD_SEND_CHUNK ? remaining : UPLOAD_SEND_CHUNK);
+        }
+        if(n == 0) {
+            fail(UPLOAD_ERROR_SEND_FAILED, now_ms);
+            return;
+        }
+        sent += n;
+        if(sent == total) {
+            requestSent_ms = now_ms;
+            parser = STATUS_LINE;
+            lineLength = 0;
+            status = 0;
+            contentLength = 0;
+            keepAlive = true;
+            current = AWAIT_RESPONSE;
+        }
+    }
+
+    void receive(uint32_t now_ms) {
+        while(transport.available() > 0) {
+            int c = transport.read();
+            if(c < 0) {
+                break;
+            }
+            if(parser == BODY) {
+                if(--contentLength == 0) {
+                    complete(now_ms);
+                    return;
+                }
+            } else if(c == '\n') {
+                line[lineLength] = 0;
+                if(!parseLine()) {
+                    fail(UPLOAD_ERROR_BAD_RESPONSE, now_ms);
+                    return;
+                }
+                lineLength = 0;
+                if(parser == DONE) {
+                    complete(now_ms);
+                    return;
+                }
+            } else if(c != '\r' && lineLength < sizeof line - 1) {
+                line[lineLength++] = c;
+            }
+        }
+        if(!transport.connected()) {
+            fail(UPLOAD_ERROR_CONNECTION_LOST, now_ms);
+        } else if(now_ms - requestSent_ms >= UPLOAD_RESPONSE_TIMEOUT_MS) {
+            fail(UPLOAD_ERROR_READ_TIMEOUT, now_ms);
+        }
+    }
+
+    bool parseLine() {
+        if(parser == STATUS_LINE) {
+            if(strncmp(line, "HTTP/1.", 7) != 0) {
+                return false;
+            }
+            const char *code = strchr(line, ' ');
+            status = code != NULL ? atoi(code + 1) : 0;
+            parser = HEADERS;
+            return status > 0;
+        }
+        if(lineLength == 0) {
+            parser = contentLength > 0 ? BODY : DONE;
+        } else if(strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = strtoul(line + 15, NULL, 10);
+        } else if(strncasecmp(line, "Connection:", 11) == 0 && strstr(line + 11, "close") != NULL) {
+            keepAlive = false;
+        } else if(strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+            // the body can't be skipped without decoding it, close the connection after the headers instead
+            keepAlive = false;
+        }
+        return true;
+    }
+
+    void complete(uint32_t now_ms) {
+        lastResult = status;
+        if(!keepAlive) {
+            transport.stop();
+        }
+        if(status >= 200 && status < 300) {
+            accepted();
+        } else if(status >= 400 && status < 500) {
+            // the server won't ever accept these, retrying would block the queue forever
+            uploadsFailed++;
+            samplesRejected += inFlight;
+            removeInFlight();
+            aggregateInFlight.clear();
+            current = IDLE;
+        } else {
+            fail(status, now_ms);
+        }
+    }
+
+    void fail(int result, uint32_t now_ms) {
+        lastResult = result;
+        transport.stop();
+        if(result < 0 && reusedConnection && !retried) {
+            // the server may have closed the idle connection, retry once on a new one
+            retried = true;
+            current = CONNECT;
+            return;
+        }
+        backOff(now_ms);
+    }
+
+    enum Parser { STATUS_LINE, HEADERS, BODY, DONE };
+
+    UploadTransport &transport;
+    const char *host = "";
+    uint16_t port = 0;
+    const char *url = "";
+
+    char header[256];
+    size_t headerLength = 0;
+    size_t sent = 0;
+    bool reusedConnection = false;
+    bool retried = false;
+
+    Parser parser = STATUS_LINE;
+    char line[64];
+    size_t lineLength = 0;
+    int status = 0;
+    unsigned long contentLength = 0;
+    bool keepAlive = true;
+
+    uint32_t requestSent_ms = 0;
+};
+
+#endif
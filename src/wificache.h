@@ -0,0 +1,27 @@
+#ifndef __WIFICACHE__
+#define __WIFICACHE__
+
+#include <stdint.h>
+
+#define FAST_CONNECT_TIMEOUT_MS 3000
+// DHCP is skipped on fast connects, so the lease is refreshed with a full connect every now and then
+#define WIFI_CACHE_MAX_AGE_S 3600
+
+// Details of the last access point and DHCP lease, kept in RTC memory so a deep sleep wake can
+// skip the channel scan and DHCP. Filled in and used by halWifiConnect().
+struct WIFI_CACHE {
+    bool valid;
+    uint8_t channel;
+    uint8_t bssid[6];
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t cachedAt_s;
+};
+
+inline bool wifiCacheUsable(const WIFI_CACHE &cache, uint32_t now_s) {
+    return cache.valid && now_s - cache.cachedAt_s <= WIFI_CACHE_MAX_AGE_S;
+}
+
+#endif
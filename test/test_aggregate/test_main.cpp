@@ -0,0 +1,175 @@
+#include <unity.h>
+#include <string.h>
+#include "../../src/aggregate.h"
+
+// ClimateAggregate, the statistics of the readings between two uploads: merging the window of a
+// failed upload back, keeping it in RTC memory and what happens when the count saturates
+
+ClimateAggregate aggregate;
+
+void setUp() {
+    aggregate.clear();
+}
+
+void tearDown() {
+}
+
+void addReadings(ClimateAggregate &target, const float *temperatures, uint8_t n) {
+    for(uint8_t i = 0; i < n; i++) {
+        target.add(makeSample(i, temperatures[i], 40 + i));
+    }
+}
+
+void test_add() {
+    const float temperatures[] = { 21.0f, 19.5f, 22.5f, 21.0f };
+    addReadings(aggregate, temperatures, 4);
+    TEST_ASSERT_EQUAL(4, aggregate.count);
+    TEST_ASSERT_EQUAL(1950, aggregate.temperature.min);
+    TEST_ASSERT_EQUAL(2250, aggregate.temperature.max);
+    TEST_ASSERT_EQUAL_FLOAT(21.0f, aggregate.temperature.mean(aggregate.count));
+    TEST_ASSERT_EQUAL(4000, aggregate.humidity.min);
+    TEST_ASSERT_EQUAL(4300, aggregate.humidity.max);
+    TEST_ASSERT_EQUAL_FLOAT(41.5f, aggregate.humidity.mean(aggregate.count));
+}
+
+void test_clear_starts_over() {
+    const float temperatures[] = { 30.0f, -5.0f };
+    addReadings(aggregate, temperatures, 2);
+    aggregate.clear();
+    const float next[] = { 20.0f };
+    addReadings(aggregate, next, 1);
+    TEST_ASSERT_EQUAL(1, aggregate.count);
+    TEST_ASSERT_EQUAL(2000, aggregate.temperature.min);
+    TEST_ASSERT_EQUAL(2000, aggregate.temperature.max);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, aggregate.temperature.mean(aggregate.count));
+}
+
+void test_merge_equals_adding_all() {
+    const float first[] = { 21.0f, 19.5f, 22.5f };
+    const float second[] = { 18.0f, 20.0f };
+    ClimateAggregate all;
+    all.clear();
+    addReadings(all, first, 3);
+    addReadings(all, second, 2);
+
+    ClimateAggregate other;
+    other.clear();
+    addReadings(aggregate, first, 3);
+    addReadings(other, second, 2);
+    aggregate.merge(other);
+    TEST_ASSERT_EQUAL(all.count, aggregate.count);
+    TEST_ASSERT_EQUAL(all.temperature.min, aggregate.temperature.min);
+    TEST_ASSERT_EQUAL(all.temperature.max, aggregate.temperature.max);
+    TEST_ASSERT_EQUAL(all.temperature.sum, aggregate.temperature.sum);
+    TEST_ASSERT_EQUAL(all.humidity.sum, aggregate.humidity.sum);
+}
+
+void test_merge_with_empty() {
+    const float temperatures[] = { 21.0f, 23.0f };
+    ClimateAggregate empty;
+    empty.clear();
+    addReadings(aggregate, temperatures, 2);
+    aggregate.merge(empty);
+    TEST_ASSERT_EQUAL(2, aggregate.count);
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, aggregate.temperature.mean(aggregate.count));
+
+    // into an empty one, whatever its stale fields say
+    ClimateAggregate target;
+    memset(&target, 0x5A, sizeof target);
+    target.clear();
+    target.merge(aggregate);
+    TEST_ASSERT_EQUAL(2, target.count);
+    TEST_ASSERT_EQUAL(2100, target.temperature.min);
+    TEST_ASSERT_EQUAL(2300, target.temperature.max);
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, target.temperature.mean(target.count));
+}
+
+void test_restore_failed_upload() {
+    // the window that went out, cleared as the uploader takes it
+    const float sent[] = { 21.0f, 21.5f, 22.0f };
+    addReadings(aggregate, sent, 3);
+    ClimateAggregate inFlight = aggregate;
+    aggregate.clear();
+    // readings while the request is under way
+    const float meanwhile[] = { 25.0f };
+    addReadings(aggregate, meanwhile, 1);
+    // the upload failed, the next one covers both
+    aggregate.merge(inFlight);
+    TEST_ASSERT_EQUAL(4, aggregate.count);
+    TEST_ASSERT_EQUAL(2100, aggregate.temperature.min);
+    TEST_ASSERT_EQUAL(2500, aggregate.temperature.max);
+    TEST_ASSERT_EQUAL_FLOAT(22.375f, aggregate.temperature.mean(aggregate.count));
+}
+
+void test_survives_rtc() {
+    const float temperatures[] = { -10.5f, 35.25f };
+    addReadings(aggregate, temperatures, 2);
+    uint8_t rtc[sizeof aggregate];
+    memcpy(rtc, &aggregate, sizeof rtc);
+    ClimateAggregate restored;
+    memcpy(&restored, rtc, sizeof restored);
+    TEST_ASSERT_EQUAL(2, restored.count);
+    TEST_ASSERT_EQUAL(-1050, restored.temperature.min);
+    TEST_ASSERT_EQUAL(3525, restored.temperature.max);
+    TEST_ASSERT_EQUAL_FLOAT(12.375f, restored.temperature.mean(restored.count));
+}
+
+void test_add_stops_at_cap() {
+    for(uint32_t i = 0; i < UINT16_MAX; i++) {
+        aggregate.add(makeSample(i, 20, 50));
+    }
+    TEST_ASSERT_EQUAL(UINT16_MAX, aggregate.count);
+    aggregate.add(makeSample(0, 30, 50));
+    TEST_ASSERT_EQUAL(UINT16_MAX, aggregate.count);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, aggregate.temperature.mean(aggregate.count));
+}
+
+void test_merge_saturates_mean() {
+    // as if months of readings went without a successful upload
+    ClimateAggregate older;
+    older.clear();
+    for(uint32_t i = 0; i < 60000; i++) {
+        older.add(makeSample(i, 20, 40));
+        aggregate.add(makeSample(i, 30, 60));
+    }
+    aggregate.merge(older);
+    TEST_ASSERT_EQUAL(UINT16_MAX, aggregate.count);
+    // 60000 at 30 and the share of 5535 at 20 that fit
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (60000 * 30.0f + 5535 * 20.0f) / UINT16_MAX, aggregate.temperature.mean(aggregate.count));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (60000 * 60.0f + 5535 * 40.0f) / UINT16_MAX, aggregate.humidity.mean(aggregate.count));
+    TEST_ASSERT_EQUAL(2000, aggregate.temperature.min);
+    TEST_ASSERT_EQUAL(3000, aggregate.temperature.max);
+
+    // nothing more fits, the mean stays
+    float mean = aggregate.temperature.mean(aggregate.count);
+    aggregate.merge(older);
+    TEST_ASSERT_EQUAL(UINT16_MAX, aggregate.count);
+    TEST_ASSERT_EQUAL_FLOAT(mean, aggregate.temperature.mean(aggregate.count));
+}
+
+void test_merge_extremes_at_cap() {
+    // the largest values a full window can sum up to don't overflow
+    ClimateAggregate hot;
+    hot.clear();
+    for(uint32_t i = 0; i < UINT16_MAX; i++) {
+        aggregate.add(makeSample(i, 327, 100));
+        hot.add(makeSample(i, 327, 100));
+    }
+    aggregate.merge(hot);
+    TEST_ASSERT_EQUAL(UINT16_MAX, aggregate.count);
+    TEST_ASSERT_EQUAL_FLOAT(327.0f, aggregate.temperature.mean(aggregate.count));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_add);
+    RUN_TEST(test_clear_starts_over);
+    RUN_TEST(test_merge_equals_adding_all);
+    RUN_TEST(test_merge_with_empty);
+    RUN_TEST(test_restore_failed_upload);
+    RUN_TEST(test_survives_rtc);
+    RUN_TEST(test_add_stops_at_cap);
+    RUN_TEST(test_merge_saturates_mean);
+    RUN_TEST(test_merge_extremes_at_cap);
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#include <unity.h>
+#include "../../src/clock.h"
+
+// ClockSync: the drift measured between SNTP syncs and how it corrects the station clock, the
+// span a measurement needs, the station clock wrapping at 32 bits, and starting over after clear().
+
+#define UNIX_BASE 1700000000u
+
+ClockSync clockSync;
+
+void setUp() {
+    clockSync.clear();
+}
+
+void tearDown() {
+}
+
+void test_first_sync_anchors() {
+    TEST_ASSERT_FALSE(clockSync.valid);
+    TEST_ASSERT_TRUE(clockSync.due(0, 100));
+    TEST_ASSERT_EQUAL(0, clockSync.sync(500, UNIX_BASE));
+    TEST_ASSERT_TRUE(clockSync.valid);
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(UNIX_BASE, clockSync.unixTime(500));
+    TEST_ASSERT_EQUAL(UNIX_BASE + 60, clockSync.unixTime(560));
+    // samples from before the sync
+    TEST_ASSERT_EQUAL(UNIX_BASE - 60, clockSync.unixTime(440));
+}
+
+void test_drift_between_syncs() {
+    clockSync.sync(0, UNIX_BASE);
+    // the station clock ran 2% fast over an hour
+    TEST_ASSERT_EQUAL(72, clockSync.sync(3672, UNIX_BASE + 3600));
+    TEST_ASSERT_TRUE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(20000, clockSync.drift_ppm);
+    // which the next hour is corrected for
+    TEST_ASSERT_EQUAL(UNIX_BASE + 7200, clockSync.unixTime(3672 + 3672));
+    TEST_ASSERT_EQUAL(0, clockSync.sync(3672 + 3672, UNIX_BASE + 7200));
+    TEST_ASSERT_EQUAL(20000, clockSync.drift_ppm);
+
+    // a different rate moves the estimate a quarter of the way
+    TEST_ASSERT_EQUAL(-36, clockSync.sync(7344 + 3636, UNIX_BASE + 10800));
+    TEST_ASSERT_EQUAL((3 * 20000 + 10000) / 4, clockSync.drift_ppm);
+
+    // a slow clock
+    clockSync.clear();
+    clockSync.sync(0, UNIX_BASE);
+    clockSync.sync(3564, UNIX_BASE + 3600);
+    TEST_ASSERT_EQUAL(-10000, clockSync.drift_ppm);
+    TEST_ASSERT_EQUAL(UNIX_BASE + 7200, clockSync.unixTime(3564 + 3564));
+}
+
+void test_drift_needs_half_an_hour() {
+    clockSync.sync(0, UNIX_BASE);
+    // off by 36 s over less than CLOCK_DRIFT_MIN_SPAN_S isn't taken as drift
+    TEST_ASSERT_EQUAL(36, clockSync.sync(CLOCK_DRIFT_MIN_SPAN_S - 1, UNIX_BASE + CLOCK_DRIFT_MIN_SPAN_S - 37));
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(0, clockSync.drift_ppm);
+
+    // the span starts at the last sync, not the first
+    clockSync.sync(2 * CLOCK_DRIFT_MIN_SPAN_S - 2, UNIX_BASE + 2 * CLOCK_DRIFT_MIN_SPAN_S - 38);
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+
+    uint32_t station_s = clockSync.station_s + CLOCK_DRIFT_MIN_SPAN_S;
+    clockSync.sync(station_s, clockSync.unix_s + CLOCK_DRIFT_MIN_SPAN_S - 18);
+    TEST_ASSERT_TRUE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(18 * 1000000 / (CLOCK_DRIFT_MIN_SPAN_S - 18), clockSync.drift_ppm);
+}
+
+void test_drift_is_limited() {
+    clockSync.sync(0, UNIX_BASE);
+    // an hour of station clock in half an hour
+    clockSync.sync(3600, UNIX_BASE + 1800);
+    TEST_ASSERT_EQUAL(CLOCK_DRIFT_MAX_PPM, clockSync.drift_ppm);
+    clockSync.clear();
+    clockSync.sync(0, UNIX_BASE);
+    clockSync.sync(1800, UNIX_BASE + 3600);
+    TEST_ASSERT_EQUAL(-CLOCK_DRIFT_MAX_PPM, clockSync.drift_ppm);
+
+    // unix time going backwards, e.g. a bad SNTP answer, isn't measured
+    clockSync.clear();
+    clockSync.sync(0, UNIX_BASE);
+    clockSync.sync(3600, UNIX_BASE - 10);
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+}
+
+void test_station_clock_wraps() {
+    uint32_t before = 0xFFFFFFFF - 1000;
+    clockSync.sync(before, UNIX_BASE);
+    // past the wrap, 3672 s of station clock later
+    uint32_t after = before + 3672;
+    TEST_ASSERT_TRUE(after < before);
+    TEST_ASSERT_EQUAL(UNIX_BASE + 3672, clockSync.unixTime(after));
+    TEST_ASSERT_EQUAL(72, clockSync.sync(after, UNIX_BASE + 3600));
+    TEST_ASSERT_EQUAL(20000, clockSync.drift_ppm);
+    TEST_ASSERT_EQUAL(UNIX_BASE + 7200, clockSync.unixTime(after + 3672));
+    // a sample from before the wrap
+    TEST_ASSERT_EQUAL(UNIX_BASE + 3600 - 3600, clockSync.unixTime(after - 3672));
+
+    TEST_ASSERT_FALSE(clockSync.due(after + 10, 100));
+    TEST_ASSERT_TRUE(clockSync.due(after + CLOCK_RESYNC_S, 100));
+}
+
+void test_due() {
+    clockSync.sync(1000, UNIX_BASE);
+    TEST_ASSERT_FALSE(clockSync.due(1000, 3));
+    clockSync.wakes = 2;
+    TEST_ASSERT_FALSE(clockSync.due(1000, 3));
+    clockSync.wakes = 3;
+    TEST_ASSERT_TRUE(clockSync.due(1000, 3));
+    clockSync.sync(1010, UNIX_BASE + 10);
+    TEST_ASSERT_EQUAL(0, clockSync.wakes);
+    // however few wakes there were
+    TEST_ASSERT_FALSE(clockSync.due(1010 + CLOCK_RESYNC_S - 1, 100));
+    TEST_ASSERT_TRUE(clockSync.due(1010 + CLOCK_RESYNC_S, 100));
+}
+
+void test_clear_starts_over() {
+    clockSync.sync(0, UNIX_BASE);
+    clockSync.sync(3672, UNIX_BASE + 3600);
+    TEST_ASSERT_TRUE(clockSync.driftKnown);
+
+    clockSync.clear();
+    TEST_ASSERT_FALSE(clockSync.valid);
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(0, clockSync.drift_ppm);
+    TEST_ASSERT_TRUE(clockSync.due(3700, 100));
+
+    // the old anchor doesn't count as a measurement, nor as an error
+    TEST_ASSERT_EQUAL(0, clockSync.sync(3672 + 7200, UNIX_BASE + 99999));
+    TEST_ASSERT_TRUE(clockSync.valid);
+    TEST_ASSERT_FALSE(clockSync.driftKnown);
+    TEST_ASSERT_EQUAL(UNIX_BASE + 99999 + 60, clockSync.unixTime(3672 + 7200 + 60));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_sync_anchors);
+    RUN_TEST(test_drift_between_syncs);
+    RUN_TEST(test_drift_needs_half_an_hour);
+    RUN_TEST(test_drift_is_limited);
+    RUN_TEST(test_station_clock_wraps);
+    RUN_TEST(test_due);
+    RUN_TEST(test_clear_starts_over);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+#include <unity.h>
+#include "../../src/settingsjson.h"
+
+// EnergyMeter and EnergyAccount: every millisecond of a wake going to exactly one phase, the
+// radio running in the background taking the time of the foreground phases, sleep, and the
+// charge and mAh per day from the currents. Then the body /energy takes.
+
+EnergyAccount account;
+EnergyMeter *meter;
+uint32_t current_uA[ENERGY_PHASES];
+
+void setUp() {
+    account.clear();
+    meter = new EnergyMeter(account);
+    defaultSettings(settings);
+    memcpy(current_uA, settings.phaseCurrent_uA, sizeof current_uA);
+}
+
+void tearDown() {
+    delete meter;
+}
+
+void test_phases_add_up() {
+    // a wake starts in PHASE_OTHER at 0
+    TEST_ASSERT_EQUAL(PHASE_OTHER, meter->enter(PHASE_SENSOR, 120));
+    TEST_ASSERT_EQUAL(PHASE_SENSOR, meter->enter(PHASE_DISPLAY, 135));
+    // nested, like PhaseTimer: the upload pauses the display and hands back to it
+    uint8_t previous = meter->enter(PHASE_UPLOAD, 140);
+    TEST_ASSERT_EQUAL(PHASE_DISPLAY, previous);
+    meter->enter(previous, 340);
+    meter->enter(PHASE_OTHER, 345);
+    meter->sleep(400, 300);
+
+    TEST_ASSERT_EQUAL(120 + 55, account.phase_ms[PHASE_OTHER]);
+    TEST_ASSERT_EQUAL(15, account.phase_ms[PHASE_SENSOR]);
+    TEST_ASSERT_EQUAL(5 + 5, account.phase_ms[PHASE_DISPLAY]);
+    TEST_ASSERT_EQUAL(200, account.phase_ms[PHASE_UPLOAD]);
+    TEST_ASSERT_EQUAL(0, account.phase_ms[PHASE_WIFI]);
+    TEST_ASSERT_EQUAL(300000, account.phase_ms[PHASE_SLEEP]);
+    TEST_ASSERT_EQUAL(400 + 300000, account.total_ms());
+
+    // the next wake adds to the same account
+    EnergyMeter next(account);
+    next.enter(PHASE_SENSOR, 100);
+    next.sleep(115, 300);
+    TEST_ASSERT_EQUAL(30, account.phase_ms[PHASE_SENSOR]);
+    TEST_ASSERT_EQUAL(300400 + 300115, account.total_ms());
+}
+
+void test_background_radio() {
+    meter->enter(PHASE_SENSOR, 100);
+    // associating starts during the sensor reading
+    meter->background(PHASE_WIFI, 110);
+    meter->enter(PHASE_DISPLAY, 125);
+    meter->enter(PHASE_WIFI, 135);
+    // the radio's own phases keep their time
+    meter->enter(PHASE_UPLOAD, 300);
+    meter->enter(PHASE_OTHER, 500);
+    meter->background(ENERGY_PHASES, 510);
+    meter->enter(PHASE_SENSOR, 520);
+    meter->sleep(540, 10);
+
+    TEST_ASSERT_EQUAL(10 + 20, account.phase_ms[PHASE_SENSOR]);
+    TEST_ASSERT_EQUAL(0, account.phase_ms[PHASE_DISPLAY]);
+    // from the sensor, the display, the connect itself and the other phase until it ended
+    TEST_ASSERT_EQUAL(15 + 10 + 165 + 10, account.phase_ms[PHASE_WIFI]);
+    TEST_ASSERT_EQUAL(200, account.phase_ms[PHASE_UPLOAD]);
+    TEST_ASSERT_EQUAL(100 + 10, account.phase_ms[PHASE_OTHER]);
+    TEST_ASSERT_EQUAL(540 + 10000, account.total_ms());
+}
+
+void test_reset_starts_over() {
+    meter->enter(PHASE_UPLOAD, 1000);
+    meter->reset(1500);
+    TEST_ASSERT_EQUAL(0, account.total_ms());
+    // the time before the reset isn't attributed
+    meter->enter(PHASE_OTHER, 1600);
+    TEST_ASSERT_EQUAL(100, account.phase_ms[PHASE_UPLOAD]);
+    TEST_ASSERT_EQUAL(100, account.total_ms());
+}
+
+void test_charge_and_mAh_per_day() {
+    TEST_ASSERT_EQUAL_FLOAT(0, account.mAhPerDay(current_uA));
+
+    // an hour at the upload current is 75 mAh
+    account.phase_ms[PHASE_UPLOAD] = 3600000;
+    TEST_ASSERT_EQUAL_FLOAT(75, account.charge_mAh(PHASE_UPLOAD, current_uA));
+    TEST_ASSERT_EQUAL_FLOAT(75, account.charge_mAh(current_uA));
+    TEST_ASSERT_EQUAL_FLOAT(75 * 24, account.mAhPerDay(current_uA));
+
+    // a wake of a second at 20 mA every 5 minutes, asleep at 25 uA in between
+    account.clear();
+    account.phase_ms[PHASE_OTHER] = 288 * 1000;
+    account.phase_ms[PHASE_SLEEP] = 288 * 299000;
+    float day_mAh = 20 * 288 / 3600.0f + 0.025f * 288 * 299 / 3600.0f;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, day_mAh, account.charge_mAh(current_uA));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, day_mAh, account.mAhPerDay(current_uA));
+    // the same for a week of it
+    for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+        account.phase_ms[phase] *= 7;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 7 * day_mAh, account.charge_mAh(current_uA));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, day_mAh, account.mAhPerDay(current_uA));
+
+    // a year of sleep doesn't lose the milliseconds
+    account.clear();
+    account.phase_ms[PHASE_SLEEP] = 365ull * 86400000 + 1;
+    TEST_ASSERT_EQUAL(365ull * 86400000 + 1, account.total_ms());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.025f * 24 * 365, account.charge_mAh(current_uA));
+}
+
+// feeds body to a parser of current_uA, returns the error or "" if it was taken
+const char *parseEnergy(const char *body, EnergyJsonParser &parser) {
+    JsonReader reader(parser);
+    reader.feed(body, strlen(body));
+    if(!reader.finish()) {
+        return parser.error[0] ? parser.error : reader.error;
+    }
+    return "";
+}
+
+void test_energy_body() {
+    EnergyJsonParser parser(current_uA);
+    TEST_ASSERT_EQUAL_STRING("", parseEnergy("{\"current_uA\": {\"wifi\": 70000, \"sleep\": 20, \"flux\": 5}, \"other\": 1}", parser));
+    TEST_ASSERT_EQUAL(70000, current_uA[PHASE_WIFI]);
+    TEST_ASSERT_EQUAL(20, current_uA[PHASE_SLEEP]);
+    // left out
+    TEST_ASSERT_EQUAL(settings.phaseCurrent_uA[PHASE_UPLOAD], current_uA[PHASE_UPLOAD]);
+    TEST_ASSERT_FALSE(parser.reset);
+
+    EnergyJsonParser resetting(current_uA);
+    TEST_ASSERT_EQUAL_STRING("", parseEnergy("{\"reset\": true}", resetting));
+    TEST_ASSERT_TRUE(resetting.reset);
+
+    const char *invalid[] = {
+        "{\"current_uA\": {\"wifi\": -1}}",
+        "{\"current_uA\": {\"wifi\": \"70000\"}}",
+        "{\"current_uA\": {\"wifi\": 1.5}}",
+        "{\"current_uA\": {\"wifi\": 1000001}}",
+        "{\"reset\": 1}",
+    };
+    for(size_t i = 0; i < sizeof invalid / sizeof invalid[0]; i++) {
+        EnergyJsonParser refusing(current_uA);
+        const char *error = parseEnergy(invalid[i], refusing);
+        TEST_ASSERT_TRUE(strncmp(error, "Invalid value for ", 18) == 0);
+    }
+    EnergyJsonParser broken(current_uA);
+    TEST_ASSERT_EQUAL_STRING("Unexpected end", parseEnergy("{\"current_uA\": {\"wifi\": 1}", broken));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_phases_add_up);
+    RUN_TEST(test_background_radio);
+    RUN_TEST(test_reset_starts_over);
+    RUN_TEST(test_charge_and_mAh_per_day);
+    RUN_TEST(test_energy_body);
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+#include <unity.h>
+#include <stdio.h>
+#include "../../src/filter.h"
+#include "trace.h"
+
+// Replays the noisy trace in trace.h through the filter and change detection the way
+// readClimate() does, and counts the changes that would each have been an upload
+
+// as in station.h
+#define TEMPERATURE_THRESHOLD 20
+#define HUMIDITY_THRESHOLD 100
+
+struct Replay {
+    unsigned changes;
+    int16_t temperatureMin;  // filtered
+    int16_t temperatureMax;
+    int16_t humidityMin;
+    int16_t humidityMax;
+    int16_t reportedTemperature;
+    int16_t reportedHumidity;
+    unsigned flatDeviation;  // of the filtered temperature from the level, outside the ramp
+};
+
+Replay replay(const FilterParams &params) {
+    ClimateFilter filter;
+    filter.clear();
+    Replay result = {};
+    for(uint16_t i = 0; i < TRACE_READINGS; i++) {
+        int16_t temperature = filter.temperature.apply(trace[i][0], params);
+        int16_t humidity = filter.humidity.apply(trace[i][1], params);
+        if(i == 0 || temperature < result.temperatureMin) {
+            result.temperatureMin = temperature;
+        }
+        if(i == 0 || temperature > result.temperatureMax) {
+            result.temperatureMax = temperature;
+        }
+        if(i == 0 || humidity < result.humidityMin) {
+            result.humidityMin = humidity;
+        }
+        if(i == 0 || humidity > result.humidityMax) {
+            result.humidityMax = humidity;
+        }
+        // the filters lag behind the ramp for a few readings
+        unsigned deviation = 0;
+        if(i < TRACE_RAMP_START) {
+            deviation = abs(temperature - TRACE_TEMPERATURE_START_CC);
+        } else if(i >= TRACE_RAMP_END + 2 * FILTER_WINDOW_MAX) {
+            deviation = abs(temperature - TRACE_TEMPERATURE_END_CC);
+        }
+        if(deviation > result.flatDeviation) {
+            result.flatDeviation = deviation;
+        }
+
+        bool changed = i == 0;
+        if(!changed) {
+            // both, so each channel keeps track of the direction of its last change
+            bool temperatureChanged = filter.temperature.changed(temperature, result.reportedTemperature, TEMPERATURE_THRESHOLD, params);
+            bool humidityChanged = filter.humidity.changed(humidity, result.reportedHumidity, HUMIDITY_THRESHOLD, params);
+            changed = temperatureChanged || humidityChanged;
+        }
+        if(changed) {
+            result.changes++;
+            result.reportedTemperature = temperature;
+            result.reportedHumidity = humidity;
+        }
+    }
+    return result;
+}
+
+void report(const char *name, const Replay &result) {
+    char message[120];
+    snprintf(message, sizeof message, "%s: %u uploads, %.2f to %.2f C, %.2f to %.2f %%, %.2f C off the level when flat", name, result.changes,
+        result.temperatureMin / 100.0f, result.temperatureMax / 100.0f, result.humidityMin / 100.0f, result.humidityMax / 100.0f, result.flatDeviation / 100.0f);
+    TEST_MESSAGE(message);
+}
+
+// follows the ramp to within a threshold, plus the hysteresis of reversing
+void assertEndsAtLevel(const Replay &result, uint8_t hysteresis_pct) {
+    TEST_ASSERT_LESS_OR_EQUAL(TEMPERATURE_THRESHOLD * (100 + hysteresis_pct) / 100, abs(result.reportedTemperature - TRACE_TEMPERATURE_END_CC));
+    TEST_ASSERT_LESS_OR_EQUAL(HUMIDITY_THRESHOLD * (100 + hysteresis_pct) / 100, abs(result.reportedHumidity - TRACE_HUMIDITY_END_CPCT));
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void assertWithinLevels(const Replay &result, int16_t temperatureMargin, int16_t humidityMargin) {
+    TEST_ASSERT_GREATER_OR_EQUAL(TRACE_TEMPERATURE_START_CC - temperatureMargin, result.temperatureMin);
+    TEST_ASSERT_LESS_OR_EQUAL(TRACE_TEMPERATURE_END_CC + temperatureMargin, result.temperatureMax);
+    TEST_ASSERT_GREATER_OR_EQUAL(TRACE_HUMIDITY_END_CPCT - humidityMargin, result.humidityMin);
+    TEST_ASSERT_LESS_OR_EQUAL(TRACE_HUMIDITY_START_CPCT + humidityMargin, result.humidityMax);
+}
+
+void test_median_of_window() {
+    FilterParams params = { FILTER_MEDIAN, 3, 0, 0 };
+    ChannelFilter filter;
+    filter.clear();
+    TEST_ASSERT_EQUAL(100, filter.apply(100, params));
+    // the mean of the middle two while the window fills
+    TEST_ASSERT_EQUAL(150, filter.apply(200, params));
+    TEST_ASSERT_EQUAL(100, filter.apply(-500, params));
+    TEST_ASSERT_EQUAL(200, filter.apply(300, params));
+    TEST_ASSERT_EQUAL(300, filter.apply(900, params));
+}
+
+void test_ema_rounds() {
+    FilterParams params = { FILTER_EMA, 0, 2, 0 };
+    ChannelFilter filter;
+    filter.clear();
+    TEST_ASSERT_EQUAL(-100, filter.apply(-100, params));
+    TEST_ASSERT_EQUAL(-75, filter.apply(0, params));
+    TEST_ASSERT_EQUAL(-56, filter.apply(0, params));
+}
+
+void test_hysteresis_on_reversal() {
+    FilterParams params = { FILTER_NONE, 1, 0, 50 };
+    ChannelFilter filter;
+    filter.clear();
+    TEST_ASSERT_FALSE(filter.changed(120, 100, 20, params));
+    TEST_ASSERT_TRUE(filter.changed(121, 100, 20, params));
+    // going on in the same direction takes the threshold
+    TEST_ASSERT_TRUE(filter.changed(142, 121, 20, params));
+    // going back takes half of it more
+    TEST_ASSERT_FALSE(filter.changed(112, 142, 20, params));
+    TEST_ASSERT_TRUE(filter.changed(111, 142, 20, params));
+}
+
+void test_trace_unfiltered() {
+    FilterParams params = { FILTER_NONE, 1, 0, 0 };
+    Replay result = replay(params);
+    report("none", result);
+    TEST_ASSERT_EQUAL(46, result.changes);
+    // the spikes get through
+    TEST_ASSERT_GREATER_OR_EQUAL(TRACE_TEMPERATURE_END_CC + 80, result.temperatureMax);
+    assertEndsAtLevel(result, 0);
+
+    params.hysteresis_pct = 50;
+    result = replay(params);
+    report("none, 50 % hysteresis", result);
+    TEST_ASSERT_EQUAL(19, result.changes);
+}
+
+void test_trace_median() {
+    // the defaults
+    FilterParams params = { FILTER_MEDIAN, 3, 0, 50 };
+    Replay result = replay(params);
+    report("median of 3", result);
+    TEST_ASSERT_EQUAL(7, result.changes);
+    assertWithinLevels(result, 15, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(12, result.flatDeviation);
+    assertEndsAtLevel(result, params.hysteresis_pct);
+
+    params.windowSize = 5;
+    result = replay(params);
+    report("median of 5", result);
+    TEST_ASSERT_EQUAL(6, result.changes);
+    assertWithinLevels(result, 10, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(10, result.flatDeviation);
+    assertEndsAtLevel(result, params.hysteresis_pct);
+}
+
+void test_trace_ema() {
+    FilterParams params = { FILTER_EMA, 0, 2, 0 };
+    Replay result = replay(params);
+    report("ema 1/4", result);
+    TEST_ASSERT_EQUAL(8, result.changes);
+    // a quarter of each spike gets through
+    assertWithinLevels(result, 25, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(22, result.flatDeviation);
+    assertEndsAtLevel(result, params.hysteresis_pct);
+
+    params.hysteresis_pct = 50;
+    result = replay(params);
+    report("ema 1/4, 50 % hysteresis", result);
+    TEST_ASSERT_EQUAL(7, result.changes);
+
+    params.emaShift = 3;
+    result = replay(params);
+    report("ema 1/8, 50 % hysteresis", result);
+    TEST_ASSERT_EQUAL(7, result.changes);
+    assertWithinLevels(result, 15, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(12, result.flatDeviation);
+    assertEndsAtLevel(result, params.hysteresis_pct);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_median_of_window);
+    RUN_TEST(test_ema_rounds);
+    RUN_TEST(test_hysteresis_on_reversal);
+    RUN_TEST(test_trace_unfiltered);
+    RUN_TEST(test_trace_median);
+    RUN_TEST(test_trace_ema);
+    return UNITY_END();
+}
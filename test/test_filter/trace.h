@@ -0,0 +1,83 @@
+#ifndef __TRACE__
+#define __TRACE__
+
+#include <stdint.h>
+
+// An hour of readings every 10 s: flat at 21.40 C and 48.0 %, from minute 20 to 40 a ramp up by
+// 1 C and down by 3 %, then flat again. The noise is 0.06 C and 0.35 % standard deviation, about
+// what an SHT31 at low repeatability shows, with a few single readings off by 0.9 C or 4 %.
+// Generated once with a fixed seed and checked in, so the counts in test_main.cpp stay put.
+
+#define TRACE_READINGS 360
+#define TRACE_RAMP_START 120
+#define TRACE_RAMP_END 240
+#define TRACE_TEMPERATURE_START_CC 2140
+#define TRACE_TEMPERATURE_END_CC 2240
+#define TRACE_HUMIDITY_START_CPCT 4800
+#define TRACE_HUMIDITY_END_CPCT 4500
+
+// temperature in hundredths of a degree, humidity in hundredths of a percent
+const int16_t trace[TRACE_READINGS][2] = {
+    { 2142, 4889 }, { 2147, 4839 }, { 2144, 4813 }, { 2144, 4800 }, { 2136, 4770 }, { 2133, 4812 },
+    { 2144, 4862 }, { 2144, 4814 }, { 2145, 4803 }, { 2129, 4841 }, { 2138, 4812 }, { 2139, 4908 },
+    { 2148, 4819 }, { 2134, 4836 }, { 2135, 4846 }, { 2131, 4801 }, { 2146, 4773 }, { 2141, 4810 },
+    { 2147, 4787 }, { 2145, 4879 }, { 2131, 4773 }, { 2144, 4780 }, { 2132, 4856 }, { 2147, 4845 },
+    { 2148, 4831 }, { 2136, 4718 }, { 2144, 4766 }, { 2141, 4819 }, { 2133, 4792 }, { 2152, 4833 },
+    { 2131, 4797 }, { 2231, 4826 }, { 2145, 4802 }, { 2139, 4837 }, { 2132, 4846 }, { 2143, 4786 },
+    { 2137, 4813 }, { 2132, 4719 }, { 2143, 4857 }, { 2140, 4805 }, { 2140, 4768 }, { 2143, 4833 },
+    { 2141, 4836 }, { 2134, 4812 }, { 2136, 4785 }, { 2142, 4808 }, { 2146, 4826 }, { 2133, 4849 },
+    { 2131, 4798 }, { 2142, 4798 }, { 2143, 4802 }, { 2134, 4830 }, { 2140, 4767 }, { 2140, 4799 },
+    { 2142, 4779 }, { 2141, 4794 }, { 2150, 4787 }, { 2148, 5197 }, { 2147, 4883 }, { 2138, 4805 },
+    { 2134, 4775 }, { 2137, 4803 }, { 2146, 4832 }, { 2137, 4805 }, { 2131, 4821 }, { 2139, 4761 },
+    { 2136, 4820 }, { 2141, 4823 }, { 2137, 4806 }, { 2139, 4746 }, { 2139, 4795 }, { 2136, 4828 },
+    { 2153, 4851 }, { 2140, 4759 }, { 2139, 4777 }, { 2141, 4842 }, { 2140, 4750 }, { 2148, 4802 },
+    { 2148, 4769 }, { 2155, 4756 }, { 2141, 4829 }, { 2124, 4772 }, { 2130, 4861 }, { 2144, 4766 },
+    { 2129, 4738 }, { 2141, 4771 }, { 2142, 4781 }, { 2130, 4864 }, { 2143, 4775 }, { 2138, 4847 },
+    { 2145, 4756 }, { 2149, 4778 }, { 2144, 4757 }, { 2136, 4828 }, { 2133, 4803 }, { 2232, 4776 },
+    { 2149, 4824 }, { 2139, 4836 }, { 2148, 4844 }, { 2139, 4829 }, { 2142, 4761 }, { 2138, 4872 },
+    { 2135, 4817 }, { 2150, 4787 }, { 2140, 4773 }, { 2143, 4757 }, { 2143, 4771 }, { 2142, 4739 },
+    { 2133, 4833 }, { 2144, 4692 }, { 2149, 4771 }, { 2145, 4836 }, { 2139, 4786 }, { 2128, 4816 },
+    { 2151, 4755 }, { 2147, 4826 }, { 2146, 4762 }, { 2139, 4809 }, { 2150, 4767 }, { 2137, 4773 },
+    { 2145, 4743 }, { 2140, 4751 }, { 2140, 4822 }, { 2139, 4817 }, { 2140, 4788 }, { 2143, 4756 },
+    { 2147, 4808 }, { 2141, 4806 }, { 2147, 4764 }, { 2148, 4806 }, { 2153, 4827 }, { 2151, 4780 },
+    { 2141, 4750 }, { 2154, 4728 }, { 2146, 4829 }, { 2152, 4723 }, { 2140, 4728 }, { 2168, 4756 },
+    { 2159, 4778 }, { 2153, 4764 }, { 2157, 4738 }, { 2164, 4717 }, { 2154, 4721 }, { 2166, 4725 },
+    { 2171, 4692 }, { 2155, 4644 }, { 2156, 4737 }, { 2167, 4697 }, { 2160, 4779 }, { 2161, 4730 },
+    { 2169, 4690 }, { 2173, 4715 }, { 2171, 4709 }, { 2169, 4759 }, { 2170, 4650 }, { 2167, 4698 },
+    { 2169, 4716 }, { 2161, 4768 }, { 2166, 4749 }, { 2170, 4689 }, { 2172, 4687 }, { 2177, 4740 },
+    { 2186, 4760 }, { 2168, 4715 }, { 2179, 4686 }, { 2179, 4687 }, { 2171, 4655 }, { 2185, 4680 },
+    { 2188, 4663 }, { 2177, 4681 }, { 2182, 4708 }, { 2179, 4700 }, { 2185, 4638 }, { 2183, 4660 },
+    { 2191, 4708 }, { 2190, 4643 }, { 2191, 4665 }, { 2184, 4683 }, { 2184, 4644 }, { 2183, 4603 },
+    { 2192, 4594 }, { 2187, 4634 }, { 2194, 4621 }, { 2197, 4613 }, { 2188, 4610 }, { 2191, 4611 },
+    { 2186, 4608 }, { 2191, 4669 }, { 2280, 4641 }, { 2192, 4657 }, { 2197, 4604 }, { 2206, 4674 },
+    { 2209, 4653 }, { 2201, 4593 }, { 2199, 4595 }, { 2205, 4597 }, { 2205, 4616 }, { 2203, 4584 },
+    { 2199, 4693 }, { 2205, 4545 }, { 2199, 4577 }, { 2218, 4602 }, { 2203, 4655 }, { 2198, 4632 },
+    { 2227, 4590 }, { 2217, 4611 }, { 2194, 4597 }, { 2209, 4485 }, { 2219, 4559 }, { 2216, 4593 },
+    { 2211, 4492 }, { 2213, 4545 }, { 2209, 4541 }, { 2217, 4621 }, { 2219, 4573 }, { 2226, 4578 },
+    { 2219, 4536 }, { 2213, 4590 }, { 2221, 4597 }, { 2218, 4531 }, { 2226, 4602 }, { 2223, 4526 },
+    { 2228, 4897 }, { 2233, 4497 }, { 2217, 4542 }, { 2224, 4584 }, { 2233, 4551 }, { 2217, 4530 },
+    { 2225, 4460 }, { 2242, 4459 }, { 2226, 4492 }, { 2228, 4527 }, { 2236, 4474 }, { 2237, 4540 },
+    { 2237, 4570 }, { 2233, 4499 }, { 2234, 4468 }, { 2237, 4545 }, { 2242, 4504 }, { 2240, 4549 },
+    { 2247, 4433 }, { 2232, 4535 }, { 2244, 4523 }, { 2246, 4459 }, { 2232, 4516 }, { 2232, 4503 },
+    { 2252, 4436 }, { 2243, 4556 }, { 2248, 4484 }, { 2234, 4500 }, { 2232, 4505 }, { 2238, 4489 },
+    { 2245, 4500 }, { 2236, 4493 }, { 2238, 4490 }, { 2237, 4530 }, { 2237, 4537 }, { 2244, 4534 },
+    { 2242, 4453 }, { 2254, 4484 }, { 2233, 4506 }, { 2241, 4428 }, { 2231, 4487 }, { 2237, 4461 },
+    { 2234, 4498 }, { 2234, 4513 }, { 2241, 4480 }, { 2250, 4553 }, { 2231, 4497 }, { 2248, 4471 },
+    { 2226, 4465 }, { 2235, 4473 }, { 2241, 4519 }, { 2243, 4428 }, { 2235, 4534 }, { 2236, 4457 },
+    { 2238, 4576 }, { 2231, 4482 }, { 2238, 4465 }, { 2239, 4478 }, { 2232, 4485 }, { 2237, 4479 },
+    { 2241, 4515 }, { 2243, 4516 }, { 2232, 4504 }, { 2238, 4464 }, { 2240, 4491 }, { 2238, 4514 },
+    { 2232, 4495 }, { 2234, 4481 }, { 2236, 4523 }, { 2243, 4514 }, { 2232, 4504 }, { 2249, 4540 },
+    { 2243, 4503 }, { 2235, 4510 }, { 2231, 4493 }, { 2231, 4466 }, { 2231, 4510 }, { 2237, 4509 },
+    { 2243, 4510 }, { 2325, 4510 }, { 2232, 4481 }, { 2243, 4490 }, { 2240, 4500 }, { 2253, 4435 },
+    { 2233, 4547 }, { 2232, 4499 }, { 2249, 4435 }, { 2239, 4523 }, { 2247, 4476 }, { 2243, 4486 },
+    { 2242, 4483 }, { 2243, 4523 }, { 2245, 4485 }, { 2235, 4511 }, { 2246, 4517 }, { 2235, 4501 },
+    { 2239, 4470 }, { 2253, 4490 }, { 2238, 4492 }, { 2232, 4482 }, { 2236, 4470 }, { 2237, 4383 },
+    { 2239, 4490 }, { 2234, 4465 }, { 2226, 4477 }, { 2241, 4502 }, { 2240, 4484 }, { 2247, 4549 },
+    { 2232, 4555 }, { 2243, 4451 }, { 2238, 4511 }, { 2252, 4489 }, { 2246, 4479 }, { 2238, 4548 },
+    { 2237, 4511 }, { 2245, 4523 }, { 2243, 4522 }, { 2254, 4488 }, { 2245, 4472 }, { 2240, 4479 },
+    { 2228, 4435 }, { 2244, 4401 }, { 2236, 4479 }, { 2245, 4504 }, { 2243, 4462 }, { 2232, 4456 },
+    { 2239, 4518 }, { 2246, 4469 }, { 2249, 4509 }, { 2238, 4442 }, { 2243, 4521 }, { 2239, 4449 },
+    { 2231, 4576 }, { 2236, 4570 }, { 2244, 4529 }, { 2249, 4497 }, { 2241, 4427 }, { 2235, 4468 },
+};
+
+#endif
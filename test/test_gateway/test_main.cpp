@@ -0,0 +1,383 @@
+#include <unity.h>
+#include "../../src/sim/link_sim.h"
+#include "../../src/sim/transport_sim.h"
+
+// Many nodes sending to one gateway over the simulator's link, datagrams on the loopback
+// interface: every sample arriving exactly once and in order while frames and acks get lost or
+// come in twice, nodes giving up after their ack timeouts and sending again later, and what the
+// gateway and the nodes account for when their queues run full. Each sample carries its
+// sequence number as its temperature, to tell what arrived. Then when what's left over after
+// forwarding part of the gateway's queue is due.
+
+#define NODES (GATEWAY_NODES + 4)
+#define STEP_MS 1
+
+SimShared shared;
+SimLink gatewayLink;
+Gateway *gateway;
+
+// Sends every frame a second time while twice is set, as a radio may deliver it again
+class DuplicatingLink : public GatewayLink {
+public:
+    DuplicatingLink(GatewayLink &link) : link(link) {
+    }
+
+    bool begin(uint8_t channel) override {
+        return link.begin(channel);
+    }
+
+    bool ready() override {
+        return link.ready();
+    }
+
+    bool send(const uint8_t *address, const uint8_t *data, size_t length) override {
+        return link.send(address, data, length) && (!twice || link.send(address, data, length));
+    }
+
+    size_t receive(uint8_t *address, uint8_t *data, size_t capacity) override {
+        return link.receive(address, data, capacity);
+    }
+
+    void end() override {
+        link.end();
+    }
+
+    bool twice = false;
+
+private:
+    GatewayLink &link;
+};
+
+struct Node {
+    SimLink simLink;
+    DuplicatingLink link{simLink};
+    GatewayUploader uploader{link};
+    SampleBuffer queue;
+    uint16_t boot = 1;
+    uint16_t sequence = 0;  // of the next sample
+};
+
+Node *nodes[NODES];
+ClockSync noClock;
+
+// the nodes' station clock, they all run the same
+uint32_t nodeClock() {
+    return (uint32_t) (sim->now_ms / 1000);
+}
+
+// the gateway's, started long before the nodes
+uint32_t gatewayClock() {
+    return (uint32_t) (sim->now_ms / 1000) + 100000;
+}
+
+void setUp() {
+    memset(&shared, 0, sizeof shared);
+    shared.now_ms = 1000000;
+    sim = &shared;
+    gatewayLink.setLoss(0);
+    // what the previous test left on the air
+    uint8_t from[GATEWAY_ADDRESS_SIZE], data[GATEWAY_FRAME_MAX];
+    while(gatewayLink.receive(from, data, sizeof data) > 0) {
+    }
+    gateway = new Gateway(gatewayLink);
+    for(uint8_t i = 0; i < NODES; i++) {
+        Node *node = nodes[i] = new Node();
+        node->queue.clear();
+        node->uploader.setQueue(node->queue);
+        node->uploader.setNode(0xA00000 + i, node->boot, nodeClock);
+        node->simLink.sendTo(gatewayLink);
+        TEST_ASSERT_TRUE(node->simLink.begin(1));
+    }
+}
+
+void tearDown() {
+    for(uint8_t i = 0; i < NODES; i++) {
+        nodes[i]->simLink.end();
+        delete nodes[i];
+    }
+    delete gateway;
+}
+
+// a second apart, the gateway tells new samples from those it has by their timestamps
+void measure(Node &node, uint8_t n = 1) {
+    for(uint8_t i = 0; i < n; i++) {
+        sim->now_ms += 1000;
+        node.queue.push(makeSample(nodeClock(), node.sequence++, 50));
+    }
+}
+
+// Runs the nodes and the gateway, which answers in between their steps, until every node has
+// sent its queue or is backing off
+void run(uint8_t count = NODES, bool gatewayUp = true) {
+    for(int steps = 0; steps < 10000; steps++) {
+        bool busy = false;
+        for(uint8_t i = 0; i < count; i++) {
+            GatewayUploader &uploader = nodes[i]->uploader;
+            uploader.step((uint32_t) sim->now_ms, noClock);
+            busy |= uploader.state() != Uploader::BACKOFF && (!uploader.idle() || !nodes[i]->queue.empty());
+        }
+        if(gatewayUp) {
+            gateway->receive(gatewayClock());
+        }
+        if(!busy) {
+            return;
+        }
+        sim->now_ms += STEP_MS;
+    }
+    TEST_FAIL_MESSAGE("the nodes never settled");
+}
+
+// Lets the backoffs run out and runs again, until the nodes have nothing left to send
+void runUntilSent(uint8_t count = NODES) {
+    for(int rounds = 0; rounds < 100; rounds++) {
+        run(count);
+        bool pending = false;
+        for(uint8_t i = 0; i < count; i++) {
+            pending |= !nodes[i]->queue.empty();
+        }
+        if(!pending) {
+            return;
+        }
+        sim->now_ms += UPLOAD_MAX_BACKOFF_MS;
+    }
+    TEST_FAIL_MESSAGE("samples never got through");
+}
+
+// Checks that the gateway got the samples of each node once and in order, then forwards them
+uint16_t received[NODES];
+
+void forward() {
+    for(uint16_t i = 0; i < gateway->queue.size(); i++) {
+        const GatewaySample &item = gateway->queue.at(i);
+        uint32_t n = item.node - 0xA00000;
+        TEST_ASSERT_TRUE(n < NODES);
+        TEST_ASSERT_EQUAL(received[n] * 100, item.sample.temperature_cC);
+        received[n]++;
+    }
+    gateway->queue.drop(gateway->queue.size(), gatewayClock());
+}
+
+void assertAllReceived(uint8_t count = NODES) {
+    forward();
+    for(uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(nodes[i]->queue.empty());
+        TEST_ASSERT_EQUAL(nodes[i]->sequence, received[i]);
+    }
+}
+
+const GatewayNode *findNode(uint8_t i) {
+    for(uint8_t j = 0; j < GATEWAY_NODES; j++) {
+        if(gateway->node(j).known && gateway->node(j).id == 0xA00000u + i) {
+            return &gateway->node(j);
+        }
+    }
+    return NULL;
+}
+
+void test_many_nodes() {
+    memset(received, 0, sizeof received);
+    for(uint8_t i = 0; i < NODES; i++) {
+        measure(*nodes[i], 5);
+    }
+    run();
+    TEST_ASSERT_EQUAL(NODES * 5, gateway->queue.size());
+    TEST_ASSERT_EQUAL(NODES, gateway->framesReceived);
+    TEST_ASSERT_EQUAL(0, gateway->framesRefused);
+    TEST_ASSERT_EQUAL(NODES, sim->framesSent);
+    // the table of nodes is full, the ones seen the longest ago made room
+    TEST_ASSERT_EQUAL(GATEWAY_NODES, gateway->nodeCount());
+    TEST_ASSERT_NOT_NULL(findNode(NODES - 1));
+
+    // the gateway stamps the samples by their age
+    TEST_ASSERT_EQUAL(gateway->queue.at(0).sample.timestamp_s + 4, gateway->queue.at(4).sample.timestamp_s);
+    sim->now_ms += 60000;
+    measure(*nodes[0]);
+    run(1);
+    const GatewaySample &newest = gateway->queue.at(gateway->queue.size() - 1);
+    TEST_ASSERT_EQUAL(gatewayClock(), newest.sample.timestamp_s);
+    assertAllReceived();
+}
+
+void test_lossy_link() {
+    memset(received, 0, sizeof received);
+    for(uint8_t i = 0; i < NODES; i++) {
+        nodes[i]->simLink.setLoss(20);
+    }
+    gatewayLink.setLoss(20);
+    for(int round = 0; round < 10; round++) {
+        for(uint8_t i = 0; i < GATEWAY_NODES; i++) {
+            measure(*nodes[i], 1 + (i + round) % 3);
+        }
+        runUntilSent(GATEWAY_NODES);
+        forward();
+        sim->now_ms += 60000;
+    }
+    assertAllReceived(GATEWAY_NODES);
+    TEST_ASSERT_TRUE(sim->framesLost > 0);
+    // the frames whose ack got lost came again, the gateway stored their samples once
+    unsigned long duplicates = 0;
+    for(uint8_t i = 0; i < GATEWAY_NODES; i++) {
+        duplicates += findNode(i)->duplicates;
+        TEST_ASSERT_EQUAL(nodes[i]->sequence, findNode(i)->samples);
+    }
+    TEST_ASSERT_TRUE(duplicates > 0);
+}
+
+void test_duplicated_frames() {
+    memset(received, 0, sizeof received);
+    Node &node = *nodes[0];
+    node.link.twice = true;
+    for(int round = 0; round < 3; round++) {
+        measure(node, 4);
+        run(1);
+        TEST_ASSERT_TRUE(node.queue.empty());
+    }
+    // both copies were acknowledged, only the first one's samples were stored
+    TEST_ASSERT_EQUAL(6, gateway->framesReceived);
+    TEST_ASSERT_EQUAL(12, findNode(0)->samples);
+    TEST_ASSERT_EQUAL(12, findNode(0)->duplicates);
+    // the second ack came too late for one round and doesn't count for the next
+    TEST_ASSERT_EQUAL(3, node.uploader.uploadsSucceeded);
+
+    // the ack of the last copy is still around when the gateway refuses the next frame
+    forward();
+    while(gateway->queue.room() > 0) {
+        gateway->queue.push(0xB00000, makeSample(0, 0, 0), gatewayClock());
+    }
+    measure(node);
+    run(1);
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, node.uploader.state());
+    TEST_ASSERT_EQUAL(1, node.queue.size());
+    gateway->queue.drop(GATEWAY_QUEUE_SIZE, gatewayClock());
+    runUntilSent(1);
+    assertAllReceived(1);
+}
+
+void test_ack_timeout() {
+    memset(received, 0, sizeof received);
+    Node &node = *nodes[0];
+    measure(node, 3);
+    // the gateway doesn't answer
+    run(1, false);
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, node.uploader.state());
+    TEST_ASSERT_EQUAL(UPLOAD_ERROR_READ_TIMEOUT, node.uploader.lastResult);
+    TEST_ASSERT_EQUAL(GATEWAY_SEND_ATTEMPTS, node.uploader.framesSent);
+    TEST_ASSERT_EQUAL(3, node.queue.size());
+
+    // it does again, with the frames still waiting for it: stored once, acked too late
+    gateway->receive(gatewayClock());
+    TEST_ASSERT_EQUAL(3, gateway->queue.size());
+    TEST_ASSERT_EQUAL(GATEWAY_SEND_ATTEMPTS, gateway->framesReceived);
+    TEST_ASSERT_EQUAL(3 * (GATEWAY_SEND_ATTEMPTS - 1), findNode(0)->duplicates);
+
+    // the node sends them once more after its backoff and forgets them
+    measure(node);
+    sim->now_ms += node.uploader.backoff();
+    run(1);
+    TEST_ASSERT_TRUE(node.uploader.idle());
+    TEST_ASSERT_EQUAL(4, gateway->queue.size());
+    TEST_ASSERT_EQUAL(3 * GATEWAY_SEND_ATTEMPTS, findNode(0)->duplicates);
+    assertAllReceived(1);
+}
+
+void test_gateway_queue_full() {
+    memset(received, 0, sizeof received);
+    // nodes enough to fill the gateway, with those after refused
+    const uint8_t perNode = 10;
+    const uint8_t fit = GATEWAY_QUEUE_SIZE / perNode;
+    for(uint8_t i = 0; i < GATEWAY_NODES; i++) {
+        measure(*nodes[i], perNode);
+    }
+    run(GATEWAY_NODES);
+    TEST_ASSERT_EQUAL(fit * perNode, gateway->queue.size());
+    TEST_ASSERT_EQUAL(fit, gateway->framesReceived);
+    // each refused frame was sent the full number of times
+    TEST_ASSERT_EQUAL((GATEWAY_NODES - fit) * GATEWAY_SEND_ATTEMPTS, gateway->framesRefused);
+    for(uint8_t i = fit; i < GATEWAY_NODES; i++) {
+        TEST_ASSERT_EQUAL(Uploader::BACKOFF, nodes[i]->uploader.state());
+        TEST_ASSERT_EQUAL(perNode, nodes[i]->queue.size());
+    }
+
+    // the samples waited on the nodes until the gateway forwarded
+    forward();
+    runUntilSent(GATEWAY_NODES);
+    assertAllReceived(GATEWAY_NODES);
+    TEST_ASSERT_EQUAL((GATEWAY_NODES - fit) * GATEWAY_SEND_ATTEMPTS, gateway->framesRefused);
+}
+
+void test_node_queue_overflows_in_flight() {
+    memset(received, 0, sizeof received);
+    Node &node = *nodes[0];
+    measure(node, SAMPLE_BUFFER_SIZE);
+    // the frame is on its way when the node samples on and drops its oldest
+    node.uploader.step((uint32_t) sim->now_ms, noClock);
+    node.uploader.step((uint32_t) sim->now_ms, noClock);
+    TEST_ASSERT_EQUAL(Uploader::AWAIT_RESPONSE, node.uploader.state());
+    measure(node, 3);
+    TEST_ASSERT_EQUAL(3, node.queue.dropped);
+    // the ack only removes what's left of the frame, the samples taken since go out next
+    run(1);
+    TEST_ASSERT_EQUAL(2, node.uploader.uploadsSucceeded);
+    TEST_ASSERT_EQUAL(SAMPLE_BUFFER_SIZE + 3, findNode(0)->samples);
+    assertAllReceived(1);
+}
+
+void test_queue_due_after_partial_forward() {
+    GatewayQueue &queue = gateway->queue;
+    queue.push(0xA00000, makeSample(1, 20, 50), 100);
+    queue.push(0xA00001, makeSample(2, 20, 50), 110);
+    queue.push(0xA00000, makeSample(3, 20, 50), 120);
+    TEST_ASSERT_EQUAL(100, queue.since_s);
+    TEST_ASSERT_FALSE(queue.due(159, 64, 60));
+    TEST_ASSERT_TRUE(queue.due(160, 64, 60));
+    TEST_ASSERT_TRUE(queue.due(120, 3, 60));
+
+    // the rest waits from when the others went out, not from when the first came in
+    queue.drop(1, 200);
+    TEST_ASSERT_EQUAL(200, queue.since_s);
+    TEST_ASSERT_FALSE(queue.due(259, 64, 60));
+    TEST_ASSERT_TRUE(queue.due(260, 64, 60));
+    // emptied, the next sample starts it
+    queue.drop(2, 300);
+    TEST_ASSERT_FALSE(queue.due(1000, 64, 60));
+    queue.push(0xA00000, makeSample(4, 20, 50), 400);
+    TEST_ASSERT_EQUAL(400, queue.since_s);
+
+    // a request of the forwarder that only takes some of them
+    queue.drop(queue.size(), 400);
+    for(uint8_t i = 0; i < 10; i++) {
+        queue.push(0xA00000 + i, makeSample(i, 20, 50), 500 + i);
+    }
+    SimTransport server;
+    TEST_ASSERT_TRUE(server.toFile("-"));
+    char body[256];
+    GatewayForwarder forwarder(server, body, sizeof body, queue);
+    forwarder.setTarget("influx", 8086, "/write?db=climate", "climate");
+    ClockSync clock;
+    clock.clear();
+    clock.sync(0, 1700000000);
+    for(int steps = 0; steps < 1000 && (forwarder.uploadsSucceeded == 0 || !forwarder.idle()); steps++) {
+        forwarder.step((uint32_t) sim->now_ms, clock, gatewayClock());
+        sim->now_ms += STEP_MS;
+    }
+    TEST_ASSERT_EQUAL(1, forwarder.uploadsSucceeded);
+    TEST_ASSERT_TRUE(queue.size() > 0 && queue.size() < 10);
+    TEST_ASSERT_EQUAL(gatewayClock(), queue.since_s);
+    TEST_ASSERT_FALSE(queue.due(gatewayClock(), 64, 60));
+}
+
+int main() {
+    sim = &shared;
+    if(!gatewayLink.listen()) {
+        return 1;
+    }
+    UNITY_BEGIN();
+    RUN_TEST(test_many_nodes);
+    RUN_TEST(test_lossy_link);
+    RUN_TEST(test_duplicated_frames);
+    RUN_TEST(test_ack_timeout);
+    RUN_TEST(test_gateway_queue_full);
+    RUN_TEST(test_node_queue_overflows_in_flight);
+    RUN_TEST(test_queue_due_after_partial_forward);
+    return UNITY_END();
+}
@@ -0,0 +1,275 @@
+#include <unity.h>
+#include <string.h>
+#include "../../src/settingsjson.h"
+
+// JsonWriter and JsonReader on their own and as the /settings endpoint uses them: the settings
+// written and read back, \u escapes, the limits of nesting and length, and a POST body that only
+// has some of the settings
+
+// Collects what a writer hands over, in the chunks it does
+class BufferSink : public OutputSink {
+public:
+    void write(const char *data, size_t length) override {
+        TEST_ASSERT_TRUE(length + this->length < sizeof text);
+        memcpy(text + this->length, data, length);
+        this->length += length;
+        text[this->length] = 0;
+        writes++;
+    }
+
+    char text[2048];
+    size_t length = 0;
+    unsigned writes = 0;
+};
+
+// Remembers the last value and the paths it came across
+class RecordingHandler : public JsonHandler {
+public:
+    bool value(const char *path, const char *value, bool quoted) override {
+        strncpy(lastPath, path, sizeof lastPath - 1);
+        strncpy(lastValue, value, sizeof lastValue - 1);
+        lastQuoted = quoted;
+        values++;
+        return true;
+    }
+
+    char lastPath[JSON_PATH_SIZE] = "";
+    char lastValue[JSON_TOKEN_SIZE] = "";
+    bool lastQuoted = false;
+    unsigned values = 0;
+};
+
+RecordingHandler recorder;
+struct_settings current;
+
+void setUp() {
+    recorder = RecordingHandler();
+    defaultSettings(current);
+}
+
+void tearDown() {
+}
+
+// Reads json with recorder, returns the reader's error or NULL
+const char *readAll(const char *json) {
+    static JsonReader *reader = NULL;
+    delete reader;
+    reader = new JsonReader(recorder);
+    reader->feed(json, strlen(json));
+    reader->finish();
+    return reader->error;
+}
+
+// Applies a POST body to current the way http_handleSettings() does, returns the error it would
+// respond with or NULL
+const char *post(const char *body) {
+    static char error[JSON_PATH_SIZE + 24];
+    struct_settings update = current;
+    SettingsJsonParser parser(update);
+    JsonReader reader(parser);
+    reader.feed(body, strlen(body));
+    if(!reader.finish()) {
+        strcpy(error, parser.error[0] ? parser.error : reader.error);
+        return error;
+    }
+    if(!parser.validate()) {
+        strcpy(error, parser.error);
+        return error;
+    }
+    current = update;
+    return NULL;
+}
+
+void test_settings_round_trip() {
+    struct_settings s;
+    defaultSettings(s);
+    s.influxEnabled = true;
+    // quotes, backslashes and a control character need escaping
+    strcpy(s.influxHost, "influx.local");
+    strcpy(s.influxDatabase, "weather");
+    strcpy(s.influxTags, "name=\"Living room\",path=C:\\home\tx");
+    s.influxPort = 65535;
+    s.deepSleepTimer = 30;
+    s.deepSleepMaxTimer = 3600;
+    s.lowPowerContrast = (char) 200;
+    s.batchSize = SAMPLE_BUFFER_SIZE;
+    s.sensorRepeatability = SENSOR_REPEATABILITY_LOW;
+    s.sensorHeater = true;
+    s.filterMode = FILTER_EMA;
+    s.filterWindow = FILTER_WINDOW_MAX;
+    s.uploadProtocol = UPLOAD_MQTT;
+    strcpy(s.mqttHost, "broker");
+    strcpy(s.mqttTopic, "climate/{id}/{series}");
+    s.mqttQos = 0;
+    s.mqttRetain = false;
+
+    BufferSink sink;
+    JsonWriter json(sink);
+    writeSettingsJson(json, s);
+    json.flush();
+    TEST_ASSERT_EQUAL(sink.length, json.written);
+    // through the writer's buffer several times
+    TEST_ASSERT_TRUE(sink.writes > 1);
+    TEST_ASSERT_NOT_NULL(strstr(sink.text, "\"tags\":\"name=\\\"Living room\\\",path=C:\\\\home\\u0009x\""));
+
+    TEST_ASSERT_NULL(post(sink.text));
+    TEST_ASSERT_EQUAL_MEMORY(&s, &current, sizeof current);
+}
+
+void test_writer_escapes_control_characters() {
+    BufferSink sink;
+    JsonWriter json(sink);
+    json.beginObject();
+    json.string("a", "\x01\n");
+    json.number("b", -12);
+    json.boolean("c", false);
+    json.beginObject("d");
+    json.endObject();
+    json.endObject();
+    json.flush();
+    TEST_ASSERT_EQUAL_STRING("{\"a\":\"\\u0001\\u000a\",\"b\":-12,\"c\":false,\"d\":{}}", sink.text);
+}
+
+void test_reader_paths() {
+    TEST_ASSERT_NULL(readAll(" { \"influx\" : { \"port\" : 8086 } , \"x\" : true }\n"));
+    TEST_ASSERT_EQUAL(2, recorder.values);
+    TEST_ASSERT_EQUAL_STRING("x", recorder.lastPath);
+    TEST_ASSERT_EQUAL_STRING("true", recorder.lastValue);
+    TEST_ASSERT_FALSE(recorder.lastQuoted);
+    TEST_ASSERT_NULL(readAll("{\"a\":{\"b\":\"c\"}}"));
+    TEST_ASSERT_EQUAL_STRING("a.b", recorder.lastPath);
+    TEST_ASSERT_TRUE(recorder.lastQuoted);
+}
+
+void test_unicode_escapes() {
+    // one, two and three bytes of UTF-8, in either case
+    TEST_ASSERT_NULL(readAll("{\"s\":\"\\u0041\\u00e9\\u20AC\"}"));
+    TEST_ASSERT_EQUAL_STRING("A\xc3\xa9\xe2\x82\xac", recorder.lastValue);
+    TEST_ASSERT_NULL(readAll("{\"s\":\"\\u0009\\/\\\"\\\\\\b\\f\\n\\r\\t\"}"));
+    TEST_ASSERT_EQUAL_STRING("\t/\"\\\b\f\n\r\t", recorder.lastValue);
+    // escapes in keys too
+    TEST_ASSERT_NULL(readAll("{\"\\u0061\":1}"));
+    TEST_ASSERT_EQUAL_STRING("a", recorder.lastPath);
+
+    TEST_ASSERT_EQUAL_STRING("Invalid escape", readAll("{\"s\":\"\\u00g1\"}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid escape", readAll("{\"s\":\"\\x\"}"));
+    TEST_ASSERT_EQUAL_STRING("Unexpected end", readAll("{\"s\":\"\\u00"));
+    TEST_ASSERT_EQUAL_STRING("Control character in string", readAll("{\"s\":\"a\nb\"}"));
+}
+
+void test_depth_limit() {
+    // the outermost object counts
+    TEST_ASSERT_NULL(readAll("{\"a\":{\"b\":{\"c\":{\"d\":1}}}}"));
+    TEST_ASSERT_EQUAL_STRING("a.b.c.d", recorder.lastPath);
+    recorder = RecordingHandler();
+    TEST_ASSERT_EQUAL_STRING("Nested too deep", readAll("{\"a\":{\"b\":{\"c\":{\"d\":{\"e\":1}}}}}"));
+    TEST_ASSERT_EQUAL(0, recorder.values);
+}
+
+void test_length_limits() {
+    char json[2 * JSON_TOKEN_SIZE];
+    char value[JSON_TOKEN_SIZE + 1];
+    memset(value, 'v', JSON_TOKEN_SIZE - 1);
+    value[JSON_TOKEN_SIZE - 1] = 0;
+    snprintf(json, sizeof json, "{\"s\":\"%s\"}", value);
+    TEST_ASSERT_NULL(readAll(json));
+    TEST_ASSERT_EQUAL(JSON_TOKEN_SIZE - 1, strlen(recorder.lastValue));
+    value[JSON_TOKEN_SIZE - 1] = 'v';
+    value[JSON_TOKEN_SIZE] = 0;
+    snprintf(json, sizeof json, "{\"s\":\"%s\"}", value);
+    TEST_ASSERT_EQUAL_STRING("Value too long", readAll(json));
+    // numbers are tokens as well
+    snprintf(json, sizeof json, "{\"n\":1%s}", "000000000000000000000000000000000000000000000000000000000000000000000000");
+    TEST_ASSERT_EQUAL_STRING("Value too long", readAll(json));
+
+    // the path of a key and the objects around it
+    char key[JSON_PATH_SIZE];
+    memset(key, 'k', sizeof key - 3);
+    key[sizeof key - 3] = 0;
+    snprintf(json, sizeof json, "{\"a\":{\"%s\":1}}", key);
+    TEST_ASSERT_NULL(readAll(json));
+    TEST_ASSERT_EQUAL(JSON_PATH_SIZE - 1, strlen(recorder.lastPath));
+    snprintf(json, sizeof json, "{\"ab\":{\"%s\":1}}", key);
+    TEST_ASSERT_EQUAL_STRING("Key too long", readAll(json));
+}
+
+void test_malformed() {
+    TEST_ASSERT_EQUAL_STRING("Expected an object", readAll("[]"));
+    TEST_ASSERT_EQUAL_STRING("Arrays aren't supported", readAll("{\"a\":[1]}"));
+    TEST_ASSERT_EQUAL_STRING("Expected ':'", readAll("{\"a\" 1}"));
+    TEST_ASSERT_EQUAL_STRING("Expected a key", readAll("{\"a\":1,}"));
+    TEST_ASSERT_EQUAL_STRING("Expected ',' or '}'", readAll("{\"a\":1 \"b\":2}"));
+    TEST_ASSERT_EQUAL_STRING("Trailing characters", readAll("{}{}"));
+    TEST_ASSERT_EQUAL_STRING("Unexpected end", readAll("{\"a\":{\"b\":1}"));
+    TEST_ASSERT_EQUAL_STRING("Unexpected end", readAll(""));
+}
+
+void test_partial_body_keeps_the_rest() {
+    current.batchSize = 5;
+    current.deepSleepTimer = 20;
+    strcpy(current.influxHost, "influx.local");
+    struct_settings before = current;
+    // the body of a client from before batchSize existed
+    TEST_ASSERT_NULL(post("{\"lowpower\":{\"updateInterval\":60,\"contrast\":10}}"));
+    TEST_ASSERT_EQUAL(60, current.deepSleepTimer);
+    TEST_ASSERT_EQUAL(10, current.lowPowerContrast);
+    TEST_ASSERT_EQUAL(5, current.batchSize);
+    TEST_ASSERT_EQUAL(before.batchMaxAge, current.batchMaxAge);
+    TEST_ASSERT_EQUAL_STRING("influx.local", current.influxHost);
+    TEST_ASSERT_EQUAL(before.filterMode, current.filterMode);
+
+    // an empty one changes nothing, unknown settings are ignored
+    before = current;
+    TEST_ASSERT_NULL(post("{}"));
+    TEST_ASSERT_NULL(post("{\"future\":{\"setting\":1},\"lowpower\":{\"later\":\"x\"}}"));
+    TEST_ASSERT_EQUAL_MEMORY(&before, &current, sizeof current);
+}
+
+void test_invalid_body_changes_nothing() {
+    struct_settings before = current;
+    TEST_ASSERT_EQUAL_STRING("Invalid value for lowpower.batchSize", post("{\"lowpower\":{\"updateInterval\":60,\"batchSize\":0}}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid value for influx.port", post("{\"influx\":{\"port\":65536}}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid value for influx.port", post("{\"influx\":{\"port\":\"8086\"}}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid value for influx.enabled", post("{\"influx\":{\"enabled\":1}}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid value for filter.mode", post("{\"filter\":{\"mode\":\"mean\"}}"));
+    TEST_ASSERT_EQUAL_STRING("Invalid value for lowpower.updateInterval", post("{\"lowpower\":{\"updateInterval\":1.5}}"));
+    // cut short after a value that was fine
+    TEST_ASSERT_EQUAL_STRING("Unexpected end", post("{\"lowpower\":{\"updateInterval\":60}"));
+    // a string as long as the field has no room for its zero
+    char body[128];
+    char host[sizeof current.influxHost + 1];
+    memset(host, 'h', sizeof current.influxHost);
+    host[sizeof current.influxHost] = 0;
+    snprintf(body, sizeof body, "{\"influx\":{\"host\":\"%s\"}}", host);
+    TEST_ASSERT_EQUAL_STRING("Invalid value for influx.host", post(body));
+    host[sizeof current.influxHost - 1] = 0;
+    snprintf(body, sizeof body, "{\"influx\":{\"host\":\"%s\"}}", host);
+    TEST_ASSERT_NULL(post(body));
+    TEST_ASSERT_EQUAL_STRING(host, current.influxHost);
+    memset(current.influxHost, 0, sizeof current.influxHost);
+    TEST_ASSERT_EQUAL_MEMORY(&before, &current, sizeof current);
+}
+
+void test_validation_across_settings() {
+    TEST_ASSERT_EQUAL_STRING("Influx enabled but not enough details provided", post("{\"influx\":{\"enabled\":true}}"));
+    TEST_ASSERT_FALSE(current.influxEnabled);
+    TEST_ASSERT_NULL(post("{\"influx\":{\"enabled\":true,\"host\":\"h\",\"database\":\"d\"}}"));
+    TEST_ASSERT_TRUE(current.influxEnabled);
+    TEST_ASSERT_EQUAL_STRING("MQTT topic can't contain + or #", post("{\"mqtt\":{\"topic\":\"climate/+\"}}"));
+    TEST_ASSERT_EQUAL_STRING("A gateway can't upload through a gateway", post("{\"upload\":{\"protocol\":\"gateway\"},\"gateway\":{\"enabled\":true}}"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_settings_round_trip);
+    RUN_TEST(test_writer_escapes_control_characters);
+    RUN_TEST(test_reader_paths);
+    RUN_TEST(test_unicode_escapes);
+    RUN_TEST(test_depth_limit);
+    RUN_TEST(test_length_limits);
+    RUN_TEST(test_malformed);
+    RUN_TEST(test_partial_body_keeps_the_rest);
+    RUN_TEST(test_invalid_body_changes_nothing);
+    RUN_TEST(test_validation_across_settings);
+    return UNITY_END();
+}
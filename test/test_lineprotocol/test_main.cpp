@@ -0,0 +1,251 @@
+#include <unity.h>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/lineprotocol.h"
+#include "../../src/samples.h"
+
+// Compares LineProtocolWriter with the String concatenation it replaced, as syncInflux() did it
+// before: the same payload, the heap it takes and the time per batch. The board isn't at hand
+// here, so the old path runs on ModelString, which uses the heap the way String of the ESP8266
+// core does: strings up to 11 characters inline, longer ones in a buffer of exactly their size
+// that every concat() reallocates, and "literal" + String building a temporary.
+
+#define BENCH_BATCH SAMPLE_BUFFER_SIZE
+#define BENCH_ROUNDS 2000
+#define BENCH_SSO 11
+
+struct HeapUse {
+    unsigned long allocations;
+    size_t current;
+    size_t peak;
+};
+
+HeapUse modelHeap;
+unsigned long globalAllocations = 0;
+
+void *operator new(size_t size) {
+    globalAllocations++;
+    void *p = malloc(size);
+    if(p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+class ModelString {
+public:
+    ModelString(const char *s = "") {
+        append(s, strlen(s));
+    }
+
+    // rounds halves away from zero like dtostrf() of the core, where printf() rounds them to even
+    ModelString(float value, uint8_t decimals) {
+        long scale = 1;
+        for(uint8_t i = 0; i < decimals; i++) {
+            scale *= 10;
+        }
+        long scaled = lroundf(value * scale);
+        char digits[33];
+        if(decimals == 0) {
+            snprintf(digits, sizeof digits, "%ld", scaled);
+        } else {
+            snprintf(digits, sizeof digits, "%s%ld.%0*ld", scaled < 0 ? "-" : "", labs(scaled) / scale, decimals, labs(scaled) % scale);
+        }
+        append(digits, strlen(digits));
+    }
+
+    explicit ModelString(unsigned long value) {
+        char digits[12];
+        snprintf(digits, sizeof digits, "%lu", value);
+        append(digits, strlen(digits));
+    }
+
+    ModelString(const ModelString &other) {
+        append(other.c_str(), other.len);
+    }
+
+    ModelString(ModelString &&other) : heap(other.heap), capacity(other.capacity), len(other.len) {
+        memcpy(inline_, other.inline_, sizeof inline_);
+        other.heap = NULL;
+        other.capacity = BENCH_SSO;
+        other.len = 0;
+    }
+
+    ~ModelString() {
+        if(heap != NULL) {
+            modelHeap.current -= capacity + 1;
+            free(heap);
+        }
+    }
+
+    ModelString &operator+=(const ModelString &other) {
+        append(other.c_str(), other.len);
+        return *this;
+    }
+
+    ModelString &operator+=(const char *s) {
+        append(s, strlen(s));
+        return *this;
+    }
+
+    void reserve(size_t size) {
+        if(size <= capacity) {
+            return;
+        }
+        char *grown = (char *) realloc(heap, size + 1);
+        if(heap == NULL) {
+            memcpy(grown, inline_, len + 1);
+        } else {
+            modelHeap.current -= capacity + 1;
+        }
+        heap = grown;
+        capacity = size;
+        modelHeap.allocations++;
+        modelHeap.current += capacity + 1;
+        if(modelHeap.current > modelHeap.peak) {
+            modelHeap.peak = modelHeap.current;
+        }
+    }
+
+    const char *c_str() const {
+        return heap != NULL ? heap : inline_;
+    }
+
+    size_t length() const {
+        return len;
+    }
+
+private:
+    void append(const char *s, size_t n) {
+        reserve(len + n);
+        char *data = heap != NULL ? heap : inline_;
+        memcpy(data + len, s, n);
+        len += n;
+        data[len] = 0;
+    }
+
+    char *heap = NULL;
+    char inline_[BENCH_SSO + 1] = "";
+    size_t capacity = BENCH_SSO;
+    size_t len = 0;
+};
+
+ModelString operator+(ModelString lhs, const ModelString &rhs) {
+    lhs += rhs;
+    return lhs;
+}
+
+ModelString operator+(ModelString lhs, const char *rhs) {
+    lhs += rhs;
+    return lhs;
+}
+
+ModelString operator+(const char *lhs, const ModelString &rhs) {
+    return ModelString(lhs) + rhs;
+}
+
+SampleBuffer samples;
+const char *series = "climate";
+const char *tags = "room=office";
+const long clockOffset = 1700000000;
+char buffer[2048];
+
+void setUp() {
+    samples.clear();
+    for(uint8_t i = 0; i < BENCH_BATCH; i++) {
+        samples.push(makeSample(300 * i, 21.37f - i * 0.13f, 45.5f + i * 0.6f));
+    }
+}
+
+void tearDown() {
+}
+
+// the loop of syncInflux() before the writer
+ModelString encodeWithString() {
+    ModelString prefix(series);
+    prefix += "," + ModelString(tags);
+    ModelString payload;
+    payload.reserve(samples.size() * (prefix.length() + 48));
+    for(uint8_t i = 0; i < samples.size(); i++) {
+        const Sample &sample = samples.at(i);
+        payload += prefix + " temperature_C=" + ModelString(sampleTemperature(sample), 1) + ",humidity=" + ModelString(sampleHumidity(sample), 0);
+        payload += " " + ModelString((unsigned long) (sample.timestamp_s + clockOffset));
+        payload += "\n";
+    }
+    return payload;
+}
+
+size_t encodeWithWriter() {
+    char prefix[64];
+    buildLineProtocolPrefix(prefix, sizeof prefix, series, tags);
+    LineProtocolWriter writer(buffer, sizeof buffer);
+    for(uint8_t i = 0; i < samples.size(); i++) {
+        const Sample &sample = samples.at(i);
+        writer.beginLine(prefix);
+        writer.field("temperature_C", sampleTemperature(sample), 1);
+        writer.field("humidity", sampleHumidity(sample), 0);
+        writer.timestamp(sample.timestamp_s + clockOffset);
+        writer.endLine();
+    }
+    return writer.length();
+}
+
+template<typename F> double nanosecondsPerBatch(F encode) {
+    auto start = std::chrono::steady_clock::now();
+    for(int round = 0; round < BENCH_ROUNDS; round++) {
+        encode();
+    }
+    std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+    return took.count() / BENCH_ROUNDS;
+}
+
+void test_same_payload() {
+    ModelString expected = encodeWithString();
+    size_t length = encodeWithWriter();
+    TEST_ASSERT_EQUAL_size_t(expected.length(), length);
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), buffer);
+}
+
+void test_writer_leaves_the_heap_alone() {
+    unsigned long before = globalAllocations;
+    encodeWithWriter();
+    TEST_ASSERT_EQUAL(0, globalAllocations - before);
+}
+
+void test_compare() {
+    modelHeap = {};
+    encodeWithString();
+    HeapUse string = modelHeap;
+    double stringTime = nanosecondsPerBatch(encodeWithString);
+    double writerTime = nanosecondsPerBatch(encodeWithWriter);
+
+    char report[160];
+    snprintf(report, sizeof report, "String: %lu allocations, %u bytes peak, %.0f ns per batch of %u",
+        string.allocations, (unsigned) string.peak, stringTime, BENCH_BATCH);
+    TEST_MESSAGE(report);
+    snprintf(report, sizeof report, "LineProtocolWriter: 0 allocations, %u bytes static, %.0f ns per batch of %u",
+        (unsigned) sizeof buffer, writerTime, BENCH_BATCH);
+    TEST_MESSAGE(report);
+    // every line takes several temporaries on the old path, the times are only reported as
+    // they depend on the host
+    TEST_ASSERT_GREATER_THAN(BENCH_BATCH * 4, string.allocations);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_same_payload);
+    RUN_TEST(test_writer_leaves_the_heap_alone);
+    RUN_TEST(test_compare);
+    return UNITY_END();
+}
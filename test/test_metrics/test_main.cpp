@@ -0,0 +1,246 @@
+#include <unity.h>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/metrics.h"
+#include "../../src/energy.h"
+
+// MetricsWriter: the exposition format it writes, and a page like the one http_metrics() serves
+// rendered over and over, for what a scrape costs. The sink copies what it's handed to memory, as
+// the time the board spends sending the chunks isn't the writer's.
+
+#define BENCH_ROUNDS 20000
+#define BENCH_TASKS 6
+
+unsigned long globalAllocations = 0;
+
+void *operator new(size_t size) {
+    globalAllocations++;
+    void *p = malloc(size);
+    if(p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+// Keeps what it's handed, up to its size
+class BufferSink : public OutputSink {
+public:
+    void write(const char *data, size_t length) override {
+        if(this->length + length < sizeof text) {
+            memcpy(text + this->length, data, length);
+            text[this->length + length] = 0;
+        }
+        this->length += length;
+        writes++;
+    }
+
+    void clear() {
+        length = 0;
+        writes = 0;
+        text[0] = 0;
+    }
+
+    char text[8192] = "";
+    size_t length = 0;
+    unsigned writes = 0;
+};
+
+// What http_metrics() reads from the station, with the values of a station up for a while
+struct Station {
+    float temperature_C = 21.37f;
+    float humidity_pct = 45.5f;
+    float readingAge_s = 4;
+    unsigned long uploadsSucceeded = 12345;
+    unsigned long uploadsFailed = 17;
+    unsigned long samplesRejected = 0;
+    unsigned long samplesDropped = 3;
+    long queued = 7;
+    long spooled = 0;
+    float rssi_dbm = -67;
+    long heapFree = 31000;
+    long heapMaxBlock = 18000;
+    long heapFragmentation = 12;
+    const char *taskNames[BENCH_TASKS] = { "sensor", "gateway", "http", "display", "sample", "upload" };
+    unsigned long taskRuns = 4000000;
+    uint64_t taskBusy_us = 123456789;
+    uint32_t taskMax_us = 2345;
+    uint32_t taskLate_us = 120;
+    unsigned long taskMissed = 2;
+    uint64_t idle_us = 3456789012ULL;
+    uint64_t uptime_ms = 3600000;
+    uint64_t phase_ms[ENERGY_PHASES] = { 1200, 3400, 560000, 78000, 90000, 86400000 };
+};
+
+Station station;
+BufferSink sink;
+
+// the page of http_metrics()
+void renderPage(OutputSink &out) {
+    MetricsWriter metrics(out);
+    metrics.gauge("climate_temperature_celsius", "Last reported temperature", station.temperature_C, 2);
+    metrics.gauge("climate_humidity_percent", "Last reported relative humidity", station.humidity_pct, 2);
+    metrics.gauge("climate_reading_age_seconds", "Time since the last successful sensor reading", station.readingAge_s, 0);
+    metrics.counter("climate_influx_uploads_succeeded_total", "Uploads the server accepted", station.uploadsSucceeded);
+    metrics.counter("climate_influx_uploads_failed_total", "Uploads that failed or were refused", station.uploadsFailed);
+    metrics.counter("climate_influx_samples_rejected_total", "Samples the server refused for good", station.samplesRejected);
+    metrics.counter("climate_influx_samples_dropped_total", "Samples dropped from the full queue", station.samplesDropped);
+    metrics.gauge("climate_influx_queue_samples", "Samples waiting for upload in RTC memory", station.queued);
+    metrics.gauge("climate_spool_samples", "Samples waiting for upload on flash", station.spooled);
+    metrics.gauge("climate_wifi_rssi_dbm", "Signal strength of the access point", station.rssi_dbm, 0);
+    metrics.gauge("climate_heap_free_bytes", "Free heap", station.heapFree);
+    metrics.gauge("climate_heap_max_block_bytes", "Largest block the heap can allocate", station.heapMaxBlock);
+    metrics.gauge("climate_heap_fragmentation_percent", "Heap fragmentation", station.heapFragmentation);
+    metrics.begin("climate_task_runs_total", "counter", "Runs of each scheduled task");
+    for(uint8_t i = 0; i < BENCH_TASKS; i++) {
+        metrics.integer((long) station.taskRuns, "task", station.taskNames[i]);
+    }
+    metrics.begin("climate_task_seconds_total", "counter", "Time spent running each task");
+    for(uint8_t i = 0; i < BENCH_TASKS; i++) {
+        metrics.milliseconds(station.taskBusy_us / 1000, "task", station.taskNames[i]);
+    }
+    metrics.begin("climate_task_max_seconds", "gauge", "Longest run of each task since the previous scrape");
+    for(uint8_t i = 0; i < BENCH_TASKS; i++) {
+        metrics.real(station.taskMax_us / 1e6f, 6, "task", station.taskNames[i]);
+    }
+    metrics.begin("climate_task_late_max_seconds", "gauge", "Latest start of each task after it was due since the previous scrape");
+    for(uint8_t i = 0; i < BENCH_TASKS; i++) {
+        metrics.real(station.taskLate_us / 1e6f, 6, "task", station.taskNames[i]);
+    }
+    metrics.begin("climate_task_deadline_missed_total", "counter", "Runs that started later than the task's deadline");
+    for(uint8_t i = 0; i < BENCH_TASKS; i++) {
+        metrics.integer((long) station.taskMissed, "task", station.taskNames[i]);
+    }
+    metrics.begin("climate_idle_seconds_total", "counter", "Time no task was due");
+    metrics.milliseconds(station.idle_us / 1000);
+    metrics.begin("climate_uptime_seconds", "gauge", "Time since boot");
+    metrics.milliseconds(station.uptime_ms);
+    metrics.begin("climate_phase_seconds_total", "counter", "Time spent in each energy phase since the estimate was reset");
+    for(uint8_t phase = 0; phase < ENERGY_PHASES; phase++) {
+        metrics.milliseconds(station.phase_ms[phase], "phase", energyPhaseName(phase));
+    }
+    metrics.flush();
+}
+
+int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return x < y ? -1 : x > y;
+}
+
+void setUp() {
+    sink.clear();
+}
+
+void tearDown() {
+}
+
+void test_gauge_and_counter() {
+    MetricsWriter metrics(sink);
+    metrics.gauge("t", "Temp", 21.375f, 2);
+    metrics.counter("n_total", "Count", 4000000000UL);
+    metrics.flush();
+    TEST_ASSERT_EQUAL_STRING(
+        "# HELP t Temp\n# TYPE t gauge\nt 21.38\n"
+        "# HELP n_total Count\n# TYPE n_total counter\nn_total 4000000000\n", sink.text);
+    TEST_ASSERT_EQUAL(sink.length, metrics.written);
+}
+
+void test_reals() {
+    MetricsWriter metrics(sink);
+    metrics.begin("r", "gauge", "R");
+    metrics.real(-0.05f, 2);
+    metrics.real(0.000123f, 6);
+    metrics.real(3.7f, 0);
+    metrics.real(NAN, 2);
+    metrics.real(-1.5f, 1);
+    metrics.flush();
+    TEST_ASSERT_EQUAL_STRING("# HELP r R\n# TYPE r gauge\nr -0.05\nr 0.000123\nr 4\nr NaN\nr -1.5\n", sink.text);
+}
+
+void test_integers_and_milliseconds() {
+    MetricsWriter metrics(sink);
+    metrics.begin("i", "gauge", "I");
+    metrics.integer(0);
+    metrics.integer(-67);
+    metrics.milliseconds(5);
+    metrics.milliseconds(86400123);
+    // more than 49 days, past what a 32 bit millisecond count holds
+    metrics.milliseconds(5000000000ULL);
+    metrics.flush();
+    TEST_ASSERT_EQUAL_STRING("# HELP i I\n# TYPE i gauge\ni 0\ni -67\ni 0.005\ni 86400.123\ni 5000000.000\n", sink.text);
+}
+
+void test_label_escaping() {
+    MetricsWriter metrics(sink);
+    metrics.begin("l", "gauge", "L");
+    metrics.integer(1, "task", "a\"b\\c");
+    metrics.flush();
+    TEST_ASSERT_EQUAL_STRING("# HELP l L\n# TYPE l gauge\nl{task=\"a\\\"b\\\\c\"} 1\n", sink.text);
+}
+
+void test_page_in_buffer_chunks() {
+    renderPage(sink);
+    // the page doesn't fit the buffer, every chunk but the last is a full one
+    TEST_ASSERT_EQUAL((sink.length + METRICS_BUFFER - 1) / METRICS_BUFFER, sink.writes);
+    TEST_ASSERT_EQUAL('\n', sink.text[sink.length - 1]);
+    TEST_ASSERT_NOT_NULL(strstr(sink.text, "climate_task_max_seconds{task=\"gateway\"} 0.002345\n"));
+    TEST_ASSERT_NOT_NULL(strstr(sink.text, "climate_phase_seconds_total{phase=\"sleep\"} 86400.000\n"));
+    // every line is a comment or a name and a value
+    unsigned lines = 0;
+    for(char *line = sink.text; *line; line = strchr(line, '\n') + 1) {
+        TEST_ASSERT_TRUE(line[0] == '#' || strncmp(line, "climate_", 8) == 0);
+        TEST_ASSERT_NOT_NULL(strchr(line, ' '));
+        lines++;
+    }
+    // 21 metrics with a HELP and a TYPE line each, 13 of them with a single sample
+    TEST_ASSERT_EQUAL(2 * 21 + 13 + 5 * BENCH_TASKS + 2 + ENERGY_PHASES, lines);
+}
+
+void test_repeated_renders() {
+    static char first[sizeof sink.text];
+    renderPage(sink);
+    strcpy(first, sink.text);
+    size_t length = sink.length;
+
+    static double took_ns[BENCH_ROUNDS];
+    unsigned long allocations = globalAllocations;
+    for(int round = 0; round < BENCH_ROUNDS; round++) {
+        sink.clear();
+        auto before = std::chrono::steady_clock::now();
+        renderPage(sink);
+        std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - before;
+        took_ns[round] = took.count();
+    }
+    TEST_ASSERT_EQUAL(0, globalAllocations - allocations);
+    // the writer keeps nothing from one scrape to the next
+    TEST_ASSERT_EQUAL_size_t(length, sink.length);
+    TEST_ASSERT_EQUAL_STRING(first, sink.text);
+
+    // the host preempts the odd round, the percentiles leave that out
+    qsort(took_ns, BENCH_ROUNDS, sizeof took_ns[0], compareDoubles);
+    char report[160];
+    snprintf(report, sizeof report, "%u bytes in %u chunks, %.0f ns per scrape, %.0f ns at the 99th percentile, 0 allocations, %u bytes of stack",
+        (unsigned) length, sink.writes, took_ns[BENCH_ROUNDS / 2], took_ns[BENCH_ROUNDS * 99 / 100], (unsigned) sizeof(MetricsWriter));
+    TEST_MESSAGE(report);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gauge_and_counter);
+    RUN_TEST(test_reals);
+    RUN_TEST(test_integers_and_milliseconds);
+    RUN_TEST(test_label_escaping);
+    RUN_TEST(test_page_in_buffer_chunks);
+    RUN_TEST(test_repeated_renders);
+    return UNITY_END();
+}
@@ -0,0 +1,465 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "../../src/sim/transport_sim.h"
+
+// MqttUploader against the simulator's broker: the CONNECT and PUBLISH packets it writes, QoS 1
+// samples only leaving the queue once every PUBACK is in, and what happens when the broker drops
+// the connection. The packets go to a file as well, which the tests read back. PUBACKs only
+// release the publishes they name, and the unacknowledged ones are sent again with DUP set
+// when the connection is back.
+
+#define CLIENT_ID "station-5137a1"
+#define TOPIC "climate/5137a1"
+#define UNIX_BASE 1700000000u
+
+SimShared shared;
+SimTransport transport;
+
+// The broker's side with packets of the test's own ahead of what the simulator answers
+class InjectingTransport : public UploadTransport {
+public:
+    bool connect(const char *host, uint16_t port) override {
+        return transport.connect(host, port);
+    }
+
+    bool connected() override {
+        return transport.connected();
+    }
+
+    size_t write(const uint8_t *data, size_t length) override {
+        return transport.write(data, length);
+    }
+
+    int available() override {
+        return injectedLength - injectedRead + transport.available();
+    }
+
+    int read() override {
+        return injectedRead < injectedLength ? injected[injectedRead++] : transport.read();
+    }
+
+    void stop() override {
+        transport.stop();
+    }
+
+    void inject(const uint8_t *data, size_t length) {
+        memcpy(injected + injectedLength, data, length);
+        injectedLength += length;
+    }
+
+    void puback(uint16_t packetId) {
+        const uint8_t packet[] = { MQTT_PUBACK, 2, (uint8_t) (packetId >> 8), (uint8_t) (packetId & 0xFF) };
+        inject(packet, sizeof packet);
+    }
+
+    void clear() {
+        injectedLength = injectedRead = 0;
+    }
+
+private:
+    uint8_t injected[64];
+    size_t injectedLength = 0;
+    size_t injectedRead = 0;
+};
+
+InjectingTransport broker;
+char sentPath[] = "/tmp/test-mqtt-XXXXXX";
+char payload[1024];
+MqttUploader *uploader;
+SampleBuffer queue;
+ClockSync stationClock;
+
+uint8_t sent[4096];
+size_t sentLength;
+
+void setUp() {
+    memset(&shared, 0, sizeof shared);
+    sim = &shared;
+    transport.stop();
+    transport.setOutage(0, 0);
+    broker.clear();
+    TEST_ASSERT_EQUAL(0, truncate(sentPath, 0));
+    uploader = new MqttUploader(broker, payload, sizeof payload);
+    queue.clear();
+    uploader->setQueue(queue);
+    uploader->setTarget("broker", 1883, CLIENT_ID, TOPIC, "climate", 1, true);
+    stationClock.clear();
+    stationClock.sync(0, UNIX_BASE);
+}
+
+void tearDown() {
+    delete uploader;
+}
+
+void queueSamples(uint8_t n) {
+    for(uint8_t i = 0; i < n; i++) {
+        queue.push(makeSample(i, 20 + i * 0.1f, 50));
+    }
+}
+
+// steps until the uploader is idle or backing off again, at 1 ms of simulated time per step
+void runUpload() {
+    for(int steps = 0; steps < 100000; steps++) {
+        uploader->step((uint32_t) sim->now_ms, stationClock);
+        sim->now_ms++;
+        if(uploader->idle() || uploader->state() == Uploader::BACKOFF) {
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("upload didn't finish");
+}
+
+// steps until the uploader waits for the broker
+void runUntilAwaiting(uint8_t skip = 0) {
+    for(int steps = 0; steps < 1000; steps++) {
+        uploader->step((uint32_t) sim->now_ms, stationClock);
+        sim->now_ms++;
+        if(uploader->state() == Uploader::AWAIT_RESPONSE && skip-- == 0) {
+            return;
+        }
+    }
+    TEST_FAIL_MESSAGE("never awaited the broker");
+}
+
+// reads back what was written to the broker so far
+void readSent() {
+    FILE *file = fopen(sentPath, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    sentLength = fread(sent, 1, sizeof sent, file);
+    fclose(file);
+}
+
+// the line protocol the sample at station time i is published as
+size_t expectedLine(char *line, size_t size, uint8_t i) {
+    return snprintf(line, size, "climate temperature_C=%.1f,humidity=50 %u", 20 + i * 0.1f, UNIX_BASE + i);
+}
+
+// Checks the PUBLISH at sent + at and moves at past it
+void assertPublish(size_t &at, uint8_t i, uint8_t flags, uint16_t packetId) {
+    char line[128];
+    size_t lineLength = expectedLine(line, sizeof line, i);
+    size_t remaining = 2 + strlen(TOPIC) + (packetId != 0 ? 2 : 0) + lineLength;
+    TEST_ASSERT_TRUE(remaining < 128);
+    TEST_ASSERT_EQUAL_HEX8(MQTT_PUBLISH | flags, sent[at]);
+    TEST_ASSERT_EQUAL(remaining, sent[at + 1]);
+    TEST_ASSERT_EQUAL(0, sent[at + 2]);
+    TEST_ASSERT_EQUAL(strlen(TOPIC), sent[at + 3]);
+    TEST_ASSERT_EQUAL_MEMORY(TOPIC, sent + at + 4, strlen(TOPIC));
+    size_t body = at + 4 + strlen(TOPIC);
+    if(packetId != 0) {
+        TEST_ASSERT_EQUAL(packetId >> 8, sent[body]);
+        TEST_ASSERT_EQUAL(packetId & 0xFF, sent[body + 1]);
+        body += 2;
+    }
+    TEST_ASSERT_EQUAL_MEMORY(line, sent + body, lineLength);
+    at = body + lineLength;
+}
+
+// Checks the CONNECT the session starts with and moves at past it
+void assertConnect(size_t &at) {
+    const uint8_t expected[] = {
+        MQTT_CONNECT, 12 + sizeof CLIENT_ID - 1,
+        0, 4, 'M', 'Q', 'T', 'T', MQTT_PROTOCOL_LEVEL,
+        // no clean session, keep alive
+        0, 0, MQTT_KEEPALIVE_S,
+        0, sizeof CLIENT_ID - 1
+    };
+    TEST_ASSERT_EQUAL_MEMORY(expected, sent, sizeof expected);
+    TEST_ASSERT_EQUAL_MEMORY(CLIENT_ID, sent + sizeof expected, sizeof CLIENT_ID - 1);
+    at = sizeof expected + sizeof CLIENT_ID - 1;
+}
+
+void test_connect_and_publish_bytes() {
+    queueSamples(3);
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    assertPublish(at, 0, 1 << 1, 1);
+    assertPublish(at, 1, 1 << 1, 2);
+    // the newest live sample is retained
+    assertPublish(at, 2, 1 << 1 | MQTT_RETAIN, 3);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at);
+    TEST_ASSERT_EQUAL(3, uploader->messagesPublished);
+    TEST_ASSERT_EQUAL(3, sim->samplesAccepted);
+}
+
+void test_long_publish_takes_two_length_bytes() {
+    // a prefix long enough for a publish of more than 127 bytes
+    char prefix[128];
+    memset(prefix, 't', sizeof prefix);
+    memcpy(prefix, "climate,location=", 17);
+    prefix[100] = 0;
+    uploader->setTarget("broker", 1883, CLIENT_ID, TOPIC, prefix, 0, false);
+    queueSamples(1);
+    runUpload();
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    char line[160];
+    size_t lineLength = snprintf(line, sizeof line, "%s temperature_C=20.0,humidity=50 %u", prefix, UNIX_BASE);
+    size_t remaining = 2 + strlen(TOPIC) + lineLength;
+    TEST_ASSERT_TRUE(remaining >= 128);
+    TEST_ASSERT_EQUAL_HEX8(MQTT_PUBLISH, sent[at]);
+    TEST_ASSERT_EQUAL_HEX8(0x80 | (remaining & 0x7F), sent[at + 1]);
+    TEST_ASSERT_EQUAL(remaining >> 7, sent[at + 2]);
+    TEST_ASSERT_EQUAL_MEMORY(line, sent + at + 5 + strlen(TOPIC), lineLength);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at + 3 + remaining);
+}
+
+void test_qos0_is_done_once_sent() {
+    uploader->setTarget("broker", 1883, CLIENT_ID, TOPIC, "climate", 0, false);
+    queueSamples(2);
+    runUpload();
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    assertPublish(at, 0, 0, 0);
+    assertPublish(at, 1, 0, 0);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at);
+}
+
+void test_qos1_waits_for_every_puback() {
+    queueSamples(3);
+    // the CONNACK first, then the publishes
+    runUntilAwaiting(SIM_RTT_MS);
+    TEST_ASSERT_EQUAL(3, sim->requests);
+    // the broker's answers are still on their way
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(0, uploader->uploadsSucceeded);
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+    TEST_ASSERT_EQUAL(0, uploader->lastResult);
+}
+
+void test_session_is_reused() {
+    queueSamples(2);
+    runUpload();
+    queueSamples(2);
+    runUpload();
+    TEST_ASSERT_EQUAL(1, uploader->connectionsOpened);
+    TEST_ASSERT_EQUAL(1, uploader->connectionsReused);
+    TEST_ASSERT_EQUAL(2, uploader->uploadsSucceeded);
+    // packet ids go on where the session left off
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    assertPublish(at, 0, 1 << 1, 1);
+    assertPublish(at, 1, 1 << 1 | MQTT_RETAIN, 2);
+    assertPublish(at, 0, 1 << 1, 3);
+    assertPublish(at, 1, 1 << 1 | MQTT_RETAIN, 4);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at);
+}
+
+void test_keep_alive_pings() {
+    queueSamples(1);
+    runUpload();
+    readSent();
+    size_t before = sentLength;
+    sim->now_ms += MQTT_KEEPALIVE_S * 1000 / 2;
+    uploader->step((uint32_t) sim->now_ms, stationClock);
+    readSent();
+    TEST_ASSERT_EQUAL_size_t(before + 2, sentLength);
+    TEST_ASSERT_EQUAL_HEX8(MQTT_PINGREQ, sent[before]);
+    TEST_ASSERT_EQUAL(0, sent[before + 1]);
+}
+
+void test_retry_after_dropped_connection() {
+    queueSamples(2);
+    runUpload();
+    // the broker drops the session while the next publishes wait for their acks
+    queueSamples(2);
+    runUntilAwaiting();
+    transport.stop();
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(2, uploader->connectionsOpened);
+    TEST_ASSERT_EQUAL(1, uploader->connectionsReused);
+    TEST_ASSERT_EQUAL(2, uploader->uploadsSucceeded);
+    TEST_ASSERT_EQUAL(0, uploader->uploadsFailed);
+    // the same publishes again, after a CONNECT on the new connection
+    TEST_ASSERT_EQUAL(6, sim->requests);
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    assertPublish(at, 0, 1 << 1, 1);
+    assertPublish(at, 1, 1 << 1 | MQTT_RETAIN, 2);
+    assertPublish(at, 0, 1 << 1, 3);
+    assertPublish(at, 1, 1 << 1 | MQTT_RETAIN, 4);
+    size_t second = at;
+    assertConnect(at);
+    TEST_ASSERT_EQUAL_MEMORY(sent, sent + second, at);
+    at = second + at;
+    // with their packet ids and DUP set
+    assertPublish(at, 0, MQTT_DUP | 1 << 1, 3);
+    assertPublish(at, 1, MQTT_DUP | 1 << 1 | MQTT_RETAIN, 4);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at);
+    TEST_ASSERT_EQUAL(4, uploader->messagesPublished);
+}
+
+void test_stray_pubacks_dont_release_samples() {
+    queueSamples(2);
+    runUntilAwaiting(SIM_RTT_MS);
+    // one for a publish that isn't in flight, and the first one's twice
+    broker.puback(9);
+    broker.puback(1);
+    broker.puback(1);
+    uploader->step((uint32_t) sim->now_ms, stationClock);
+    TEST_ASSERT_EQUAL(Uploader::AWAIT_RESPONSE, uploader->state());
+    TEST_ASSERT_EQUAL(2, queue.size());
+
+    // until the broker's own, which acknowledge the first again and then the second
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+}
+
+void test_unacknowledged_publishes_resent_after_backoff() {
+    queueSamples(3);
+    runUntilAwaiting(SIM_RTT_MS);
+    // the broker got the first one, then the connection drops before the other acks
+    broker.puback(1);
+    uploader->step((uint32_t) sim->now_ms, stationClock);
+    transport.stop();
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(3, queue.size());
+
+    // new samples wait for the ones in flight
+    queueSamples(1);
+    sim->now_ms += uploader->backoff();
+    // straight to the connection after the backoff
+    runUpload();
+    TEST_ASSERT_EQUAL(2, uploader->connectionsOpened);
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+    TEST_ASSERT_EQUAL(1, queue.size());
+    readSent();
+    size_t at = 0;
+    assertConnect(at);
+    assertPublish(at, 0, 1 << 1, 1);
+    assertPublish(at, 1, 1 << 1, 2);
+    assertPublish(at, 2, 1 << 1 | MQTT_RETAIN, 3);
+    size_t second = at;
+    assertConnect(at);
+    at = second + at;
+    // only the two that weren't acknowledged, no longer the newest but still retained as sent
+    assertPublish(at, 1, MQTT_DUP | 1 << 1, 2);
+    assertPublish(at, 2, MQTT_DUP | 1 << 1 | MQTT_RETAIN, 3);
+    TEST_ASSERT_EQUAL_size_t(sentLength, at);
+
+    // and then the new one, with the next id
+    runUpload();
+    TEST_ASSERT_TRUE(queue.empty());
+    readSent();
+    assertPublish(at, 0, 1 << 1 | MQTT_RETAIN, 4);
+    TEST_ASSERT_EQUAL(4, uploader->messagesPublished);
+}
+
+void test_statistics_stay_with_redelivered_publish() {
+    ClimateAggregate aggregate = {};
+    for(uint8_t i = 0; i < 5; i++) {
+        aggregate.add(makeSample(i, 20, 50));
+    }
+    uploader->setAggregate(aggregate);
+    queueSamples(1);
+    runUntilAwaiting(SIM_RTT_MS);
+    transport.stop();
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    // they're part of the publish that goes out again, not of the next one
+    TEST_ASSERT_EQUAL(0, aggregate.count);
+    sim->now_ms += uploader->backoff();
+    runUpload();
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(0, aggregate.count);
+
+    // unless the publish is given up for a new target
+    aggregate.add(makeSample(10, 20, 50));
+    queueSamples(1);
+    runUntilAwaiting();
+    transport.stop();
+    transport.setOutage(sim->now_ms, sim->now_ms + 60000);
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(0, aggregate.count);
+    uploader->setTarget("broker", 1883, CLIENT_ID, TOPIC, "climate", 1, true);
+    TEST_ASSERT_EQUAL(1, aggregate.count);
+}
+
+void test_dropped_new_connection_backs_off() {
+    queueSamples(2);
+    runUntilAwaiting(SIM_RTT_MS);
+    transport.stop();
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(UPLOAD_ERROR_CONNECTION_LOST, uploader->lastResult);
+    TEST_ASSERT_EQUAL(2, queue.size());
+    TEST_ASSERT_EQUAL(1, uploader->uploadsFailed);
+
+    // after the backoff, the samples go out on a new connection
+    sim->now_ms += uploader->backoff();
+    runUpload();
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(2, uploader->connectionsOpened);
+}
+
+void test_unreachable_broker_keeps_samples() {
+    transport.setOutage(0, 60000);
+    queueSamples(2);
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(UPLOAD_ERROR_CONNECTION_FAILED, uploader->lastResult);
+    TEST_ASSERT_EQUAL(UPLOAD_MIN_BACKOFF_MS, uploader->backoff());
+    TEST_ASSERT_EQUAL(2, queue.size());
+
+    // backing off longer every time until the broker is back
+    uint32_t backoff = uploader->backoff();
+    while(sim->now_ms < 60000) {
+        sim->now_ms += uploader->backoff();
+        runUpload();
+        runUpload();
+        if(sim->now_ms < 60000) {
+            TEST_ASSERT_EQUAL(2 * backoff, uploader->backoff());
+            backoff = uploader->backoff();
+        }
+    }
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(0, uploader->backoff());
+}
+
+int main() {
+    int fd = mkstemp(sentPath);
+    if(fd < 0) {
+        return 1;
+    }
+    close(fd);
+    transport.setMqtt(true);
+    transport.toFile(sentPath);
+    UNITY_BEGIN();
+    RUN_TEST(test_connect_and_publish_bytes);
+    RUN_TEST(test_long_publish_takes_two_length_bytes);
+    RUN_TEST(test_qos0_is_done_once_sent);
+    RUN_TEST(test_qos1_waits_for_every_puback);
+    RUN_TEST(test_session_is_reused);
+    RUN_TEST(test_keep_alive_pings);
+    RUN_TEST(test_retry_after_dropped_connection);
+    RUN_TEST(test_stray_pubacks_dont_release_samples);
+    RUN_TEST(test_unacknowledged_publishes_resent_after_backoff);
+    RUN_TEST(test_statistics_stay_with_redelivered_publish);
+    RUN_TEST(test_dropped_new_connection_backs_off);
+    RUN_TEST(test_unreachable_broker_keeps_samples);
+    int failures = UNITY_END();
+    unlink(sentPath);
+    return failures;
+}
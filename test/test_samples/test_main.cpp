@@ -0,0 +1,138 @@
+#include <unity.h>
+#include <string.h>
+#include "../../src/samples.h"
+
+// SampleBuffer, the ring buffer of samples kept in RTC memory between deep sleep wakes, and
+// when it's due for upload
+
+SampleBuffer buffer;
+
+void setUp() {
+    buffer.clear();
+}
+
+void tearDown() {
+}
+
+void pushSamples(uint32_t from_s, uint8_t n) {
+    for(uint8_t i = 0; i < n; i++) {
+        buffer.push(makeSample(from_s + i, 20 + i * 0.1f, 50));
+    }
+}
+
+void test_sample_rounds_to_hundredths() {
+    Sample sample = makeSample(7, -3.456f, 45.678f);
+    TEST_ASSERT_EQUAL(7, sample.timestamp_s);
+    TEST_ASSERT_EQUAL(-346, sample.temperature_cC);
+    TEST_ASSERT_EQUAL(4568, sample.humidity_cpct);
+    TEST_ASSERT_EQUAL_FLOAT(-3.46f, sampleTemperature(sample));
+    TEST_ASSERT_EQUAL_FLOAT(45.68f, sampleHumidity(sample));
+}
+
+void test_push_keeps_order() {
+    pushSamples(100, 3);
+    TEST_ASSERT_EQUAL(3, buffer.size());
+    TEST_ASSERT_EQUAL(100, buffer.oldest().timestamp_s);
+    TEST_ASSERT_EQUAL(101, buffer.at(1).timestamp_s);
+    TEST_ASSERT_EQUAL(102, buffer.newest().timestamp_s);
+    TEST_ASSERT_EQUAL(0, buffer.dropped);
+}
+
+void test_overflow_drops_oldest() {
+    pushSamples(100, SAMPLE_BUFFER_SIZE + 5);
+    TEST_ASSERT_TRUE(buffer.full());
+    TEST_ASSERT_EQUAL(SAMPLE_BUFFER_SIZE, buffer.size());
+    TEST_ASSERT_EQUAL(5, buffer.dropped);
+    TEST_ASSERT_EQUAL(105, buffer.oldest().timestamp_s);
+    TEST_ASSERT_EQUAL(100 + SAMPLE_BUFFER_SIZE + 4, buffer.newest().timestamp_s);
+    for(uint8_t i = 0; i < buffer.size(); i++) {
+        TEST_ASSERT_EQUAL(105 + i, buffer.at(i).timestamp_s);
+    }
+}
+
+void test_drop_removes_oldest() {
+    pushSamples(100, 5);
+    buffer.drop(2);
+    TEST_ASSERT_EQUAL(3, buffer.size());
+    TEST_ASSERT_EQUAL(102, buffer.oldest().timestamp_s);
+    buffer.drop(10);
+    TEST_ASSERT_TRUE(buffer.empty());
+    // dropping uploaded samples isn't an overflow
+    TEST_ASSERT_EQUAL(0, buffer.dropped);
+}
+
+void test_wraps_around() {
+    // the uploads of many wakes move the head around the ring several times
+    pushSamples(0, 5);
+    uint32_t next_s = 5;
+    for(uint8_t round = 0; round < 3 * SAMPLE_BUFFER_SIZE; round++) {
+        pushSamples(next_s, 3);
+        next_s += 3;
+        buffer.drop(3);
+    }
+    TEST_ASSERT_EQUAL(5, buffer.size());
+    TEST_ASSERT_EQUAL(next_s - 5, buffer.oldest().timestamp_s);
+    for(uint8_t i = 1; i < buffer.size(); i++) {
+        TEST_ASSERT_EQUAL(buffer.at(i - 1).timestamp_s + 1, buffer.at(i).timestamp_s);
+    }
+    TEST_ASSERT_EQUAL(0, buffer.dropped);
+}
+
+void test_survives_copy() {
+    // RTC memory is read and written as bytes
+    pushSamples(100, SAMPLE_BUFFER_SIZE + 2);
+    buffer.drop(3);
+    uint8_t rtc[sizeof buffer];
+    memcpy(rtc, &buffer, sizeof rtc);
+    SampleBuffer restored;
+    memcpy(&restored, rtc, sizeof restored);
+    TEST_ASSERT_EQUAL(buffer.size(), restored.size());
+    TEST_ASSERT_EQUAL(2, restored.dropped);
+    TEST_ASSERT_EQUAL(105, restored.oldest().timestamp_s);
+    TEST_ASSERT_EQUAL(buffer.newest().timestamp_s, restored.newest().timestamp_s);
+}
+
+void test_empty_never_due() {
+    TEST_ASSERT_FALSE(uploadDue(buffer, 100000, 0, 0));
+}
+
+void test_due_at_fill_level() {
+    pushSamples(100, 9);
+    TEST_ASSERT_FALSE(uploadDue(buffer, 109, 10, 900));
+    pushSamples(109, 1);
+    TEST_ASSERT_TRUE(uploadDue(buffer, 110, 10, 900));
+}
+
+void test_due_when_full() {
+    // a fill level the buffer can't reach
+    pushSamples(100, SAMPLE_BUFFER_SIZE);
+    TEST_ASSERT_TRUE(uploadDue(buffer, 100, SAMPLE_BUFFER_SIZE + 1, 900));
+}
+
+void test_due_at_max_age() {
+    pushSamples(100, 2);
+    TEST_ASSERT_FALSE(uploadDue(buffer, 100 + 899, 10, 900));
+    TEST_ASSERT_TRUE(uploadDue(buffer, 100 + 900, 10, 900));
+}
+
+void test_max_age_across_clock_wrap() {
+    buffer.push(makeSample(0xFFFFFF00u, 20, 50));
+    TEST_ASSERT_FALSE(uploadDue(buffer, 0xFFFFFF00u + 100, 10, 900));
+    TEST_ASSERT_TRUE(uploadDue(buffer, 0xFFFFFF00u + 900, 10, 900));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_rounds_to_hundredths);
+    RUN_TEST(test_push_keeps_order);
+    RUN_TEST(test_overflow_drops_oldest);
+    RUN_TEST(test_drop_removes_oldest);
+    RUN_TEST(test_wraps_around);
+    RUN_TEST(test_survives_copy);
+    RUN_TEST(test_empty_never_due);
+    RUN_TEST(test_due_at_fill_level);
+    RUN_TEST(test_due_when_full);
+    RUN_TEST(test_due_at_max_age);
+    RUN_TEST(test_max_age_across_clock_wrap);
+    return UNITY_END();
+}
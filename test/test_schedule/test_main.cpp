@@ -0,0 +1,176 @@
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "../../src/schedule.h"
+
+// nextSleepInterval() on hand-made trends, and replayed over a day of readings the way the deep
+// sleep wakes record them
+
+#define MIN_S 10
+#define MAX_S 300
+
+TrendHistory trend;
+ScheduleParams params;
+
+void setUp() {
+    trend.clear();
+    params.min_s = MIN_S;
+    params.max_s = MAX_S;
+    params.temperatureThreshold_cC = 10;
+    params.humidityThreshold_cpct = 100;
+}
+
+void tearDown() {
+}
+
+void record(uint32_t timestamp_s, float temperature_C, float humidity_pct) {
+    trend.record(makeSample(timestamp_s, temperature_C, humidity_pct));
+}
+
+void test_too_few_readings_use_min() {
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 0, params));
+    record(0, 20, 50);
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 80, params));
+}
+
+void test_history_keeps_newest() {
+    for(uint8_t i = 0; i < TREND_HISTORY_SIZE + 2; i++) {
+        record(i * 10, 20 + i, 50);
+    }
+    TEST_ASSERT_EQUAL(TREND_HISTORY_SIZE, trend.count);
+    TEST_ASSERT_EQUAL(20, trend.at(0).timestamp_s);
+    TEST_ASSERT_EQUAL((TREND_HISTORY_SIZE + 1) * 10, trend.at(TREND_HISTORY_SIZE - 1).timestamp_s);
+}
+
+void test_steady_grows_to_max() {
+    uint32_t now_s = 0;
+    uint16_t interval_s = MIN_S;
+    const uint16_t expected[] = { 10, 20, 40, 80, 160, 300, 300 };
+    for(uint16_t next_s : expected) {
+        record(now_s, 21.5f, 48);
+        interval_s = nextSleepInterval(trend, interval_s, params);
+        if(trend.count >= 2) {
+            TEST_ASSERT_EQUAL(next_s, interval_s);
+        }
+        now_s += interval_s;
+    }
+    TEST_ASSERT_EQUAL(MAX_S, interval_s);
+}
+
+void test_rising_shrinks() {
+    // 0.1 degrees, one threshold, every 30 s
+    record(0, 20.0f, 50);
+    record(300, 21.0f, 50);
+    TEST_ASSERT_EQUAL(30, nextSleepInterval(trend, 300, params));
+}
+
+void test_humidity_alone_shrinks() {
+    record(0, 20, 50);
+    record(100, 20, 55);
+    // 1 % is reached after 20 s
+    TEST_ASSERT_EQUAL(20, nextSleepInterval(trend, 100, params));
+}
+
+void test_oscillating_is_unstable() {
+    // no net change, but 0.2 degrees up and down within 20 s
+    record(0, 20.0f, 50);
+    record(10, 20.2f, 50);
+    record(20, 20.0f, 50);
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 100, params));
+}
+
+void test_clamped_to_min() {
+    record(0, 20, 50);
+    record(10, 30, 50);
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 10, params));
+}
+
+void test_clamped_to_max() {
+    // slow enough for 1000 s per threshold, but no further than max
+    record(0, 20.0f, 50);
+    record(10000, 20.1f, 50);
+    TEST_ASSERT_EQUAL(MAX_S, nextSleepInterval(trend, 200, params));
+}
+
+void test_at_most_doubles() {
+    record(0, 20.0f, 50);
+    record(10000, 20.1f, 50);
+    TEST_ASSERT_EQUAL(50, nextSleepInterval(trend, 25, params));
+}
+
+void test_current_below_min_starts_at_min() {
+    record(0, 20, 50);
+    record(100, 20, 50);
+    TEST_ASSERT_EQUAL(2 * MIN_S, nextSleepInterval(trend, 0, params));
+}
+
+void test_max_below_min_is_fixed() {
+    // lowpower.maxUpdateInterval below lowpower.updateInterval turns the adaptation off
+    params.max_s = 5;
+    record(0, 20, 50);
+    record(100, 20, 50);
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 80, params));
+    params.max_s = MIN_S;
+    TEST_ASSERT_EQUAL(MIN_S, nextSleepInterval(trend, 80, params));
+}
+
+// A day of indoor temperature: flat at night, a warm spell in the afternoon
+float dayTemperature(uint32_t time_s) {
+    float hours = time_s / 3600.0f;
+    if(hours <= 13 || hours >= 17) {
+        return 20;
+    }
+    return 20 + 3 * sinf((hours - 13) / 4 * (float) M_PI);
+}
+
+// Returns the wakes the day took and how far the last reading was off from the true
+// temperature at worst, while sleeping
+uint32_t replayDay(float &maxError_C) {
+    uint32_t now_s = 0;
+    uint16_t interval_s = MIN_S;
+    uint32_t wakes = 0;
+    maxError_C = 0;
+    while(now_s < 86400) {
+        float reading_C = dayTemperature(now_s);
+        record(now_s, reading_C, 50);
+        wakes++;
+        interval_s = nextSleepInterval(trend, interval_s, params);
+        for(uint32_t t = now_s; t < now_s + interval_s; t++) {
+            float error_C = fabsf(dayTemperature(t) - reading_C);
+            if(error_C > maxError_C) {
+                maxError_C = error_C;
+            }
+        }
+        now_s += interval_s;
+    }
+    return wakes;
+}
+
+void test_replay_day() {
+    float maxError_C;
+    uint32_t wakes = replayDay(maxError_C);
+    char message[64];
+    snprintf(message, sizeof message, "%lu wakes instead of %d, off by up to %.2f C", (unsigned long) wakes, 86400 / MIN_S, maxError_C);
+    TEST_MESSAGE(message);
+    // mostly asleep for the longest interval, but still following the warm spell
+    TEST_ASSERT_LESS_THAN(86400 / MIN_S / 10, wakes);
+    TEST_ASSERT_GREATER_THAN(86400 / MAX_S, wakes);
+    TEST_ASSERT_TRUE(maxError_C < 0.3f);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_too_few_readings_use_min);
+    RUN_TEST(test_history_keeps_newest);
+    RUN_TEST(test_steady_grows_to_max);
+    RUN_TEST(test_rising_shrinks);
+    RUN_TEST(test_humidity_alone_shrinks);
+    RUN_TEST(test_oscillating_is_unstable);
+    RUN_TEST(test_clamped_to_min);
+    RUN_TEST(test_clamped_to_max);
+    RUN_TEST(test_at_most_doubles);
+    RUN_TEST(test_current_below_min_starts_at_min);
+    RUN_TEST(test_max_below_min_is_fixed);
+    RUN_TEST(test_replay_day);
+    return UNITY_END();
+}
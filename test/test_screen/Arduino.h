@@ -0,0 +1,15 @@
+#ifndef __FAKE_ARDUINO__
+#define __FAKE_ARDUINO__
+
+// The little of the Arduino core that screen.h and the fonts need, on the host
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#define memcpy_P memcpy
+
+#endif
@@ -0,0 +1,628 @@
+#ifndef __FAKE_OLED_DISPLAY_FONTS__
+#define __FAKE_OLED_DISPLAY_FONTS__
+
+#include <Arduino.h>
+
+// Stands in for the library's ArialMT_Plain_24, which env:native doesn't install: a made up font
+// of its height in the same format, with deterministic glyphs of 8 to 12 columns and pixels in
+// every row. scripts/subset_fonts.py subsets it when the library's isn't around, so the readings
+// subset is compared with what it was made from on every run of test/test_screen.
+
+const uint8_t ArialMT_Plain_24[] PROGMEM = {
+	0x0C, 0x1C, 0x20, 0xE0, 0xFF, 0xFF, 0x00, 0x0A, 0x00, 0x00, 0x2C, 0x0B, 0x00, 0x2C, 0x30, 0x0C,
+	0x00, 0x5C, 0x20, 0x08, 0x00, 0x7C, 0x24, 0x09, 0x00, 0xA0, 0x28, 0x0A, 0x00, 0xC8, 0x2C, 0x0B,
+	0x00, 0xF4, 0x30, 0x0C, 0x01, 0x24, 0x20, 0x08, 0x01, 0x44, 0x24, 0x09, 0x01, 0x68, 0x28, 0x0A,
+	0x01, 0x90, 0x2C, 0x0B, 0x01, 0xBC, 0x30, 0x0C, 0x01, 0xEC, 0x20, 0x08, 0x02, 0x0C, 0x24, 0x09,
+	0x02, 0x30, 0x28, 0x0A, 0x02, 0x58, 0x2C, 0x0B, 0x02, 0x84, 0x30, 0x0C, 0x02, 0xB4, 0x20, 0x08,
+	0x02, 0xD4, 0x24, 0x09, 0x02, 0xF8, 0x28, 0x0A, 0x03, 0x20, 0x2C, 0x0B, 0x03, 0x4C, 0x30, 0x0C,
+	0x03, 0x7C, 0x20, 0x08, 0x03, 0x9C, 0x24, 0x09, 0x03, 0xC0, 0x28, 0x0A, 0x03, 0xE8, 0x2C, 0x0B,
+	0x04, 0x14, 0x30, 0x0C, 0x04, 0x44, 0x20, 0x08, 0x04, 0x64, 0x24, 0x09, 0x04, 0x88, 0x28, 0x0A,
+	0x04, 0xB0, 0x2C, 0x0B, 0x04, 0xDC, 0x30, 0x0C, 0x05, 0x0C, 0x20, 0x08, 0x05, 0x2C, 0x24, 0x09,
+	0x05, 0x50, 0x28, 0x0A, 0x05, 0x78, 0x2C, 0x0B, 0x05, 0xA4, 0x30, 0x0C, 0x05, 0xD4, 0x20, 0x08,
+	0x05, 0xF4, 0x24, 0x09, 0x06, 0x18, 0x28, 0x0A, 0x06, 0x40, 0x2C, 0x0B, 0x06, 0x6C, 0x30, 0x0C,
+	0x06, 0x9C, 0x20, 0x08, 0x06, 0xBC, 0x24, 0x09, 0x06, 0xE0, 0x28, 0x0A, 0x07, 0x08, 0x2C, 0x0B,
+	0x07, 0x34, 0x30, 0x0C, 0x07, 0x64, 0x20, 0x08, 0x07, 0x84, 0x24, 0x09, 0x07, 0xA8, 0x28, 0x0A,
+	0x07, 0xD0, 0x2C, 0x0B, 0x07, 0xFC, 0x30, 0x0C, 0x08, 0x2C, 0x20, 0x08, 0x08, 0x4C, 0x24, 0x09,
+	0x08, 0x70, 0x28, 0x0A, 0x08, 0x98, 0x2C, 0x0B, 0x08, 0xC4, 0x30, 0x0C, 0x08, 0xF4, 0x20, 0x08,
+	0x09, 0x14, 0x24, 0x09, 0x09, 0x38, 0x28, 0x0A, 0x09, 0x60, 0x2C, 0x0B, 0x09, 0x8C, 0x30, 0x0C,
+	0x09, 0xBC, 0x20, 0x08, 0x09, 0xDC, 0x24, 0x09, 0x0A, 0x00, 0x28, 0x0A, 0x0A, 0x28, 0x2C, 0x0B,
+	0x0A, 0x54, 0x30, 0x0C, 0x0A, 0x84, 0x20, 0x08, 0x0A, 0xA4, 0x24, 0x09, 0x0A, 0xC8, 0x28, 0x0A,
+	0x0A, 0xF0, 0x2C, 0x0B, 0x0B, 0x1C, 0x30, 0x0C, 0x0B, 0x4C, 0x20, 0x08, 0x0B, 0x6C, 0x24, 0x09,
+	0x0B, 0x90, 0x28, 0x0A, 0x0B, 0xB8, 0x2C, 0x0B, 0x0B, 0xE4, 0x30, 0x0C, 0x0C, 0x14, 0x20, 0x08,
+	0x0C, 0x34, 0x24, 0x09, 0x0C, 0x58, 0x28, 0x0A, 0x0C, 0x80, 0x2C, 0x0B, 0x0C, 0xAC, 0x30, 0x0C,
+	0x0C, 0xDC, 0x20, 0x08, 0x0C, 0xFC, 0x24, 0x09, 0x0D, 0x20, 0x28, 0x0A, 0x0D, 0x48, 0x2C, 0x0B,
+	0x0D, 0x74, 0x30, 0x0C, 0x0D, 0xA4, 0x20, 0x08, 0x0D, 0xC4, 0x24, 0x09, 0x0D, 0xE8, 0x28, 0x0A,
+	0x0E, 0x10, 0x2C, 0x0B, 0x0E, 0x3C, 0x30, 0x0C, 0x0E, 0x6C, 0x20, 0x08, 0x0E, 0x8C, 0x24, 0x09,
+	0x0E, 0xB0, 0x28, 0x0A, 0x0E, 0xD8, 0x2C, 0x0B, 0x0F, 0x04, 0x30, 0x0C, 0x0F, 0x34, 0x20, 0x08,
+	0x0F, 0x54, 0x24, 0x09, 0x0F, 0x78, 0x28, 0x0A, 0x0F, 0xA0, 0x2C, 0x0B, 0x0F, 0xCC, 0x30, 0x0C,
+	0x0F, 0xFC, 0x20, 0x08, 0x10, 0x1C, 0x24, 0x09, 0x10, 0x40, 0x28, 0x0A, 0x10, 0x68, 0x2C, 0x0B,
+	0x10, 0x94, 0x30, 0x0C, 0x10, 0xC4, 0x20, 0x08, 0x10, 0xE4, 0x24, 0x09, 0x11, 0x08, 0x28, 0x0A,
+	0x11, 0x30, 0x2C, 0x0B, 0x11, 0x5C, 0x30, 0x0C, 0x11, 0x8C, 0x20, 0x08, 0x11, 0xAC, 0x24, 0x09,
+	0x11, 0xD0, 0x28, 0x0A, 0x11, 0xF8, 0x2C, 0x0B, 0x12, 0x24, 0x30, 0x0C, 0x12, 0x54, 0x20, 0x08,
+	0x12, 0x74, 0x24, 0x09, 0x12, 0x98, 0x28, 0x0A, 0x12, 0xC0, 0x2C, 0x0B, 0x12, 0xEC, 0x30, 0x0C,
+	0x13, 0x1C, 0x20, 0x08, 0x13, 0x3C, 0x24, 0x09, 0x13, 0x60, 0x28, 0x0A, 0x13, 0x88, 0x2C, 0x0B,
+	0x13, 0xB4, 0x30, 0x0C, 0x13, 0xE4, 0x20, 0x08, 0x14, 0x04, 0x24, 0x09, 0x14, 0x28, 0x28, 0x0A,
+	0x14, 0x50, 0x2C, 0x0B, 0x14, 0x7C, 0x30, 0x0C, 0x14, 0xAC, 0x20, 0x08, 0x14, 0xCC, 0x24, 0x09,
+	0x14, 0xF0, 0x28, 0x0A, 0x15, 0x18, 0x2C, 0x0B, 0x15, 0x44, 0x30, 0x0C, 0x15, 0x74, 0x20, 0x08,
+	0x15, 0x94, 0x24, 0x09, 0x15, 0xB8, 0x28, 0x0A, 0x15, 0xE0, 0x2C, 0x0B, 0x16, 0x0C, 0x30, 0x0C,
+	0x16, 0x3C, 0x20, 0x08, 0x16, 0x5C, 0x24, 0x09, 0x16, 0x80, 0x28, 0x0A, 0x16, 0xA8, 0x2C, 0x0B,
+	0x16, 0xD4, 0x30, 0x0C, 0x17, 0x04, 0x20, 0x08, 0x17, 0x24, 0x24, 0x09, 0x17, 0x48, 0x28, 0x0A,
+	0x17, 0x70, 0x2C, 0x0B, 0x17, 0x9C, 0x30, 0x0C, 0x17, 0xCC, 0x20, 0x08, 0x17, 0xEC, 0x24, 0x09,
+	0x18, 0x10, 0x28, 0x0A, 0x18, 0x38, 0x2C, 0x0B, 0x18, 0x64, 0x30, 0x0C, 0x18, 0x94, 0x20, 0x08,
+	0x18, 0xB4, 0x24, 0x09, 0x18, 0xD8, 0x28, 0x0A, 0x19, 0x00, 0x2C, 0x0B, 0x19, 0x2C, 0x30, 0x0C,
+	0x19, 0x5C, 0x20, 0x08, 0x19, 0x7C, 0x24, 0x09, 0x19, 0xA0, 0x28, 0x0A, 0x19, 0xC8, 0x2C, 0x0B,
+	0x19, 0xF4, 0x30, 0x0C, 0x1A, 0x24, 0x20, 0x08, 0x1A, 0x44, 0x24, 0x09, 0x1A, 0x68, 0x28, 0x0A,
+	0x1A, 0x90, 0x2C, 0x0B, 0x1A, 0xBC, 0x30, 0x0C, 0x1A, 0xEC, 0x20, 0x08, 0x1B, 0x0C, 0x24, 0x09,
+	0x1B, 0x30, 0x28, 0x0A, 0x1B, 0x58, 0x2C, 0x0B, 0x1B, 0x84, 0x30, 0x0C, 0x1B, 0xB4, 0x20, 0x08,
+	0x1B, 0xD4, 0x24, 0x09, 0x1B, 0xF8, 0x28, 0x0A, 0x1C, 0x20, 0x2C, 0x0B, 0x1C, 0x4C, 0x30, 0x0C,
+	0x1C, 0x7C, 0x20, 0x08, 0x1C, 0x9C, 0x24, 0x09, 0x1C, 0xC0, 0x28, 0x0A, 0x1C, 0xE8, 0x2C, 0x0B,
+	0x1D, 0x14, 0x30, 0x0C, 0x1D, 0x44, 0x20, 0x08, 0x1D, 0x64, 0x24, 0x09, 0x1D, 0x88, 0x28, 0x0A,
+	0x1D, 0xB0, 0x2C, 0x0B, 0x1D, 0xDC, 0x30, 0x0C, 0x1E, 0x0C, 0x20, 0x08, 0x1E, 0x2C, 0x24, 0x09,
+	0x1E, 0x50, 0x28, 0x0A, 0x1E, 0x78, 0x2C, 0x0B, 0x1E, 0xA4, 0x30, 0x0C, 0x1E, 0xD4, 0x20, 0x08,
+	0x1E, 0xF4, 0x24, 0x09, 0x1F, 0x18, 0x28, 0x0A, 0x1F, 0x40, 0x2C, 0x0B, 0x1F, 0x6C, 0x30, 0x0C,
+	0x1F, 0x9C, 0x20, 0x08, 0x1F, 0xBC, 0x24, 0x09, 0x1F, 0xE0, 0x28, 0x0A, 0x20, 0x08, 0x2C, 0x0B,
+	0x20, 0x34, 0x30, 0x0C, 0x20, 0x64, 0x20, 0x08, 0x20, 0x84, 0x24, 0x09, 0x20, 0xA8, 0x28, 0x0A,
+	0x20, 0xD0, 0x2C, 0x0B, 0x20, 0xFC, 0x30, 0x0C, 0x21, 0x2C, 0x20, 0x08, 0x21, 0x4C, 0x24, 0x09,
+	0x21, 0x70, 0x28, 0x0A, 0x21, 0x98, 0x2C, 0x0B, 0x21, 0xC4, 0x30, 0x0C, 0x21, 0xF4, 0x20, 0x08,
+	0x22, 0x14, 0x24, 0x09, 0x22, 0x38, 0x28, 0x0A, 0x22, 0x60, 0x2C, 0x0B, 0x22, 0x8C, 0x30, 0x0C,
+	0x22, 0xBC, 0x20, 0x08, 0xD5, 0x3B, 0x9F, 0x05, 0x59, 0xBF, 0x33, 0x09, 0xFD, 0x53, 0xB7, 0x0D,
+	0x91, 0xF7, 0x5B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0xB9, 0x1F, 0x73, 0x09, 0x3D, 0xB3, 0x17, 0x0D,
+	0xD1, 0x37, 0x9B, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D,
+	0xFB, 0x5F, 0xB5, 0x09, 0x7F, 0xF3, 0x59, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0xB7, 0x1B, 0x71, 0x05,
+	0x3B, 0x9F, 0x15, 0x09, 0xDF, 0x33, 0x99, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0xF7, 0x5B, 0xD1, 0x05,
+	0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05,
+	0x1F, 0x75, 0xD9, 0x0F, 0xB3, 0x19, 0x7D, 0x03, 0x37, 0x9D, 0x11, 0x07, 0xDB, 0x31, 0x95, 0x0B,
+	0x5F, 0xD5, 0x39, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B,
+	0x35, 0x99, 0xFF, 0x03, 0xD9, 0x3D, 0x93, 0x07, 0x5D, 0xD1, 0x37, 0x0B, 0xF1, 0x55, 0xBB, 0x0F,
+	0x95, 0xF9, 0x5F, 0x03, 0x19, 0x7D, 0xF3, 0x07, 0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F,
+	0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBF, 0x33, 0x09, 0xFD, 0x53, 0xB7, 0x0D, 0x91, 0xF7, 0x5B, 0x01,
+	0x15, 0x7B, 0xDF, 0x05, 0xB9, 0x1F, 0x73, 0x09, 0x3D, 0xB3, 0x17, 0x0D, 0xD1, 0x37, 0x9B, 0x01,
+	0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x7F, 0xF3, 0x59, 0x0D,
+	0x13, 0x77, 0xDD, 0x01, 0xB7, 0x1B, 0x71, 0x05, 0x3B, 0x9F, 0x15, 0x09, 0xDF, 0x33, 0x99, 0x0D,
+	0x73, 0xD7, 0x3D, 0x01, 0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D,
+	0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05, 0xB3, 0x19, 0x7D, 0x03, 0x37, 0x9D, 0x11, 0x07,
+	0xDB, 0x31, 0x95, 0x0B, 0x5F, 0xD5, 0x39, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x97, 0xFD, 0x51, 0x07,
+	0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07,
+	0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0xD9, 0x3D, 0x93, 0x07, 0x5D, 0xD1, 0x37, 0x0B,
+	0xF1, 0x55, 0xBB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x19, 0x7D, 0xF3, 0x07, 0xBD, 0x11, 0x77, 0x0B,
+	0x51, 0xB5, 0x1B, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0xFD, 0x53, 0xB7, 0x0D, 0x91, 0xF7, 0x5B, 0x01,
+	0x15, 0x7B, 0xDF, 0x05, 0xB9, 0x1F, 0x73, 0x09, 0x3D, 0xB3, 0x17, 0x0D, 0xD1, 0x37, 0x9B, 0x01,
+	0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x13, 0x77, 0xDD, 0x01,
+	0xB7, 0x1B, 0x71, 0x05, 0x3B, 0x9F, 0x15, 0x09, 0xDF, 0x33, 0x99, 0x0D, 0x73, 0xD7, 0x3D, 0x01,
+	0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x57, 0xBB, 0x11, 0x05, 0x37, 0x9D, 0x11, 0x07, 0xDB, 0x31, 0x95, 0x0B, 0x5F, 0xD5, 0x39, 0x0F,
+	0xF3, 0x59, 0xBD, 0x03, 0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F,
+	0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F,
+	0x5D, 0xD1, 0x37, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x19, 0x7D, 0xF3, 0x07,
+	0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x79, 0xDD, 0x33, 0x07,
+	0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07,
+	0x91, 0xF7, 0x5B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0xB9, 0x1F, 0x73, 0x09, 0x3D, 0xB3, 0x17, 0x0D,
+	0xD1, 0x37, 0x9B, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D,
+	0xB7, 0x1B, 0x71, 0x05, 0x3B, 0x9F, 0x15, 0x09, 0xDF, 0x33, 0x99, 0x0D, 0x73, 0xD7, 0x3D, 0x01,
+	0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x57, 0xBB, 0x11, 0x05, 0xDB, 0x31, 0x95, 0x0B, 0x5F, 0xD5, 0x39, 0x0F, 0xF3, 0x59, 0xBD, 0x03,
+	0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03,
+	0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0xF1, 0x55, 0xBB, 0x0F,
+	0x95, 0xF9, 0x5F, 0x03, 0x19, 0x7D, 0xF3, 0x07, 0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F,
+	0xD5, 0x39, 0x9F, 0x03, 0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F,
+	0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07, 0x15, 0x7B, 0xDF, 0x05, 0xB9, 0x1F, 0x73, 0x09,
+	0x3D, 0xB3, 0x17, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09,
+	0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09,
+	0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x3B, 0x9F, 0x15, 0x09, 0xDF, 0x33, 0x99, 0x0D,
+	0x73, 0xD7, 0x3D, 0x01, 0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D,
+	0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05, 0x5F, 0xD5, 0x39, 0x0F, 0xF3, 0x59, 0xBD, 0x03,
+	0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03,
+	0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0x95, 0xF9, 0x5F, 0x03,
+	0x19, 0x7D, 0xF3, 0x07, 0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F, 0xD5, 0x39, 0x9F, 0x03,
+	0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03,
+	0xB9, 0x1D, 0x93, 0x07, 0xB9, 0x1F, 0x73, 0x09, 0x3D, 0xB3, 0x17, 0x0D, 0xD1, 0x37, 0x9B, 0x01,
+	0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01,
+	0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0xDF, 0x33, 0x99, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09,
+	0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05, 0xDB, 0x3F, 0xB5, 0x09,
+	0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09,
+	0xF3, 0x59, 0xBD, 0x03, 0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F,
+	0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F,
+	0x19, 0x7D, 0xF3, 0x07, 0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F, 0xD5, 0x39, 0x9F, 0x03,
+	0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03,
+	0xB9, 0x1D, 0x93, 0x07, 0x3D, 0xB3, 0x17, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x75, 0xDB, 0x3F, 0x05,
+	0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05,
+	0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x73, 0xD7, 0x3D, 0x01,
+	0xF7, 0x5B, 0xD1, 0x05, 0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x57, 0xBB, 0x11, 0x05, 0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01,
+	0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09, 0x97, 0xFD, 0x51, 0x07, 0x1B, 0x91, 0xF5, 0x0B,
+	0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B,
+	0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B,
+	0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0xBD, 0x11, 0x77, 0x0B, 0x51, 0xB5, 0x1B, 0x0F,
+	0xD5, 0x39, 0x9F, 0x03, 0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F,
+	0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07, 0xD1, 0x37, 0x9B, 0x01, 0x75, 0xDB, 0x3F, 0x05,
+	0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05,
+	0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0xF7, 0x5B, 0xD1, 0x05,
+	0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05,
+	0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05,
+	0x3B, 0x9F, 0xF5, 0x09, 0x1B, 0x91, 0xF5, 0x0B, 0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03,
+	0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03,
+	0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03,
+	0x51, 0xB5, 0x1B, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B,
+	0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07, 0x5D, 0xB1, 0x17, 0x0B,
+	0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B,
+	0x75, 0xDB, 0x3F, 0x05, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01,
+	0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0x9B, 0xFF, 0x55, 0x09, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05,
+	0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05,
+	0x3B, 0x9F, 0xF5, 0x09, 0xBF, 0x15, 0x79, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07,
+	0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07,
+	0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0xD5, 0x39, 0x9F, 0x03,
+	0x79, 0xDD, 0x33, 0x07, 0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03,
+	0xB9, 0x1D, 0x93, 0x07, 0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03,
+	0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B, 0xF9, 0x5F, 0xD3, 0x09, 0x9D, 0xF3, 0x57, 0x0D,
+	0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D,
+	0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D,
+	0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0x1F, 0x93, 0xF9, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x57, 0xBB, 0x11, 0x05, 0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01,
+	0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09, 0x53, 0xB9, 0x1D, 0x03, 0xD7, 0x3D, 0xB1, 0x07,
+	0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07,
+	0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x79, 0xDD, 0x33, 0x07,
+	0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07,
+	0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07,
+	0x9D, 0x11, 0x77, 0x0B, 0x9D, 0xF3, 0x57, 0x0D, 0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05,
+	0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05,
+	0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0xB3, 0x17, 0x7D, 0x01, 0x57, 0xBB, 0x11, 0x05, 0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D,
+	0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09, 0xBF, 0x33, 0x99, 0x0D,
+	0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D,
+	0xD7, 0x3D, 0xB1, 0x07, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03,
+	0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03,
+	0xFD, 0x71, 0xD7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07,
+	0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07,
+	0x9D, 0x11, 0x77, 0x0B, 0x31, 0x97, 0xFB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09,
+	0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09,
+	0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0x57, 0xBB, 0x11, 0x05,
+	0xDB, 0x3F, 0xB5, 0x09, 0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05,
+	0x3B, 0x9F, 0xF5, 0x09, 0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05,
+	0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D, 0x7B, 0xD1, 0x35, 0x0B, 0xFF, 0x75, 0xD9, 0x0F,
+	0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F,
+	0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F,
+	0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x91, 0xF5, 0x5B, 0x0F, 0x35, 0x99, 0xFF, 0x03,
+	0xB9, 0x1D, 0x93, 0x07, 0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03,
+	0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B, 0xB5, 0x1B, 0x7F, 0x05, 0x59, 0xBF, 0x13, 0x09,
+	0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09,
+	0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xDB, 0x3F, 0xB5, 0x09,
+	0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09,
+	0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09,
+	0x1F, 0x73, 0xD9, 0x0D, 0xFF, 0x75, 0xD9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07,
+	0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07,
+	0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07,
+	0x35, 0x99, 0xFF, 0x03, 0xB9, 0x1D, 0x93, 0x07, 0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F,
+	0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B, 0x31, 0x95, 0xFB, 0x0F,
+	0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F,
+	0x59, 0xBF, 0x13, 0x09, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05,
+	0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0x7F, 0xD3, 0x39, 0x0D, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09,
+	0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09,
+	0x1F, 0x73, 0xD9, 0x0D, 0x93, 0xF9, 0x5D, 0x03, 0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B,
+	0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B,
+	0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0xB9, 0x1D, 0x93, 0x07,
+	0x5D, 0xB1, 0x17, 0x0B, 0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07,
+	0x9D, 0x11, 0x77, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07,
+	0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0xDD, 0x53, 0xB7, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01,
+	0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0x13, 0x77, 0xDD, 0x01, 0x97, 0xFB, 0x71, 0x05,
+	0x3B, 0x9F, 0xF5, 0x09, 0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05,
+	0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D, 0x37, 0x9D, 0xF1, 0x07, 0xBB, 0x31, 0x95, 0x0B,
+	0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B,
+	0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x5D, 0xB1, 0x17, 0x0B,
+	0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B,
+	0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B,
+	0x91, 0xF5, 0x5B, 0x0F, 0x71, 0xD7, 0x3B, 0x01, 0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09,
+	0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09,
+	0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09,
+	0x97, 0xFB, 0x71, 0x05, 0x3B, 0x9F, 0xF5, 0x09, 0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01,
+	0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01,
+	0xBB, 0x31, 0x95, 0x0B, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07,
+	0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07,
+	0xF1, 0x55, 0xBB, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B,
+	0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B,
+	0x91, 0xF5, 0x5B, 0x0F, 0x15, 0x7B, 0xDF, 0x05, 0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D,
+	0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D,
+	0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0x3B, 0x9F, 0xF5, 0x09,
+	0xBF, 0x33, 0x99, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09,
+	0x1F, 0x73, 0xD9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09,
+	0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x5F, 0xB5, 0x19, 0x0F, 0xF3, 0x59, 0xBD, 0x03,
+	0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03,
+	0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03,
+	0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x75, 0xD9, 0x3F, 0x03, 0x19, 0x7D, 0xD3, 0x07,
+	0x9D, 0x11, 0x77, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07,
+	0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x99, 0xFF, 0x73, 0x09, 0x3D, 0x93, 0xF7, 0x0D,
+	0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D,
+	0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0xBF, 0x33, 0x99, 0x0D,
+	0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D,
+	0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0xF3, 0x59, 0xBD, 0x03, 0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B,
+	0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B,
+	0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B,
+	0x19, 0x7D, 0xD3, 0x07, 0x9D, 0x11, 0x77, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03,
+	0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x15, 0x79, 0xDF, 0x03,
+	0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03,
+	0x3D, 0x93, 0xF7, 0x0D, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09,
+	0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09,
+	0x53, 0xB7, 0x1D, 0x01, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D,
+	0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDD, 0x51, 0x07, 0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F,
+	0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F,
+	0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x9D, 0x11, 0x77, 0x0B,
+	0x31, 0x95, 0xFB, 0x0F, 0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B,
+	0x91, 0xF5, 0x5B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B,
+	0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0xD1, 0x37, 0x9B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05,
+	0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xF7, 0x5B, 0xB1, 0x05, 0x7B, 0xDF, 0x55, 0x09,
+	0x1F, 0x73, 0xD9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09,
+	0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x1B, 0x71, 0xD5, 0x0B, 0x9F, 0x15, 0x79, 0x0F,
+	0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F,
+	0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x31, 0x95, 0xFB, 0x0F,
+	0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F,
+	0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x75, 0xD9, 0x3F, 0x03, 0x55, 0xBB, 0x1F, 0x05, 0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D,
+	0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D,
+	0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D,
+	0x7B, 0xDF, 0x55, 0x09, 0x1F, 0x73, 0xD9, 0x0D, 0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05,
+	0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x97, 0xFB, 0x51, 0x05,
+	0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05,
+	0x9F, 0x15, 0x79, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B,
+	0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B,
+	0xD5, 0x39, 0x9F, 0x03, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F,
+	0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x75, 0xD9, 0x3F, 0x03, 0xF9, 0x5F, 0xB3, 0x09, 0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0x1F, 0x73, 0xD9, 0x0D,
+	0xB3, 0x17, 0x7D, 0x01, 0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D,
+	0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05, 0x33, 0x99, 0xFD, 0x03, 0xD7, 0x3D, 0x91, 0x07,
+	0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07,
+	0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07,
+	0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x59, 0xBD, 0x33, 0x07, 0xFD, 0x51, 0xB7, 0x0B,
+	0x91, 0xF5, 0x5B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B,
+	0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0x7D, 0xF3, 0x57, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xB3, 0x17, 0x7D, 0x01,
+	0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01,
+	0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01,
+	0xD7, 0x3B, 0xB1, 0x05, 0xD7, 0x3D, 0x91, 0x07, 0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F,
+	0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F,
+	0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F,
+	0xFD, 0x51, 0xB7, 0x0B, 0x91, 0xF5, 0x5B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07,
+	0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0xF9, 0x5D, 0xD3, 0x07,
+	0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07,
+	0x11, 0x77, 0xDB, 0x01, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D,
+	0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D,
+	0x37, 0x9B, 0x11, 0x05, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01,
+	0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01,
+	0xD7, 0x3B, 0xB1, 0x05, 0x5B, 0xD1, 0x35, 0x0B, 0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03,
+	0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03,
+	0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x91, 0xF5, 0x5B, 0x0F,
+	0x15, 0x79, 0xDF, 0x03, 0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x75, 0xD9, 0x3F, 0x03, 0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F,
+	0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07, 0xB5, 0x1B, 0x7F, 0x05, 0x39, 0x9F, 0x13, 0x09,
+	0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09,
+	0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09,
+	0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0xDB, 0x3F, 0x95, 0x09, 0x5F, 0xD3, 0x39, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D,
+	0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05, 0xFF, 0x55, 0xB9, 0x0F, 0x93, 0xF9, 0x5D, 0x03,
+	0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03,
+	0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x15, 0x79, 0xDF, 0x03,
+	0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03,
+	0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x59, 0xBD, 0x13, 0x07, 0x39, 0x9F, 0x13, 0x09, 0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01,
+	0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01,
+	0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0x5F, 0xD3, 0x39, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09,
+	0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05, 0x7B, 0xDF, 0x35, 0x09,
+	0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09,
+	0x93, 0xF9, 0x5D, 0x03, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F,
+	0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F,
+	0xB9, 0x1D, 0x73, 0x07, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03,
+	0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x59, 0xBD, 0x13, 0x07, 0xDD, 0x33, 0x97, 0x0D, 0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0xF3, 0x57, 0xBD, 0x01,
+	0x97, 0xFB, 0x51, 0x05, 0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01,
+	0xD7, 0x3B, 0xB1, 0x05, 0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01,
+	0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09, 0x17, 0x7D, 0xF1, 0x07, 0xBB, 0x11, 0x75, 0x0B,
+	0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B,
+	0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B,
+	0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x3D, 0xB1, 0x17, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x75, 0xD9, 0x3F, 0x03, 0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F,
+	0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07, 0x71, 0xD7, 0x3B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0x97, 0xFB, 0x51, 0x05,
+	0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05,
+	0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x95, 0x09, 0xBB, 0x11, 0x75, 0x0B, 0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03,
+	0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03,
+	0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0xD1, 0x35, 0x9B, 0x0F, 0x75, 0xD9, 0x3F, 0x03, 0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B,
+	0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07, 0xDD, 0x51, 0xB7, 0x0B,
+	0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B,
+	0xF5, 0x5B, 0xBF, 0x05, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01,
+	0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0x1B, 0x7F, 0xF5, 0x09, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05,
+	0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x95, 0x09, 0x3F, 0xB5, 0x19, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07,
+	0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07,
+	0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x75, 0xD9, 0x3F, 0x03,
+	0xF9, 0x5D, 0xD3, 0x07, 0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x59, 0xBD, 0x13, 0x07, 0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03,
+	0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B, 0x99, 0xFF, 0x53, 0x09, 0x1D, 0x93, 0xF7, 0x0D,
+	0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D,
+	0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D,
+	0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0xBF, 0x13, 0x79, 0x0D, 0x53, 0xB7, 0x1D, 0x01,
+	0xD7, 0x3B, 0xB1, 0x05, 0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01,
+	0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09, 0xD3, 0x39, 0x9D, 0x03, 0x77, 0xDD, 0x31, 0x07,
+	0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07,
+	0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0xF9, 0x5D, 0xD3, 0x07,
+	0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07,
+	0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07,
+	0x3D, 0x91, 0xF7, 0x0B, 0x1D, 0x93, 0xF7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05,
+	0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05,
+	0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0x53, 0xB7, 0x1D, 0x01, 0xD7, 0x3B, 0xB1, 0x05, 0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D,
+	0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09, 0x5F, 0xB3, 0x19, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D,
+	0x77, 0xDD, 0x31, 0x07, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03,
+	0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0x9D, 0xF1, 0x57, 0x0B, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07,
+	0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07,
+	0x3D, 0x91, 0xF7, 0x0B, 0xB1, 0x17, 0x7B, 0x01, 0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09,
+	0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09,
+	0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0xD7, 0x3B, 0xB1, 0x05,
+	0x7B, 0xDF, 0x35, 0x09, 0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x95, 0x09, 0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05,
+	0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D, 0xFB, 0x71, 0xD5, 0x0B, 0x9F, 0xF5, 0x59, 0x0F,
+	0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F,
+	0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F,
+	0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0x31, 0x95, 0xFB, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x59, 0xBD, 0x13, 0x07, 0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03,
+	0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B, 0x55, 0xBB, 0x1F, 0x05, 0xD9, 0x3F, 0xB3, 0x09,
+	0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09,
+	0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x7B, 0xDF, 0x35, 0x09,
+	0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09,
+	0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09,
+	0x9F, 0x13, 0x79, 0x0D, 0x9F, 0xF5, 0x59, 0x0F, 0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07,
+	0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07,
+	0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07,
+	0xB5, 0x19, 0x7F, 0x03, 0x59, 0xBD, 0x13, 0x07, 0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F,
+	0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F,
+	0xD9, 0x3F, 0xB3, 0x09, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05,
+	0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0xFF, 0x73, 0xD9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09,
+	0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09,
+	0x9F, 0x13, 0x79, 0x0D, 0x33, 0x99, 0xFD, 0x03, 0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B,
+	0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B,
+	0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0x59, 0xBD, 0x13, 0x07,
+	0xDD, 0x51, 0xB7, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07,
+	0x3D, 0x91, 0xF7, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07,
+	0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x7D, 0xD3, 0x37, 0x0D, 0x11, 0x77, 0xDB, 0x01,
+	0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01,
+	0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01,
+	0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x93, 0xF7, 0x5D, 0x01, 0x37, 0x9B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x95, 0x09, 0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05,
+	0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D, 0xB7, 0x1D, 0x91, 0x07, 0x5B, 0xB1, 0x15, 0x0B,
+	0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B,
+	0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0xDD, 0x51, 0xB7, 0x0B,
+	0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B,
+	0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0x11, 0x77, 0xDB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09,
+	0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09,
+	0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09,
+	0x37, 0x9B, 0xF1, 0x05, 0xBB, 0x1F, 0x95, 0x09, 0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01,
+	0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D, 0x33, 0x97, 0xFD, 0x01,
+	0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01,
+	0x5B, 0xB1, 0x15, 0x0B, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07,
+	0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07,
+	0x71, 0xD5, 0x3B, 0x0F, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B,
+	0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0x95, 0xFB, 0x5F, 0x05, 0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D,
+	0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D,
+	0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0xBB, 0x1F, 0x95, 0x09,
+	0x5F, 0xB3, 0x19, 0x0D, 0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09,
+	0x9F, 0x13, 0x79, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09,
+	0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0xDF, 0x55, 0xB9, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03,
+	0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03,
+	0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0x15, 0x79, 0xDF, 0x03, 0x99, 0xFD, 0x73, 0x07,
+	0x3D, 0x91, 0xF7, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07,
+	0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x39, 0x9F, 0xF3, 0x09, 0xBD, 0x33, 0x97, 0x0D,
+	0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D,
+	0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x5F, 0xB3, 0x19, 0x0D,
+	0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D,
+	0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D,
+	0x93, 0xF7, 0x5D, 0x01, 0x73, 0xD9, 0x3D, 0x03, 0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B,
+	0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B,
+	0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B,
+	0x99, 0xFD, 0x73, 0x07, 0x3D, 0x91, 0xF7, 0x0B, 0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03,
+	0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03,
+	0xBD, 0x33, 0x97, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09,
+	0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09,
+	0xF3, 0x57, 0xBD, 0x01, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D,
+	0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D,
+	0x93, 0xF7, 0x5D, 0x01, 0x17, 0x7D, 0xD1, 0x07, 0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F,
+	0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F,
+	0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0x3D, 0x91, 0xF7, 0x0B,
+	0xD1, 0x35, 0x9B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B,
+	0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x51, 0xB7, 0x1B, 0x01, 0xF5, 0x5B, 0xBF, 0x05,
+	0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05,
+	0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05,
+	0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x77, 0xDB, 0x51, 0x05, 0x1B, 0x7F, 0xD5, 0x09,
+	0x9F, 0x13, 0x79, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09,
+	0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x9B, 0x11, 0x75, 0x0B, 0x3F, 0x95, 0xF9, 0x0F,
+	0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F,
+	0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0xD1, 0x35, 0x9B, 0x0F,
+	0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F,
+	0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F,
+	0xF5, 0x59, 0xBF, 0x03, 0xF5, 0x5B, 0xBF, 0x05, 0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D,
+	0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D,
+	0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D,
+	0x1B, 0x7F, 0xD5, 0x09, 0x9F, 0x13, 0x79, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05,
+	0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x17, 0x7B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05,
+	0x3F, 0x95, 0xF9, 0x0F, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B,
+	0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B,
+	0x55, 0xB9, 0x1F, 0x03, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F,
+	0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F,
+	0xF5, 0x59, 0xBF, 0x03, 0x79, 0xDF, 0x53, 0x09, 0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01,
+	0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01,
+	0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x9F, 0x13, 0x79, 0x0D,
+	0x33, 0x97, 0xFD, 0x01, 0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D,
+	0x93, 0xF7, 0x5D, 0x01, 0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D,
+	0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05, 0xD3, 0x39, 0x9D, 0x03, 0x57, 0xBD, 0x31, 0x07,
+	0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07,
+	0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07,
+	0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xF9, 0x5D, 0xB3, 0x07, 0x7D, 0xF1, 0x57, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B,
+	0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x1D, 0x73, 0xD7, 0x0D, 0xB1, 0x17, 0x7B, 0x01,
+	0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01,
+	0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x33, 0x97, 0xFD, 0x01,
+	0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01,
+	0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01,
+	0x77, 0xDB, 0x31, 0x05, 0x57, 0xBD, 0x31, 0x07, 0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F,
+	0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F,
+	0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F,
+	0x7D, 0xF1, 0x57, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07,
+	0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x99, 0xFD, 0x53, 0x07,
+	0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07,
+	0xB1, 0x17, 0x7B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D,
+	0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D,
+	0xD7, 0x3B, 0x91, 0x05, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01,
+	0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01,
+	0x77, 0xDB, 0x31, 0x05, 0xFB, 0x51, 0xB5, 0x0B, 0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03,
+	0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0x11, 0x75, 0xDB, 0x0F,
+	0xB5, 0x19, 0x7F, 0x03, 0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F,
+	0xF5, 0x59, 0xBF, 0x03, 0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F,
+	0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07, 0x35, 0x9B, 0xFF, 0x05, 0xD9, 0x3F, 0x93, 0x09,
+	0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09,
+	0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09,
+	0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x5B, 0xBF, 0x35, 0x09, 0xFF, 0x53, 0xB9, 0x0D,
+	0x93, 0xF7, 0x5D, 0x01, 0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D,
+	0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05, 0x7F, 0xF5, 0x59, 0x0F, 0x13, 0x79, 0xDD, 0x03,
+	0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xB5, 0x19, 0x7F, 0x03,
+	0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03,
+	0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03,
+	0xD9, 0x3D, 0xB3, 0x07, 0xD9, 0x3F, 0x93, 0x09, 0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01,
+	0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01,
+	0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01,
+	0xFF, 0x53, 0xB9, 0x0D, 0x93, 0xF7, 0x5D, 0x01, 0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09,
+	0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05, 0xFB, 0x5F, 0xD5, 0x09,
+	0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09,
+	0x13, 0x79, 0xDD, 0x03, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F,
+	0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F,
+	0x39, 0x9D, 0x13, 0x07, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03,
+	0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03,
+	0xD9, 0x3D, 0xB3, 0x07, 0x5D, 0xD3, 0x37, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05,
+	0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05,
+	0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x93, 0xF7, 0x5D, 0x01,
+	0x17, 0x7B, 0xF1, 0x05, 0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01,
+	0x77, 0xDB, 0x31, 0x05, 0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01,
+	0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09, 0xB7, 0x1D, 0x71, 0x07, 0x3B, 0xB1, 0x15, 0x0B,
+	0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B,
+	0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B,
+	0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0xDD, 0x31, 0x97, 0x0B, 0x71, 0xD5, 0x3B, 0x0F,
+	0xF5, 0x59, 0xBF, 0x03, 0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F,
+	0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07, 0xF1, 0x57, 0xBB, 0x01, 0x95, 0xFB, 0x5F, 0x05,
+	0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05,
+	0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x17, 0x7B, 0xF1, 0x05,
+	0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05,
+	0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05,
+	0x5B, 0xBF, 0x15, 0x09, 0x3B, 0xB1, 0x15, 0x0B, 0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03,
+	0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03,
+	0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03,
+	0x71, 0xD5, 0x3B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B,
+	0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07, 0x7D, 0xD1, 0x37, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07, 0xBD, 0x31, 0x97, 0x0B,
+	0x95, 0xFB, 0x5F, 0x05, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01,
+	0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01,
+	0xBB, 0x1F, 0x75, 0x09, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05,
+	0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05,
+	0x5B, 0xBF, 0x15, 0x09, 0xDF, 0x35, 0x99, 0x0F, 0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07,
+	0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07,
+	0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0xF5, 0x59, 0xBF, 0x03,
+	0x99, 0xFD, 0x53, 0x07, 0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03,
+	0xD9, 0x3D, 0xB3, 0x07, 0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03,
+	0x39, 0x9D, 0xF3, 0x07, 0xBD, 0x31, 0x97, 0x0B, 0x19, 0x7F, 0xF3, 0x09, 0xBD, 0x13, 0x77, 0x0D,
+	0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D,
+	0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xB9, 0x1F, 0x93, 0x09, 0x5D, 0xB3, 0x17, 0x0D,
+	0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0x3F, 0xB3, 0x19, 0x0D, 0xD3, 0x37, 0x9D, 0x01,
+	0x77, 0xDB, 0x31, 0x05, 0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01,
+	0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09, 0x73, 0xD9, 0x3D, 0x03, 0xF7, 0x5D, 0xD1, 0x07,
+	0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07,
+	0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0x99, 0xFD, 0x53, 0x07,
+	0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07,
+	0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07,
+	0xBD, 0x31, 0x97, 0x0B, 0xBD, 0x13, 0x77, 0x0D, 0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05,
+	0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05,
+	0xB9, 0x1F, 0x93, 0x09, 0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05,
+	0xD3, 0x37, 0x9D, 0x01, 0x77, 0xDB, 0x31, 0x05, 0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D,
+	0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09, 0xDF, 0x53, 0xB9, 0x0D,
+	0x73, 0xD7, 0x3D, 0x01, 0x17, 0x7B, 0xD1, 0x05, 0x9B, 0xFF, 0x75, 0x09, 0x3F, 0x93, 0xF9, 0x0D,
+	0xF7, 0x5D, 0xD1, 0x07, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03,
+	0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03,
+	0x1D, 0x91, 0xF7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07,
+	0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07,
+	0xBD, 0x31, 0x97, 0x0B, 0x51, 0xB7, 0x1B, 0x01, 0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09,
+	0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xB9, 0x1F, 0x93, 0x09,
+	0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0x77, 0xDB, 0x31, 0x05,
+	0xFB, 0x5F, 0xD5, 0x09, 0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05,
+	0x5B, 0xBF, 0x15, 0x09, 0xDF, 0x53, 0xB9, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0x17, 0x7B, 0xD1, 0x05,
+	0x9B, 0xFF, 0x75, 0x09, 0x3F, 0x93, 0xF9, 0x0D, 0x9B, 0xF1, 0x55, 0x0B, 0x1F, 0x95, 0xF9, 0x0F,
+	0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F,
+	0x13, 0x79, 0xDD, 0x03, 0x97, 0xFD, 0x71, 0x07, 0x3B, 0x91, 0xF5, 0x0B, 0xBF, 0x35, 0x99, 0x0F,
+	0x53, 0xB9, 0x1D, 0x03, 0xF7, 0x5D, 0xB1, 0x07, 0xB1, 0x15, 0x7B, 0x0F, 0x55, 0xB9, 0x1F, 0x03,
+	0xD9, 0x3D, 0xB3, 0x07, 0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03,
+	0x39, 0x9D, 0xF3, 0x07, 0xBD, 0x31, 0x97, 0x0B, 0xD5, 0x3B, 0x9F, 0x05, 0x79, 0xDF, 0x33, 0x09,
+	0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xB9, 0x1F, 0x93, 0x09,
+	0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0xFB, 0x5F, 0xD5, 0x09,
+	0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09,
+	0xDF, 0x53, 0xB9, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0x17, 0x7B, 0xD1, 0x05, 0x9B, 0xFF, 0x75, 0x09,
+	0x3F, 0x93, 0xF9, 0x0D, 0x1F, 0x95, 0xF9, 0x0F, 0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07,
+	0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0x97, 0xFD, 0x71, 0x07,
+	0x3B, 0x91, 0xF5, 0x0B, 0xBF, 0x35, 0x99, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xF7, 0x5D, 0xB1, 0x07,
+	0x55, 0xB9, 0x1F, 0x03, 0xD9, 0x3D, 0xB3, 0x07, 0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F,
+	0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07, 0xBD, 0x31, 0x97, 0x0B, 0x51, 0xB5, 0x1B, 0x0F,
+	0xF5, 0x59, 0xBF, 0x03, 0x79, 0xDD, 0x53, 0x07, 0x1D, 0x71, 0xD7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F,
+	0x79, 0xDF, 0x33, 0x09, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05,
+	0xB9, 0x1F, 0x93, 0x09, 0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05,
+	0x9F, 0xF3, 0x59, 0x0D, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09,
+	0xDF, 0x53, 0xB9, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0x17, 0x7B, 0xD1, 0x05, 0x9B, 0xFF, 0x75, 0x09,
+	0x3F, 0x93, 0xF9, 0x0D, 0xB3, 0x19, 0x7D, 0x03, 0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B,
+	0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0x97, 0xFD, 0x71, 0x07, 0x3B, 0x91, 0xF5, 0x0B,
+	0xBF, 0x35, 0x99, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xF7, 0x5D, 0xB1, 0x07, 0xD9, 0x3D, 0xB3, 0x07,
+	0x7D, 0xD1, 0x37, 0x0B, 0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07,
+	0xBD, 0x31, 0x97, 0x0B, 0x51, 0xB5, 0x1B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x79, 0xDD, 0x53, 0x07,
+	0x1D, 0x71, 0xD7, 0x0B, 0xB1, 0x15, 0x7B, 0x0F, 0xFD, 0x73, 0xD7, 0x0D, 0x91, 0xF7, 0x5B, 0x01,
+	0x35, 0x9B, 0xFF, 0x05, 0xB9, 0x1F, 0x93, 0x09, 0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01,
+	0x75, 0xDB, 0x3F, 0x05, 0x19, 0x7F, 0xD3, 0x09, 0x9D, 0x13, 0x77, 0x0D, 0x31, 0x97, 0xFB, 0x01,
+	0xD5, 0x3B, 0x9F, 0x05, 0x59, 0xBF, 0x33, 0x09, 0x33, 0x97, 0xFD, 0x01, 0xB7, 0x1B, 0x91, 0x05,
+	0x5B, 0xBF, 0x15, 0x09, 0xDF, 0x53, 0xB9, 0x0D, 0x73, 0xD7, 0x3D, 0x01, 0x17, 0x7B, 0xD1, 0x05,
+	0x9B, 0xFF, 0x75, 0x09, 0x3F, 0x93, 0xF9, 0x0D, 0x57, 0xBD, 0x11, 0x07, 0xDB, 0x51, 0xB5, 0x0B,
+	0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0x97, 0xFD, 0x71, 0x07, 0x3B, 0x91, 0xF5, 0x0B,
+	0xBF, 0x35, 0x99, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xF7, 0x5D, 0xB1, 0x07, 0x7D, 0xD1, 0x37, 0x0B,
+	0x11, 0x75, 0xDB, 0x0F, 0x95, 0xF9, 0x5F, 0x03, 0x39, 0x9D, 0xF3, 0x07, 0xBD, 0x31, 0x97, 0x0B,
+	0x51, 0xB5, 0x1B, 0x0F, 0xF5, 0x59, 0xBF, 0x03, 0x79, 0xDD, 0x53, 0x07, 0x1D, 0x71, 0xD7, 0x0B,
+	0xB1, 0x15, 0x7B, 0x0F, 0x91, 0xF7, 0x5B, 0x01, 0x35, 0x9B, 0xFF, 0x05, 0xB9, 0x1F, 0x93, 0x09,
+	0x5D, 0xB3, 0x17, 0x0D, 0xF1, 0x57, 0xBB, 0x01, 0x75, 0xDB, 0x3F, 0x05, 0x19, 0x7F, 0xD3, 0x09,
+	0x9D, 0x13, 0x77, 0x0D, 0x31, 0x97, 0xFB, 0x01, 0xD5, 0x3B, 0x9F, 0x05, 0x59, 0xBF, 0x33, 0x09,
+	0xB7, 0x1B, 0x91, 0x05, 0x5B, 0xBF, 0x15, 0x09, 0xDF, 0x53, 0xB9, 0x0D, 0x73, 0xD7, 0x3D, 0x01,
+	0x17, 0x7B, 0xD1, 0x05, 0x9B, 0xFF, 0x75, 0x09, 0x3F, 0x93, 0xF9, 0x0D, 0xD3, 0x37, 0x9D, 0x01,
+	0x57, 0xBB, 0x31, 0x05, 0xFB, 0x5F, 0xB5, 0x09, 0x7F, 0xF3, 0x59, 0x0D, 0x13, 0x77, 0xDD, 0x01,
+	0xDB, 0x51, 0xB5, 0x0B, 0x7F, 0xD5, 0x39, 0x0F, 0x13, 0x79, 0xDD, 0x03, 0x97, 0xFD, 0x71, 0x07,
+	0x3B, 0x91, 0xF5, 0x0B, 0xBF, 0x35, 0x99, 0x0F, 0x53, 0xB9, 0x1D, 0x03, 0xF7, 0x5D, 0xB1, 0x07,
+};
+
+#endif
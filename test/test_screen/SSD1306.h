@@ -0,0 +1,115 @@
+#ifndef __FAKE_SSD1306__
+#define __FAKE_SSD1306__
+
+#include <Arduino.h>
+#include "OLEDDisplayFonts.h"
+
+// The framebuffer and drawing of the display library, as far as Screen uses them. Text is drawn
+// from fonts in the library's format the way OLEDDisplay does it. ArialMT_Plain_24 comes from
+// the library, which the host doesn't have, so the made up font of OLEDDisplayFonts.h stands in.
+
+enum OLEDDISPLAY_TEXT_ALIGNMENT { TEXT_ALIGN_LEFT, TEXT_ALIGN_RIGHT, TEXT_ALIGN_CENTER, TEXT_ALIGN_CENTER_BOTH };
+
+class SSD1306 {
+public:
+    SSD1306(uint8_t /* address */, uint8_t /* sda */, uint8_t /* scl */) {
+        clear();
+    }
+
+    void clear() {
+        memset(buffer, 0, sizeof buffer);
+    }
+
+    void setFont(const uint8_t *font) {
+        this->font = font;
+    }
+
+    void setTextAlignment(OLEDDISPLAY_TEXT_ALIGNMENT alignment) {
+        this->alignment = alignment;
+    }
+
+    void drawString(int16_t x, int16_t y, const char *text) {
+        char latin1[64];
+        toLatin1(text, latin1, sizeof latin1);
+        uint16_t width = stringWidth(latin1);
+        if(alignment == TEXT_ALIGN_RIGHT) {
+            x -= width;
+        } else if(alignment == TEXT_ALIGN_CENTER) {
+            x -= width / 2;
+        }
+        uint8_t first = font[2];
+        uint8_t count = font[3];
+        uint8_t raster = 1 + ((font[1] - 1) >> 3);
+        const uint8_t *bitmaps = font + 4 + count * 4;
+        for(const char *c = latin1; *c; c++) {
+            uint8_t code = *c;
+            if(code < first || code >= first + count) {
+                continue;
+            }
+            const uint8_t *jump = font + 4 + (code - first) * 4;
+            if(!(jump[0] == 0xFF && jump[1] == 0xFF)) {
+                const uint8_t *bitmap = bitmaps + (jump[0] << 8 | jump[1]);
+                for(uint8_t i = 0; i < jump[2]; i++) {
+                    for(uint8_t bit = 0; bit < 8; bit++) {
+                        if(bitmap[i] & (1 << bit)) {
+                            setPixel(x + i / raster, y + i % raster * 8 + bit);
+                        }
+                    }
+                }
+            }
+            x += jump[3];
+        }
+    }
+
+    // rows of bits, least significant first, like OLEDDisplay::drawXbm
+    void drawXbm(int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *xbm) {
+        int16_t rowBytes = (width + 7) / 8;
+        for(int16_t row = 0; row < height; row++) {
+            for(int16_t column = 0; column < width; column++) {
+                if(xbm[row * rowBytes + column / 8] & (1 << (column % 8))) {
+                    setPixel(x + column, y + row);
+                }
+            }
+        }
+    }
+
+    uint8_t buffer[1024];
+
+private:
+    void setPixel(int16_t x, int16_t y) {
+        if(x >= 0 && x < 128 && y >= 0 && y < 64) {
+            buffer[x + (y / 8) * 128] |= 1 << (y & 7);
+        }
+    }
+
+    uint16_t stringWidth(const char *text) {
+        uint16_t width = 0;
+        for(const char *c = text; *c; c++) {
+            uint8_t code = *c;
+            if(code >= font[2] && code < font[2] + font[3]) {
+                width += font[4 + (code - font[2]) * 4 + 3];
+            }
+        }
+        return width;
+    }
+
+    // the library draws UTF-8 as Latin-1, like the ° of the temperature
+    static void toLatin1(const char *text, char *latin1, size_t size) {
+        size_t n = 0;
+        for(const uint8_t *c = (const uint8_t *) text; *c && n + 1 < size; c++) {
+            if(*c == 0xC2 && c[1] != 0) {
+                latin1[n++] = *++c;
+            } else if(*c == 0xC3 && c[1] != 0) {
+                latin1[n++] = *++c | 0xC0;
+            } else {
+                latin1[n++] = *c;
+            }
+        }
+        latin1[n] = 0;
+    }
+
+    const uint8_t *font = ArialMT_Plain_24;
+    OLEDDISPLAY_TEXT_ALIGNMENT alignment = TEXT_ALIGN_LEFT;
+};
+
+#endif
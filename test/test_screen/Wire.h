@@ -0,0 +1,74 @@
+#ifndef __FAKE_WIRE__
+#define __FAKE_WIRE__
+
+#include <stdint.h>
+#include <string.h>
+
+// Stands in for the I2C bus with the SSD1306 on it, keeping what the panel would show. Only the
+// horizontal addressing mode the library sets up: a 0x80 control byte announces a command
+// byte, 0x40 data bytes written from the column and page window set with 0x21 and 0x22.
+class TwoWire {
+public:
+    void beginTransmission(uint8_t address) {
+        this->address = address;
+        first = true;
+        data = false;
+    }
+
+    size_t write(uint8_t value) {
+        if(first) {
+            first = false;
+            data = value == 0x40;
+            return 1;
+        }
+        if(data) {
+            ram[page * 128 + column] = value;
+            bytes++;
+            if(column == columnEnd) {
+                column = columnStart;
+                page = page == pageEnd ? pageStart : page + 1;
+            } else {
+                column++;
+            }
+        } else {
+            command(value);
+        }
+        return 1;
+    }
+
+    uint8_t endTransmission(bool /* stop */ = true) {
+        return 0;
+    }
+
+    uint8_t ram[1024];
+    unsigned long bytes = 0;
+    uint8_t address = 0;
+
+private:
+    void command(uint8_t value) {
+        switch(argument) {
+        case COLUMN_START: columnStart = column = value; argument = COLUMN_END; return;
+        case COLUMN_END: columnEnd = value; argument = NONE; return;
+        case PAGE_START: pageStart = page = value; argument = PAGE_END; return;
+        case PAGE_END: pageEnd = value; argument = NONE; return;
+        default: break;
+        }
+        if(value == 0x21) {
+            argument = COLUMN_START;
+        } else if(value == 0x22) {
+            argument = PAGE_START;
+        }
+    }
+
+    enum Argument { NONE, COLUMN_START, COLUMN_END, PAGE_START, PAGE_END };
+
+    bool first = false;
+    bool data = false;
+    Argument argument = NONE;
+    uint8_t columnStart = 0, columnEnd = 127, pageStart = 0, pageEnd = 7;
+    uint8_t column = 0, page = 0;
+};
+
+TwoWire Wire;
+
+#endif
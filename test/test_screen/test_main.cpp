@@ -0,0 +1,223 @@
+#include <unity.h>
+#include <stdio.h>
+// the fonts the subsets were made from, see scripts/subset_fonts.py
+#define FONTS_SUBSET_ORIGINALS
+#include "../../src/font.h"
+#include "../../src/screen.h"
+#include "../../src/status.h"
+
+// What Screen leaves on the panel after any sequence of updates has to be exactly what drawing
+// the last content from scratch gives. The panel is the fake I2C bus in Wire.h, which keeps the
+// bytes the pages sent carry.
+//
+// The font subsets have to draw exactly what the fonts they were made from do, in less flash.
+// Without the library, the readings subset is made from the stand-in of OLEDDisplayFonts.h.
+
+SSD1306 *display;
+Screen *screen;
+
+ScreenContent makeContent(const char *temperature, const char *humidity, const char *status, const uint8_t *icon) {
+    ScreenContent content = {};
+    strncpy(content.temperature, temperature, sizeof content.temperature - 1);
+    strncpy(content.humidity, humidity, sizeof content.humidity - 1);
+    strncpy(content.status, status, sizeof content.status - 1);
+    content.icon = icon;
+    return content;
+}
+
+// the framebuffer of a full redraw, without touching the panel
+void fullRedraw(const ScreenContent &content, uint8_t *frame) {
+    uint8_t panel[sizeof Wire.ram];
+    memcpy(panel, Wire.ram, sizeof panel);
+    SSD1306 fresh(0x3c, 0, 0);
+    Screen redraw(fresh, 0x3c);
+    redraw.show(content);
+    memcpy(frame, fresh.buffer, sizeof fresh.buffer);
+    memcpy(Wire.ram, panel, sizeof panel);
+}
+
+void assertPanelShows(const ScreenContent &content) {
+    uint8_t expected[1024];
+    fullRedraw(content, expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, Wire.ram, sizeof expected);
+}
+
+// after deep sleep, with the panel still showing what it did but a new, empty framebuffer
+void deepSleep() {
+    uint32_t hash = screen->shownHash();
+    delete screen;
+    delete display;
+    display = new SSD1306(0x3c, 0, 0);
+    screen = new Screen(*display, 0x3c);
+    screen->restore(hash);
+}
+
+void setUp() {
+    // whatever the panel showed before
+    memset(Wire.ram, 0xA5, sizeof Wire.ram);
+    display = new SSD1306(0x3c, 0, 0);
+    screen = new Screen(*display, 0x3c);
+    screen->invalidate();
+}
+
+void tearDown() {
+    delete screen;
+    delete display;
+}
+
+void test_first_show_draws_everything() {
+    ScreenContent content = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits);
+    TEST_ASSERT_TRUE(screen->show(content));
+    TEST_ASSERT_EQUAL(SCREEN_PAGES, screen->pagesSent);
+    assertPanelShows(content);
+}
+
+void test_same_content_sends_nothing() {
+    ScreenContent content = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits);
+    screen->show(content);
+    unsigned long bytes = Wire.bytes;
+    TEST_ASSERT_FALSE(screen->show(content));
+    TEST_ASSERT_EQUAL(1, screen->transfers);
+    TEST_ASSERT_EQUAL(bytes, Wire.bytes);
+}
+
+void test_changed_readings_send_their_pages() {
+    screen->show(makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits));
+    ScreenContent content = makeContent("21.5°", "46%", "192.168.1.20", status_wifi_full_bits);
+    TEST_ASSERT_TRUE(screen->show(content));
+    TEST_ASSERT_EQUAL(SCREEN_PAGES + 4, screen->pagesSent);
+    assertPanelShows(content);
+}
+
+void test_changed_status_sends_its_pages() {
+    screen->show(makeContent("21.4°", "46%", "Connecting", status_wifi_connecting_bits));
+    ScreenContent content = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits);
+    TEST_ASSERT_TRUE(screen->show(content));
+    TEST_ASSERT_EQUAL(SCREEN_PAGES + 2, screen->pagesSent);
+    assertPanelShows(content);
+}
+
+void test_icon_alone_is_a_change() {
+    screen->show(makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits));
+    ScreenContent content = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_poor_bits);
+    TEST_ASSERT_TRUE(screen->show(content));
+    assertPanelShows(content);
+    content.icon = NULL;
+    TEST_ASSERT_TRUE(screen->show(content));
+    assertPanelShows(content);
+}
+
+void test_sequence_matches_full_redraw() {
+    const char *temperatures[] = { "21.4°", "21.5°", "-3.0°", "nan°", "21.5°" };
+    const char *humidities[] = { "46%", "100%", "7%", "nan%" };
+    const char *statuses[] = { "Connecting", "192.168.1.20", "Press button to connect", "" };
+    const uint8_t *icons[] = { status_wifi_connecting_bits, status_wifi_full_bits, NULL, status_wifi_deepsleep_bits };
+    for(uint8_t i = 0; i < 40; i++) {
+        ScreenContent content = makeContent(temperatures[i % 5], humidities[i * 3 % 4], statuses[i / 3 % 4], icons[i / 7 % 4]);
+        screen->show(content);
+        assertPanelShows(content);
+    }
+}
+
+void test_restored_content_sends_nothing() {
+    ScreenContent content = makeContent("21.4°", "46%", "Press button to connect", NULL);
+    screen->show(content);
+    deepSleep();
+    unsigned long bytes = Wire.bytes;
+    TEST_ASSERT_FALSE(screen->show(content));
+    TEST_ASSERT_EQUAL(bytes, Wire.bytes);
+    assertPanelShows(content);
+}
+
+void test_change_after_restore_keeps_clean_pages() {
+    screen->show(makeContent("21.4°", "46%", "Press button to connect", NULL));
+    deepSleep();
+    screen->show(makeContent("21.4°", "46%", "Press button to connect", NULL));
+    // the status pages were never drawn into the new framebuffer, and mustn't be sent
+    ScreenContent content = makeContent("19.9°", "52%", "Press button to connect", NULL);
+    TEST_ASSERT_TRUE(screen->show(content));
+    TEST_ASSERT_EQUAL(4, screen->pagesSent);
+    assertPanelShows(content);
+}
+
+void test_other_content_after_restore_redraws() {
+    screen->show(makeContent("21.4°", "46%", "Press button to connect", NULL));
+    deepSleep();
+    ScreenContent content = makeContent("21.4°", "47%", "Press button to connect", NULL);
+    TEST_ASSERT_TRUE(screen->show(content));
+    TEST_ASSERT_EQUAL(SCREEN_PAGES, screen->pagesSent);
+    assertPanelShows(content);
+}
+
+void test_hash_covers_text_and_icon() {
+    ScreenContent content = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits);
+    ScreenContent same = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_full_bits);
+    TEST_ASSERT_EQUAL_HEX32(Screen::hash(content), Screen::hash(same));
+    ScreenContent icon = makeContent("21.4°", "46%", "192.168.1.20", status_wifi_poor_bits);
+    TEST_ASSERT_NOT_EQUAL(Screen::hash(content), Screen::hash(icon));
+    // text moving between fields is another screen
+    ScreenContent moved = makeContent("21.4°4", "6%", "192.168.1.20", status_wifi_full_bits);
+    TEST_ASSERT_NOT_EQUAL(Screen::hash(content), Screen::hash(moved));
+    TEST_ASSERT_NOT_EQUAL(0, Screen::hash(content));
+}
+
+// the framebuffer of each text drawn alone
+void drawTexts(const uint8_t *font, const char *const *texts, uint8_t n, uint8_t frames[][1024]) {
+    SSD1306 fresh(0x3c, 0, 0);
+    fresh.setFont(font);
+    fresh.setTextAlignment(TEXT_ALIGN_LEFT);
+    for(uint8_t i = 0; i < n; i++) {
+        fresh.clear();
+        fresh.drawString(0, 0, texts[i]);
+        memcpy(frames[i], fresh.buffer, sizeof fresh.buffer);
+    }
+}
+
+void compareFonts(const char *name, const uint8_t *original, size_t originalSize, const uint8_t *subset, size_t subsetSize,
+        const char *const *texts, uint8_t n) {
+    uint8_t expected[8][1024];
+    uint8_t actual[8][1024];
+    drawTexts(original, texts, n, expected);
+    drawTexts(subset, texts, n, actual);
+    for(uint8_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_MEMORY(expected[i], actual[i], sizeof expected[i]);
+    }
+    char message[96];
+    snprintf(message, sizeof message, "%s: %u bytes of flash, subset %u bytes", name, (unsigned) originalSize, (unsigned) subsetSize);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(originalSize, subsetSize);
+}
+
+void test_status_font_subset() {
+    const char *texts[STATUS_LINES + 2];
+    for(uint8_t i = 0; i < STATUS_LINES; i++) {
+        texts[i] = statusLines[i];
+    }
+    texts[STATUS_LINES] = "192.168.100.254";
+    texts[STATUS_LINES + 1] = "10.0.0.7";
+    compareFonts("Dialog_plain_10", Dialog_plain_10, sizeof Dialog_plain_10, Dialog_plain_10_subset, sizeof Dialog_plain_10_subset,
+        texts, STATUS_LINES + 2);
+}
+
+void test_readings_font_subset() {
+    const char *texts[] = { "21.4°", "-13.0°", "nan°", "100%", "7%", "nan%" };
+    compareFonts("ArialMT_Plain_24", ArialMT_Plain_24_original, sizeof ArialMT_Plain_24_original,
+        ArialMT_Plain_24_subset, sizeof ArialMT_Plain_24_subset, texts, sizeof texts / sizeof texts[0]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_show_draws_everything);
+    RUN_TEST(test_same_content_sends_nothing);
+    RUN_TEST(test_changed_readings_send_their_pages);
+    RUN_TEST(test_changed_status_sends_its_pages);
+    RUN_TEST(test_icon_alone_is_a_change);
+    RUN_TEST(test_sequence_matches_full_redraw);
+    RUN_TEST(test_restored_content_sends_nothing);
+    RUN_TEST(test_change_after_restore_keeps_clean_pages);
+    RUN_TEST(test_other_content_after_restore_redraws);
+    RUN_TEST(test_hash_covers_text_and_icon);
+    RUN_TEST(test_status_font_subset);
+    RUN_TEST(test_readings_font_subset);
+    return UNITY_END();
+}
@@ -0,0 +1,21 @@
+#ifndef __FAKE_ARDUINO__
+#define __FAKE_ARDUINO__
+
+// The little of the Arduino core that bmp280.h needs, on the host, with a clock that only moves
+// when delay() is called
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+unsigned long fakeMillis = 0;
+
+unsigned long millis() {
+    return fakeMillis;
+}
+
+void delay(unsigned long ms) {
+    fakeMillis += ms;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef __FAKE_WIRE__
+#define __FAKE_WIRE__
+
+#include <stdint.h>
+#include <string.h>
+
+// Stands in for the I2C bus with a single device on it, a register file like the BMP280's: the
+// first byte written selects the register, further bytes are written from there on, reads go on
+// from the selected register. Addresses nobody answers at get a NACK.
+class TwoWire {
+public:
+    void beginTransmission(uint8_t address) {
+        this->address = address;
+        first = true;
+    }
+
+    size_t write(uint8_t value) {
+        if(first) {
+            first = false;
+            reg = value;
+        } else {
+            registers[reg++] = value;
+            writes++;
+            if(value == measureCommand) {
+                // measuring for the next few status reads
+                registers[statusRegister] = 0x08;
+                busyReads = measureReads;
+            }
+        }
+        return 1;
+    }
+
+    uint8_t endTransmission(bool /* stop */ = true) {
+        return address == device ? 0 : 2;
+    }
+
+    uint8_t requestFrom(uint8_t address, uint8_t length) {
+        if(address != device) {
+            return 0;
+        }
+        if(reg == statusRegister && busyReads > 0 && --busyReads == 0) {
+            registers[statusRegister] = 0;
+        }
+        return length;
+    }
+
+    int read() {
+        return registers[reg++];
+    }
+
+    uint8_t device = 0;
+    uint8_t registers[256];
+    uint8_t measureCommand = 0;
+    uint8_t statusRegister = 0;
+    uint8_t measureReads = 0;
+    unsigned writes = 0;
+
+private:
+    uint8_t address = 0;
+    uint8_t reg = 0;
+    bool first = false;
+    uint8_t busyReads = 0;
+};
+
+TwoWire Wire;
+
+#endif
@@ -0,0 +1,288 @@
+#include <unity.h>
+#include <math.h>
+#include "../../src/config.h"
+#include "../../src/bmp280.h"
+
+// SensorRegistry with a fake bus: what a scan finds and caches in the settings, setting up the
+// drivers from that cache without probing, and sensors that don't start or fail to measure. The
+// BMP280 driver runs against a fake Wire holding the registers of the datasheet's worked example.
+
+// A driver that reports what it's told
+class FakeSensor : public SensorDriver {
+public:
+    bool begin() override {
+        begins++;
+        return starts;
+    }
+
+    bool measure(SensorReading &reading) override {
+        measures++;
+        reading.temperature_C = temperature_C;
+        reading.humidity_pct = NAN;
+        reading.pressure_hPa = NAN;
+        return works;
+    }
+
+    void sleep() override {
+        sleeps++;
+    }
+
+    const char *lastError() override {
+        return works ? "none" : "failed";
+    }
+
+    bool starts = true;
+    bool works = true;
+    float temperature_C = 20;
+    unsigned begins = 0;
+    unsigned measures = 0;
+    unsigned sleeps = 0;
+};
+
+// Devices at some of the addresses, a fake driver for each of the addresses that has one
+class FakeBus : public SensorBus {
+public:
+    bool probe(uint8_t address) override {
+        probes++;
+        probed[address] = true;
+        return present[address];
+    }
+
+    SensorDriver *driver(uint8_t /* kind */, uint8_t address) override {
+        return hasDriver[address] ? &sensors[address] : NULL;
+    }
+
+    void attach(uint8_t address) {
+        present[address] = true;
+        hasDriver[address] = true;
+    }
+
+    bool present[128] = {};
+    bool hasDriver[128] = {};
+    bool probed[128] = {};
+    unsigned probes = 0;
+    FakeSensor sensors[128];
+};
+
+// BMP280 compensation parameters and raw readings of the datasheet's worked example (3.11.3)
+const uint16_t DIG_T1 = 27504;
+const int16_t DIG_T2 = 26435, DIG_T3 = -1000;
+const uint16_t DIG_P1 = 36477;
+const int16_t DIG_P[8] = { -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+const int32_t ADC_T = 519888, ADC_P = 415148;
+
+FakeBus *bus;
+SensorRegistry *registry;
+
+void putWord(uint8_t reg, uint16_t value) {
+    Wire.registers[reg] = value & 0xFF;
+    Wire.registers[reg + 1] = value >> 8;
+}
+
+void put20Bits(uint8_t reg, int32_t value) {
+    Wire.registers[reg] = value >> 12;
+    Wire.registers[reg + 1] = value >> 4 & 0xFF;
+    Wire.registers[reg + 2] = (value & 0x0F) << 4;
+}
+
+// a BMP280 at 0x76 that measures the worked example
+void attachBMP280() {
+    memset(Wire.registers, 0, sizeof Wire.registers);
+    Wire.device = 0x76;
+    Wire.measureCommand = BMP280_FORCED_1X;
+    Wire.statusRegister = BMP280_REG_STATUS;
+    Wire.measureReads = 3;
+    Wire.registers[BMP280_REG_ID] = BMP280_CHIP_ID;
+    putWord(BMP280_REG_CALIBRATION, DIG_T1);
+    putWord(BMP280_REG_CALIBRATION + 2, DIG_T2);
+    putWord(BMP280_REG_CALIBRATION + 4, DIG_T3);
+    putWord(BMP280_REG_CALIBRATION + 6, DIG_P1);
+    for(uint8_t i = 0; i < 8; i++) {
+        putWord(BMP280_REG_CALIBRATION + 8 + 2 * i, DIG_P[i]);
+    }
+    put20Bits(BMP280_REG_DATA, ADC_P);
+    put20Bits(BMP280_REG_DATA + 3, ADC_T);
+}
+
+void setUp() {
+    bus = new FakeBus();
+    registry = new SensorRegistry();
+    memset(settings.sensorSlots, 0, sizeof settings.sensorSlots);
+    Wire.device = 0;
+    Wire.writes = 0;
+    fakeMillis = 0;
+}
+
+void tearDown() {
+    delete registry;
+    delete bus;
+}
+
+void test_empty_bus() {
+    TEST_ASSERT_FALSE(registry->scan(*bus, settings.sensorSlots));
+    TEST_ASSERT_EQUAL(0, registry->size());
+    // every address but the climate sensor's
+    TEST_ASSERT_EQUAL(sizeof sensorProbes / sizeof sensorProbes[0] - 1, bus->probes);
+    TEST_ASSERT_FALSE(bus->probed[SENSOR_PRIMARY_ADDRESS]);
+}
+
+void test_scan_caches_slots() {
+    bus->attach(SENSOR_PRIMARY_ADDRESS);
+    bus->attach(0x45);
+    bus->attach(0x77);
+    TEST_ASSERT_TRUE(registry->scan(*bus, settings.sensorSlots));
+    TEST_ASSERT_EQUAL(2, registry->size());
+    TEST_ASSERT_EQUAL_HEX16(makeSensorSlot(SENSOR_KIND_SHT31, 0x45), settings.sensorSlots[0]);
+    TEST_ASSERT_EQUAL_HEX16(makeSensorSlot(SENSOR_KIND_BMP280, 0x77), settings.sensorSlots[1]);
+    TEST_ASSERT_EQUAL(0, settings.sensorSlots[2]);
+    TEST_ASSERT_EQUAL(0, settings.sensorSlots[SENSOR_SLOTS - 1]);
+    // the climate sensor is read through halSensor(), not the registry
+    TEST_ASSERT_EQUAL(0, bus->sensors[SENSOR_PRIMARY_ADDRESS].begins);
+
+    char name[16];
+    SensorRegistry::name(registry->at(0), name, sizeof name);
+    TEST_ASSERT_EQUAL_STRING("sht31_45", name);
+    SensorRegistry::name(registry->at(1), name, sizeof name);
+    TEST_ASSERT_EQUAL_STRING("bmp280_77", name);
+
+    // the same sensors on the next cold boot leave the settings alone
+    SensorRegistry again;
+    TEST_ASSERT_FALSE(again.scan(*bus, settings.sensorSlots));
+    TEST_ASSERT_EQUAL(2, again.size());
+}
+
+void test_removed_sensor_changes_slots() {
+    bus->attach(0x45);
+    bus->attach(0x76);
+    registry->scan(*bus, settings.sensorSlots);
+    bus->present[0x45] = false;
+    TEST_ASSERT_TRUE(registry->scan(*bus, settings.sensorSlots));
+    TEST_ASSERT_EQUAL(1, registry->size());
+    TEST_ASSERT_EQUAL_HEX16(makeSensorSlot(SENSOR_KIND_BMP280, 0x76), settings.sensorSlots[0]);
+    TEST_ASSERT_EQUAL(0, settings.sensorSlots[1]);
+}
+
+void test_load_from_slots_without_probing() {
+    bus->attach(0x45);
+    bus->attach(0x76);
+    registry->scan(*bus, settings.sensorSlots);
+    unsigned probes = bus->probes;
+
+    // a deep sleep wake
+    SensorRegistry woken;
+    woken.load(*bus, settings.sensorSlots);
+    TEST_ASSERT_EQUAL(probes, bus->probes);
+    TEST_ASSERT_EQUAL(2, woken.size());
+    TEST_ASSERT_EQUAL(SENSOR_KIND_SHT31, woken.at(0).kind);
+    TEST_ASSERT_EQUAL(0x45, woken.at(0).address);
+    TEST_ASSERT_EQUAL(SENSOR_KIND_BMP280, woken.at(1).kind);
+    TEST_ASSERT_EQUAL(0x76, woken.at(1).address);
+    TEST_ASSERT_EQUAL(2, bus->sensors[0x45].begins);
+}
+
+void test_sensor_that_does_not_start_is_left_out() {
+    // something else answering at a sensor's address
+    bus->attach(0x45);
+    bus->attach(0x76);
+    bus->sensors[0x45].starts = false;
+    TEST_ASSERT_TRUE(registry->scan(*bus, settings.sensorSlots));
+    TEST_ASSERT_EQUAL(1, registry->size());
+    TEST_ASSERT_EQUAL(0x76, registry->at(0).address);
+    TEST_ASSERT_EQUAL_HEX16(makeSensorSlot(SENSOR_KIND_BMP280, 0x76), settings.sensorSlots[0]);
+
+    // a cached sensor gone missing since the scan
+    bus->present[0x76] = false;
+    bus->hasDriver[0x76] = false;
+    registry->load(*bus, settings.sensorSlots);
+    TEST_ASSERT_EQUAL(0, registry->size());
+}
+
+void test_measure_and_sleep() {
+    bus->attach(0x45);
+    bus->attach(0x76);
+    bus->sensors[0x45].temperature_C = 21.5f;
+    bus->sensors[0x76].works = false;
+    registry->scan(*bus, settings.sensorSlots);
+    TEST_ASSERT_EQUAL(1, registry->measure(1234));
+    TEST_ASSERT_TRUE(registry->at(0).valid);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, registry->at(0).reading.temperature_C);
+    TEST_ASSERT_EQUAL(1234, registry->at(0).timestamp_s);
+    TEST_ASSERT_FALSE(registry->at(1).valid);
+    TEST_ASSERT_EQUAL(1234, registry->at(1).timestamp_s);
+
+    // a sensor that fails once works again on the next measurement
+    bus->sensors[0x76].works = true;
+    TEST_ASSERT_EQUAL(2, registry->measure(1300));
+    TEST_ASSERT_TRUE(registry->at(1).valid);
+
+    registry->sleep();
+    TEST_ASSERT_EQUAL(1, bus->sensors[0x45].sleeps);
+    TEST_ASSERT_EQUAL(1, bus->sensors[0x76].sleeps);
+}
+
+void test_bmp280_datasheet_example() {
+    attachBMP280();
+    BMP280Sensor sensor(0x76);
+    TEST_ASSERT_TRUE(sensor.begin());
+    SensorReading reading;
+    TEST_ASSERT_TRUE(sensor.measure(reading));
+    TEST_ASSERT_EQUAL_STRING("none", sensor.lastError());
+    // t_fine 128422, 25.08 °C, and 25767233 / 256 = 100653.25 Pa from the 64 bit integer
+    // compensation, where the floating point one of the datasheet has 100653.27 Pa
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.08f, reading.temperature_C);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 25767233 / 25600.0f, reading.pressure_hPa);
+    TEST_ASSERT_TRUE(isnan(reading.humidity_pct));
+    // forced mode, waited while the status said it was measuring
+    TEST_ASSERT_EQUAL_HEX8(BMP280_FORCED_1X, Wire.registers[BMP280_REG_CTRL_MEAS]);
+    TEST_ASSERT_EQUAL(1, Wire.writes);
+    TEST_ASSERT_EQUAL(6, fakeMillis);
+}
+
+void test_bmp280_other_chip() {
+    attachBMP280();
+    // a BME280 answers at the same addresses
+    Wire.registers[BMP280_REG_ID] = 0x60;
+    BMP280Sensor sensor(0x76);
+    TEST_ASSERT_FALSE(sensor.begin());
+    TEST_ASSERT_EQUAL_STRING("not a BMP280", sensor.lastError());
+
+    BMP280Sensor absent(0x77);
+    TEST_ASSERT_FALSE(absent.begin());
+    TEST_ASSERT_EQUAL_STRING("no answer", absent.lastError());
+}
+
+void test_bmp280_gone_after_begin() {
+    attachBMP280();
+    BMP280Sensor sensor(0x76);
+    TEST_ASSERT_TRUE(sensor.begin());
+    Wire.device = 0;
+    SensorReading reading;
+    TEST_ASSERT_FALSE(sensor.measure(reading));
+    TEST_ASSERT_EQUAL_STRING("start failed", sensor.lastError());
+}
+
+void test_bmp280_stuck_measuring_times_out() {
+    attachBMP280();
+    Wire.measureReads = 255;
+    BMP280Sensor sensor(0x76);
+    TEST_ASSERT_TRUE(sensor.begin());
+    SensorReading reading;
+    // reads what's there once the time is up rather than waiting forever
+    TEST_ASSERT_TRUE(sensor.measure(reading));
+    TEST_ASSERT_EQUAL(BMP280_MEASURE_TIMEOUT_MS, fakeMillis);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_bus);
+    RUN_TEST(test_scan_caches_slots);
+    RUN_TEST(test_removed_sensor_changes_slots);
+    RUN_TEST(test_load_from_slots_without_probing);
+    RUN_TEST(test_sensor_that_does_not_start_is_left_out);
+    RUN_TEST(test_measure_and_sleep);
+    RUN_TEST(test_bmp280_datasheet_example);
+    RUN_TEST(test_bmp280_other_chip);
+    RUN_TEST(test_bmp280_gone_after_begin);
+    RUN_TEST(test_bmp280_stuck_measuring_times_out);
+    return UNITY_END();
+}
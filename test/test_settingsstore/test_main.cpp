@@ -0,0 +1,278 @@
+#include <unity.h>
+#include <string.h>
+#include "../../src/settingsstore.h"
+
+// The settings in EEPROM: migrating the struct the first firmware stored raw, the round trip
+// through the tag-length-value format and what happens to entries it doesn't know, entries cut
+// short and a checksum that doesn't match
+
+uint8_t eeprom[SETTINGS_STORE_SIZE];
+struct_settings loaded;
+
+void setUp() {
+    // erased flash
+    memset(eeprom, 0xFF, sizeof eeprom);
+    memset(&loaded, 0x5A, sizeof loaded);
+}
+
+void tearDown() {
+}
+
+// Builds a store by hand, entry by entry
+struct StoreWriter {
+    size_t length = SETTINGS_HEADER_SIZE;
+
+    void entry(uint8_t tag, const void *value, uint8_t size) {
+        eeprom[length++] = tag;
+        eeprom[length++] = size;
+        memcpy(eeprom + length, value, size);
+        length += size;
+    }
+
+    // with the payload ending at end, the whole of it by default
+    void finish(uint8_t version = SETTINGS_STORE_VERSION, size_t end = 0) {
+        size_t payload = (end == 0 ? length : end) - SETTINGS_HEADER_SIZE;
+        eeprom[0] = 'S';
+        eeprom[1] = 'T';
+        eeprom[2] = version;
+        eeprom[3] = payload & 0xFF;
+        eeprom[4] = payload >> 8;
+        uint16_t crc = crc16(eeprom, SETTINGS_HEADER_SIZE + payload);
+        eeprom[SETTINGS_HEADER_SIZE + payload] = crc & 0xFF;
+        eeprom[SETTINGS_HEADER_SIZE + payload + 1] = crc >> 8;
+    }
+};
+
+void assertDefaults(const struct_settings &s) {
+    struct_settings defaults;
+    defaultSettings(defaults);
+    TEST_ASSERT_EQUAL_MEMORY(&defaults, &s, sizeof s);
+}
+
+void test_erased_gives_defaults() {
+    TEST_ASSERT_EQUAL(SETTINGS_DEFAULTS, decodeSettings(eeprom, sizeof eeprom, loaded));
+    assertDefaults(loaded);
+}
+
+void test_migrates_legacy_struct() {
+    LegacySettings old;
+    memset(&old, 0, sizeof old);
+    old.magicNumber = LEGACY_MAGIC;
+    old.deepSleepTimer = 60;
+    old.influxEnabled = true;
+    strcpy(old.influxHost, "192.168.1.10");
+    old.influxPort = 8087;
+    strcpy(old.influxDatabase, "home");
+    strcpy(old.influxSeries, "climate");
+    // all 29 characters the field held
+    strcpy(old.influxTags, "name=Living room,floor=ground");
+    old.displayContrast = 100;
+    old.lowPowerContrast = 10;
+    memcpy(eeprom, &old, sizeof old);
+
+    TEST_ASSERT_EQUAL(SETTINGS_MIGRATED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(60, loaded.deepSleepTimer);
+    TEST_ASSERT_TRUE(loaded.influxEnabled);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.10", loaded.influxHost);
+    TEST_ASSERT_EQUAL(8087, loaded.influxPort);
+    TEST_ASSERT_EQUAL_STRING("home", loaded.influxDatabase);
+    TEST_ASSERT_EQUAL_STRING("climate", loaded.influxSeries);
+    TEST_ASSERT_EQUAL_STRING("name=Living room,floor=ground", loaded.influxTags);
+    TEST_ASSERT_EQUAL(100, loaded.displayContrast);
+    TEST_ASSERT_EQUAL(10, loaded.lowPowerContrast);
+    // what the struct didn't have takes its default
+    TEST_ASSERT_EQUAL(10, loaded.batchSize);
+    TEST_ASSERT_EQUAL(900, loaded.batchMaxAge);
+    TEST_ASSERT_EQUAL(300, loaded.deepSleepMaxTimer);
+    TEST_ASSERT_EQUAL(100, loaded.clockSyncWakes);
+    TEST_ASSERT_EQUAL_STRING("climate/{id}", loaded.mqttTopic);
+
+    // stored again, it loads as is
+    struct_settings migrated = loaded;
+    memset(eeprom, 0xFF, sizeof eeprom);
+    TEST_ASSERT_TRUE(encodeSettings(migrated, eeprom, sizeof eeprom) > 0);
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&migrated, &loaded, sizeof loaded);
+}
+
+void test_legacy_string_without_zero() {
+    LegacySettings old;
+    memset(&old, 0, sizeof old);
+    old.magicNumber = LEGACY_MAGIC;
+    memset(old.influxHost, 'h', sizeof old.influxHost);
+    memcpy(eeprom, &old, sizeof old);
+    TEST_ASSERT_EQUAL(SETTINGS_MIGRATED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(sizeof old.influxHost - 1, strlen(loaded.influxHost));
+}
+
+void test_other_magic_gives_defaults() {
+    // one past the legacy magic number was never released
+    int magic = LEGACY_MAGIC + 1;
+    memset(eeprom, 0, sizeof(LegacySettings));
+    memcpy(eeprom, &magic, sizeof magic);
+    TEST_ASSERT_EQUAL(SETTINGS_DEFAULTS, decodeSettings(eeprom, sizeof eeprom, loaded));
+    assertDefaults(loaded);
+}
+
+void test_round_trip() {
+    struct_settings s;
+    defaultSettings(s);
+    s.deepSleepTimer = 30;
+    s.deepSleepMaxTimer = 1200;
+    s.influxEnabled = true;
+    // as long as the field allows
+    memset(s.influxHost, 'h', sizeof s.influxHost - 1);
+    s.influxPort = 65535;
+    strcpy(s.influxDatabase, "weather");
+    s.displayContrast = -1;
+    s.batchSize = 24;
+    s.filterMode = 2;
+    s.phaseCurrent_uA[PHASE_SLEEP] = 12;
+    s.phaseCurrent_uA[PHASE_WIFI] = 4000000;
+    s.uploadProtocol = 1;
+    strcpy(s.mqttHost, "broker");
+    s.mqttRetain = false;
+    s.sensorSlots[0] = 0x1234;
+    s.sensorSlots[SENSOR_SLOTS - 1] = 0xFFFF;
+    s.gatewayEnabled = true;
+
+    size_t length = encodeSettings(s, eeprom, sizeof eeprom);
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_TRUE(length <= settingsMaxSize());
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&s, &loaded, sizeof loaded);
+}
+
+void test_strings_take_their_length() {
+    struct_settings s;
+    defaultSettings(s);
+    size_t empty = encodeSettings(s, eeprom, sizeof eeprom);
+    strcpy(s.influxHost, "abc");
+    TEST_ASSERT_EQUAL(empty + 3, encodeSettings(s, eeprom, sizeof eeprom));
+}
+
+void test_too_small_encodes_nothing() {
+    struct_settings s;
+    defaultSettings(s);
+    size_t length = encodeSettings(s, eeprom, sizeof eeprom);
+    TEST_ASSERT_EQUAL(0, encodeSettings(s, eeprom, length - 1));
+}
+
+void test_unknown_tags_are_skipped() {
+    StoreWriter writer;
+    const uint8_t future[] = { 1, 2, 3 };
+    writer.entry(250, future, sizeof future);
+    int deepSleepTimer = 45;
+    writer.entry(1, &deepSleepTimer, sizeof deepSleepTimer);
+    writer.entry(251, future, 0);
+    writer.entry(4, "influx.local", 12);
+    writer.finish();
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(45, loaded.deepSleepTimer);
+    TEST_ASSERT_EQUAL_STRING("influx.local", loaded.influxHost);
+    // the rest keeps its default
+    TEST_ASSERT_EQUAL(8086, loaded.influxPort);
+}
+
+void test_other_widths() {
+    StoreWriter writer;
+    // a port stored wider, a batch size narrower than the field and a string too long for it
+    uint32_t port = 0x00011F90;
+    writer.entry(5, &port, sizeof port);
+    uint8_t batchSize = 5;
+    writer.entry(11, &batchSize, sizeof batchSize);
+    char tags[100];
+    memset(tags, 't', sizeof tags);
+    writer.entry(8, tags, sizeof tags);
+    // more sensor slots than this firmware has, with half an entry at the end
+    uint8_t slots[2 * SENSOR_SLOTS + 3];
+    for(uint8_t i = 0; i < sizeof slots; i++) {
+        slots[i] = i + 1;
+    }
+    writer.entry(29, slots, sizeof slots);
+    writer.finish();
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(0x1F90, loaded.influxPort);
+    TEST_ASSERT_EQUAL(5, loaded.batchSize);
+    TEST_ASSERT_EQUAL(sizeof loaded.influxTags - 1, strlen(loaded.influxTags));
+    TEST_ASSERT_EQUAL(0x0201, loaded.sensorSlots[0]);
+    TEST_ASSERT_EQUAL(0x0807, loaded.sensorSlots[SENSOR_SLOTS - 1]);
+}
+
+void test_truncated_entry_is_ignored() {
+    StoreWriter writer;
+    int deepSleepTimer = 45;
+    writer.entry(1, &deepSleepTimer, sizeof deepSleepTimer);
+    int deepSleepMaxTimer = 600;
+    writer.entry(2, &deepSleepMaxTimer, sizeof deepSleepMaxTimer);
+    // the payload ends within the value of the second entry
+    writer.finish(SETTINGS_STORE_VERSION, writer.length - 2);
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(45, loaded.deepSleepTimer);
+    TEST_ASSERT_EQUAL(300, loaded.deepSleepMaxTimer);
+
+    // and within the tag and size of one
+    writer.length = SETTINGS_HEADER_SIZE;
+    writer.entry(1, &deepSleepTimer, sizeof deepSleepTimer);
+    writer.entry(2, &deepSleepMaxTimer, sizeof deepSleepMaxTimer);
+    writer.finish(SETTINGS_STORE_VERSION, SETTINGS_HEADER_SIZE + 2 + sizeof deepSleepTimer + 1);
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(45, loaded.deepSleepTimer);
+    TEST_ASSERT_EQUAL(300, loaded.deepSleepMaxTimer);
+}
+
+void test_payload_beyond_store_gives_defaults() {
+    struct_settings s;
+    defaultSettings(s);
+    s.deepSleepTimer = 45;
+    size_t length = encodeSettings(s, eeprom, sizeof eeprom);
+    TEST_ASSERT_EQUAL(SETTINGS_DEFAULTS, decodeSettings(eeprom, length - 1, loaded));
+    assertDefaults(loaded);
+}
+
+void test_bad_crc_gives_defaults() {
+    struct_settings s;
+    defaultSettings(s);
+    s.deepSleepTimer = 45;
+    size_t length = encodeSettings(s, eeprom, sizeof eeprom);
+    // a bit of the value flipped
+    eeprom[SETTINGS_HEADER_SIZE + 2] ^= 0x10;
+    TEST_ASSERT_EQUAL(SETTINGS_DEFAULTS, decodeSettings(eeprom, sizeof eeprom, loaded));
+    assertDefaults(loaded);
+    // or of the checksum itself
+    eeprom[SETTINGS_HEADER_SIZE + 2] ^= 0x10;
+    eeprom[length - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL(SETTINGS_DEFAULTS, decodeSettings(eeprom, sizeof eeprom, loaded));
+    assertDefaults(loaded);
+}
+
+void test_versions() {
+    StoreWriter writer;
+    int deepSleepTimer = 45;
+    writer.entry(1, &deepSleepTimer, sizeof deepSleepTimer);
+    writer.finish(SETTINGS_STORE_VERSION - 1);
+    TEST_ASSERT_EQUAL(SETTINGS_MIGRATED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(45, loaded.deepSleepTimer);
+    // a newer firmware's settings are read, but left as they are
+    writer.finish(SETTINGS_STORE_VERSION + 1);
+    TEST_ASSERT_EQUAL(SETTINGS_LOADED, decodeSettings(eeprom, sizeof eeprom, loaded));
+    TEST_ASSERT_EQUAL(45, loaded.deepSleepTimer);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_erased_gives_defaults);
+    RUN_TEST(test_migrates_legacy_struct);
+    RUN_TEST(test_legacy_string_without_zero);
+    RUN_TEST(test_other_magic_gives_defaults);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_strings_take_their_length);
+    RUN_TEST(test_too_small_encodes_nothing);
+    RUN_TEST(test_unknown_tags_are_skipped);
+    RUN_TEST(test_other_widths);
+    RUN_TEST(test_truncated_entry_is_ignored);
+    RUN_TEST(test_payload_beyond_store_gives_defaults);
+    RUN_TEST(test_bad_crc_gives_defaults);
+    RUN_TEST(test_versions);
+    return UNITY_END();
+}
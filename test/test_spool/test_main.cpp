@@ -0,0 +1,287 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "../../src/spool.h"
+#include "../../src/sim/storage_sim.h"
+
+// SampleSpool on the simulator's storage, plain files in a temporary directory: appending and
+// replaying across the queue and copy chunk sizes, what a torn write or a flipped bit costs,
+// compaction with part of the log uploaded and the cursor carried across wakes and boots
+
+#define BOOT 7
+#define UNIX_BASE 1600000000u
+
+char root[] = "/tmp/test-spool-XXXXXX";
+SimStorage storage;
+SpoolCursor cursor;
+ClockSync clock;
+
+void setUp() {
+    storage.remove("/spool.log");
+    storage.remove("/spool.tmp");
+    cursor.clear(BOOT);
+    clock.clear();
+    clock.sync(0, UNIX_BASE);
+}
+
+void tearDown() {
+}
+
+// n samples of the station clock from from_s on, with the temperature telling them apart
+void fillQueue(SampleBuffer &queue, uint32_t from_s, uint8_t n) {
+    queue.clear();
+    for(uint8_t i = 0; i < n; i++) {
+        queue.push(makeSample(from_s + i, (from_s + i) % 1000 / 10.0f, 50));
+    }
+}
+
+// appends n samples a queue at a time, numbered from from_s on
+void spoolSamples(SampleSpool &spool, uint32_t from_s, uint32_t n) {
+    SampleBuffer queue;
+    while(n > 0) {
+        uint8_t batch = n < SAMPLE_BUFFER_SIZE ? n : SAMPLE_BUFFER_SIZE;
+        fillQueue(queue, from_s, batch);
+        TEST_ASSERT_TRUE(spool.append(queue, clock));
+        from_s += batch;
+        n -= batch;
+    }
+}
+
+void assertSample(uint32_t station_s, const Sample &sample) {
+    TEST_ASSERT_EQUAL(UNIX_BASE + station_s, sample.timestamp_s);
+    TEST_ASSERT_EQUAL(makeSample(0, station_s % 1000 / 10.0f, 50).temperature_cC, sample.temperature_cC);
+    TEST_ASSERT_EQUAL(5000, sample.humidity_cpct);
+}
+
+// the bytes of the log, to damage them
+void rewriteLog(void (*damage)(uint8_t *data, uint32_t size)) {
+    static uint8_t data[SPOOL_MAX_BYTES];
+    uint32_t size = storage.size("/spool.log");
+    TEST_ASSERT_EQUAL(size, storage.read("/spool.log", 0, data, size));
+    damage(data, size);
+    storage.remove("/spool.log");
+    TEST_ASSERT_TRUE(storage.append("/spool.log", data, size));
+}
+
+void test_empty_has_nothing_pending() {
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    TEST_ASSERT_FALSE(spool.pending());
+    SampleBuffer queue;
+    queue.clear();
+    TEST_ASSERT_EQUAL(0, spool.load(queue, clock));
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_append_and_load_across_queues() {
+    // more than a queue holds and more than a copy chunk, in batches that don't line up with either
+    const uint32_t n = 3 * SAMPLE_BUFFER_SIZE + 5;
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    spoolSamples(spool, 100, n);
+    TEST_ASSERT_EQUAL(n * SPOOL_RECORD_SIZE, storage.size("/spool.log"));
+    TEST_ASSERT_EQUAL(n, spool.recordsSpooled);
+
+    SampleBuffer queue;
+    uint32_t next_s = 100;
+    while(spool.pending()) {
+        queue.clear();
+        // a queue with samples of its own leaves less room for the log
+        queue.push(makeSample(1, 0, 0));
+        uint32_t bytes = spool.load(queue, clock);
+        TEST_ASSERT_EQUAL((queue.size() - 1) * SPOOL_RECORD_SIZE, bytes);
+        for(uint8_t i = 1; i < queue.size(); i++) {
+            assertSample(next_s++, queue.at(i));
+        }
+        spool.consumed(bytes);
+    }
+    TEST_ASSERT_EQUAL(100 + n, next_s);
+    TEST_ASSERT_EQUAL(n, spool.recordsReplayed);
+    TEST_ASSERT_EQUAL(0, spool.recordsCorrupt);
+    // uploaded completely, the log is gone
+    TEST_ASSERT_EQUAL(0, storage.size("/spool.log"));
+}
+
+void test_torn_trailing_record() {
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    spoolSamples(spool, 100, 3);
+    // the power went while a record was written
+    uint8_t partial[7] = { SPOOL_MAGIC, SPOOL_UNIX_TIME, 1, 2, 3, 4, 5 };
+    TEST_ASSERT_TRUE(storage.append("/spool.log", partial, sizeof partial));
+    cursor.known = false;
+
+    SampleBuffer queue;
+    queue.clear();
+    TEST_ASSERT_EQUAL(3 * SPOOL_RECORD_SIZE, spool.load(queue, clock));
+    TEST_ASSERT_EQUAL(3, queue.size());
+
+    // the next append pads the torn record to a whole invalid one
+    spoolSamples(spool, 200, 2);
+    TEST_ASSERT_EQUAL(6 * SPOOL_RECORD_SIZE, storage.size("/spool.log"));
+    queue.clear();
+    TEST_ASSERT_EQUAL(6 * SPOOL_RECORD_SIZE, spool.load(queue, clock));
+    TEST_ASSERT_EQUAL(5, queue.size());
+    assertSample(102, queue.at(2));
+    assertSample(200, queue.at(3));
+    assertSample(201, queue.at(4));
+    TEST_ASSERT_EQUAL(1, spool.recordsCorrupt);
+}
+
+void flipBitOfSecondRecord(uint8_t *data, uint32_t size) {
+    TEST_ASSERT_TRUE(size >= 2 * SPOOL_RECORD_SIZE);
+    data[SPOOL_RECORD_SIZE + 8] ^= 0x04;
+}
+
+void test_crc_mismatch_skips_record() {
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    spoolSamples(spool, 100, 3);
+    rewriteLog(flipBitOfSecondRecord);
+
+    SampleBuffer queue;
+    queue.clear();
+    uint32_t bytes = spool.load(queue, clock);
+    // consumed all the same, it would never get any better
+    TEST_ASSERT_EQUAL(3 * SPOOL_RECORD_SIZE, bytes);
+    TEST_ASSERT_EQUAL(2, queue.size());
+    assertSample(100, queue.at(0));
+    assertSample(102, queue.at(1));
+    TEST_ASSERT_EQUAL(1, spool.recordsCorrupt);
+}
+
+void test_compaction_keeps_unconsumed() {
+    const uint32_t capacity = SPOOL_MAX_BYTES / SPOOL_RECORD_SIZE;
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    // a full queue short of the limit, less than append() wants with its room for padding
+    spoolSamples(spool, 0, capacity - SAMPLE_BUFFER_SIZE);
+    uint32_t end = storage.size("/spool.log");
+
+    // most of it went out already, what's left takes more than a copy chunk
+    SampleBuffer queue;
+    uint32_t consumed = 0;
+    while(consumed < (capacity - 3 * SAMPLE_BUFFER_SIZE) * SPOOL_RECORD_SIZE) {
+        queue.clear();
+        uint32_t bytes = spool.load(queue, clock);
+        spool.consumed(bytes);
+        consumed += bytes;
+    }
+    TEST_ASSERT_EQUAL(end, storage.size("/spool.log"));
+    TEST_ASSERT_TRUE(end - consumed > SPOOL_COPY_CHUNK);
+    TEST_ASSERT_TRUE((end - consumed) % SPOOL_COPY_CHUNK != 0);
+    uint32_t next_s = consumed / SPOOL_RECORD_SIZE;
+
+    // this one doesn't fit, the uploaded records make room and nothing is lost
+    spoolSamples(spool, 10000, SAMPLE_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(0, spool.recordsLost);
+    TEST_ASSERT_EQUAL(0, cursor.offset);
+    TEST_ASSERT_EQUAL(end - consumed + SAMPLE_BUFFER_SIZE * SPOOL_RECORD_SIZE, storage.size("/spool.log"));
+    TEST_ASSERT_EQUAL(storage.size("/spool.log"), cursor.end);
+    TEST_ASSERT_EQUAL(0, storage.size("/spool.tmp"));
+
+    // in order across the copy chunks, followed by the new ones
+    uint32_t last_s = consumed / SPOOL_RECORD_SIZE + (end - consumed) / SPOOL_RECORD_SIZE;
+    while(spool.pending()) {
+        queue.clear();
+        spool.consumed(spool.load(queue, clock));
+        for(uint8_t i = 0; i < queue.size(); i++) {
+            assertSample(next_s++, queue.at(i));
+            if(next_s == last_s) {
+                next_s = 10000;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(10000 + SAMPLE_BUFFER_SIZE, next_s);
+}
+
+void test_compaction_drops_oldest_when_full() {
+    const uint32_t capacity = SPOOL_MAX_BYTES / SPOOL_RECORD_SIZE;
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    spoolSamples(spool, 0, capacity + 2 * SAMPLE_BUFFER_SIZE);
+    TEST_ASSERT_TRUE(storage.size("/spool.log") <= SPOOL_MAX_BYTES);
+    uint32_t kept = storage.size("/spool.log") / SPOOL_RECORD_SIZE;
+    TEST_ASSERT_EQUAL(capacity + 2 * SAMPLE_BUFFER_SIZE - kept, spool.recordsLost);
+
+    // the newest are kept, in order
+    SampleBuffer queue;
+    queue.clear();
+    spool.load(queue, clock);
+    assertSample(spool.recordsLost, queue.at(0));
+    assertSample(spool.recordsLost + 1, queue.at(1));
+}
+
+void test_cursor_survives_wake() {
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    spoolSamples(spool, 100, 2 * SAMPLE_BUFFER_SIZE);
+    SampleBuffer queue;
+    queue.clear();
+    spool.consumed(spool.load(queue, clock));
+
+    // deep sleep keeps the cursor in RTC memory, the spool starts over
+    uint8_t rtc[sizeof cursor];
+    memcpy(rtc, &cursor, sizeof rtc);
+    SpoolCursor restored;
+    memcpy(&restored, rtc, sizeof restored);
+    SampleSpool next(storage, "/spool.log", "/spool.tmp");
+    next.setCursor(restored);
+    TEST_ASSERT_TRUE(next.pending());
+    TEST_ASSERT_EQUAL(SAMPLE_BUFFER_SIZE * SPOOL_RECORD_SIZE, next.pendingBytes());
+    queue.clear();
+    next.load(queue, clock);
+    assertSample(100 + SAMPLE_BUFFER_SIZE, queue.at(0));
+}
+
+void test_cold_boot_drops_station_time() {
+    SampleSpool spool(storage, "/spool.log", "/spool.tmp");
+    spool.setCursor(cursor);
+    // spooled before the first SNTP sync, in station time only
+    clock.clear();
+    spoolSamples(spool, 100, 2);
+    clock.sync(0, UNIX_BASE);
+    spoolSamples(spool, 200, 2);
+
+    // still the same boot, the station time can be placed
+    SampleBuffer queue;
+    queue.clear();
+    spool.load(queue, clock);
+    TEST_ASSERT_EQUAL(4, queue.size());
+    assertSample(100, queue.at(0));
+
+    // after a power cycle, it can't
+    cursor.clear(BOOT + 1);
+    SampleSpool rebooted(storage, "/spool.log", "/spool.tmp");
+    rebooted.setCursor(cursor);
+    TEST_ASSERT_TRUE(rebooted.pending());
+    TEST_ASSERT_EQUAL(4 * SPOOL_RECORD_SIZE, rebooted.pendingBytes());
+    queue.clear();
+    TEST_ASSERT_EQUAL(4 * SPOOL_RECORD_SIZE, rebooted.load(queue, clock));
+    TEST_ASSERT_EQUAL(2, queue.size());
+    assertSample(200, queue.at(0));
+    TEST_ASSERT_EQUAL(2, rebooted.recordsLost);
+    TEST_ASSERT_EQUAL(0, rebooted.recordsCorrupt);
+}
+
+int main() {
+    if(mkdtemp(root) == NULL) {
+        return 1;
+    }
+    storage.setRoot(root);
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_has_nothing_pending);
+    RUN_TEST(test_append_and_load_across_queues);
+    RUN_TEST(test_torn_trailing_record);
+    RUN_TEST(test_crc_mismatch_skips_record);
+    RUN_TEST(test_compaction_keeps_unconsumed);
+    RUN_TEST(test_compaction_drops_oldest_when_full);
+    RUN_TEST(test_cursor_survives_wake);
+    RUN_TEST(test_cold_boot_drops_station_time);
+    int failures = UNITY_END();
+    storage.remove("/spool.log");
+    storage.remove("/spool.tmp");
+    rmdir(root);
+    return failures;
+}
@@ -0,0 +1,251 @@
+#include <unity.h>
+#include "../../src/tasks.h"
+
+// Scheduler on a fake clock that only moves when a task takes time or the idle hook sleeps:
+// which task goes first, where a late periodic task picks up again, waking and changing periods,
+// the clock wrapping at 32 bits, and a task that wakes itself starving those below it.
+
+uint32_t now_us;
+uint32_t idled_us;
+unsigned idles;
+
+uint32_t fakeClock() {
+    return now_us;
+}
+
+void fakeIdle(uint32_t us) {
+    now_us += us;
+    idled_us += us;
+    idles++;
+}
+
+// the order tasks ran in, by their letter
+char order[64];
+size_t ran;
+// how long each run takes
+uint32_t cost_us;
+
+void record(char name) {
+    if(ran < sizeof order - 1) {
+        order[ran++] = name;
+        order[ran] = 0;
+    }
+    now_us += cost_us;
+}
+
+void taskA() { record('a'); }
+void taskB() { record('b'); }
+void taskC() { record('c'); }
+
+Scheduler *scheduler;
+
+// a task that keeps waking itself while it has something to wait for, like the gateway used to
+uint8_t pollingTask;
+bool wakesItself;
+
+void taskPolling() {
+    record('p');
+    if(wakesItself) {
+        scheduler->wake(pollingTask);
+    }
+}
+
+void setUp() {
+    now_us = 1000000;
+    idled_us = 0;
+    idles = 0;
+    order[0] = 0;
+    ran = 0;
+    cost_us = 0;
+    scheduler = new Scheduler(fakeClock, fakeIdle);
+}
+
+void tearDown() {
+    delete scheduler;
+}
+
+void runFor(uint32_t us) {
+    uint32_t start = now_us;
+    while(now_us - start < us) {
+        scheduler->runOnce();
+    }
+}
+
+void test_priority_order() {
+    uint8_t low = scheduler->add("low", taskA, 0, 1, 10);
+    uint8_t high = scheduler->add("high", taskB, 0, 5, 10);
+    uint8_t middle = scheduler->add("middle", taskC, 0, 3, 10);
+    scheduler->wake(low);
+    scheduler->wake(middle);
+    scheduler->wake(high);
+    for(int i = 0; i < 3; i++) {
+        scheduler->runOnce();
+    }
+    TEST_ASSERT_EQUAL_STRING("bca", order);
+
+    // of the same priority, the one due first
+    uint8_t other = scheduler->add("other", taskC, 0, 1, 10);
+    scheduler->wake(other);
+    now_us += 5;
+    scheduler->wake(low);
+    scheduler->runOnce();
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("bcaca", order);
+    // nothing due, woken tasks run once
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL(5, ran);
+    TEST_ASSERT_EQUAL(1, idles);
+}
+
+void test_idle_until_next_due() {
+    scheduler->add("a", taskA, 10, 1, 1);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("a", order);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL(10000, idled_us);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("aa", order);
+    TEST_ASSERT_EQUAL(10000, scheduler->idle_us);
+
+    // with nothing waiting for its time, the idle hook gets its maximum
+    scheduler->setPeriod(0, 0);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL(10000 + SCHEDULER_IDLE_MAX_US, idled_us);
+}
+
+void test_late_run_skips_ahead() {
+    uint8_t periodic = scheduler->add("periodic", taskA, 10, 1, 2);
+    uint8_t slow = scheduler->add("slow", taskB, 0, 5, 100);
+    scheduler->runOnce();
+    uint32_t start = now_us;
+
+    // a little late keeps the phase
+    now_us += 10000 + 3000;
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL(start + 20000, scheduler->task(periodic).due_us);
+    TEST_ASSERT_EQUAL(3000, scheduler->task(periodic).stats.maxLate_us);
+    TEST_ASSERT_EQUAL(1, scheduler->task(periodic).stats.missed);
+
+    // a long run of another task makes it miss more than a period, it runs once and goes on
+    // a period from then instead of catching up
+    cost_us = 35000;
+    scheduler->wake(slow);
+    scheduler->runOnce();
+    cost_us = 0;
+    uint32_t resumed = now_us;
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("aaba", order);
+    TEST_ASSERT_EQUAL(resumed + 10000, scheduler->task(periodic).due_us);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("aaba", order);
+    TEST_ASSERT_EQUAL(resumed + 10000, now_us);
+    TEST_ASSERT_EQUAL(2, scheduler->task(periodic).stats.missed);
+    TEST_ASSERT_EQUAL(35000, scheduler->task(slow).stats.max_us);
+
+    scheduler->resetMax();
+    TEST_ASSERT_EQUAL(0, scheduler->task(slow).stats.max_us);
+    TEST_ASSERT_EQUAL(0, scheduler->task(periodic).stats.maxLate_us);
+}
+
+void test_wake_and_set_period() {
+    uint8_t periodic = scheduler->add("periodic", taskA, 100, 1, 10);
+    scheduler->runOnce();
+    uint32_t due = scheduler->task(periodic).due_us;
+
+    // a wake brings the next run forward, the period goes on from there
+    now_us += 20000;
+    scheduler->wake(periodic);
+    scheduler->runOnce();
+    TEST_ASSERT_EQUAL_STRING("aa", order);
+    TEST_ASSERT_EQUAL(now_us + 100000, scheduler->task(periodic).due_us);
+    TEST_ASSERT_TRUE(scheduler->task(periodic).due_us != due);
+
+    // but doesn't push back a run that's overdue already
+    now_us += 150000;
+    due = scheduler->task(periodic).due_us;
+    scheduler->wake(periodic);
+    TEST_ASSERT_EQUAL(due, scheduler->task(periodic).due_us);
+
+    // no period stops it until it's woken
+    scheduler->setPeriod(periodic, 0);
+    TEST_ASSERT_FALSE(scheduler->task(periodic).pending);
+    runFor(1000000);
+    TEST_ASSERT_EQUAL_STRING("aa", order);
+    scheduler->wake(periodic);
+    runFor(1000000);
+    TEST_ASSERT_EQUAL_STRING("aaa", order);
+
+    // a period again makes it due right away
+    scheduler->setPeriod(periodic, 300);
+    TEST_ASSERT_TRUE(scheduler->task(periodic).pending);
+    TEST_ASSERT_EQUAL(now_us, scheduler->task(periodic).due_us);
+    runFor(1000000);
+    TEST_ASSERT_EQUAL_STRING("aaaaaaa", order);
+
+    // changing the period of a running task takes effect after its next run
+    scheduler->setPeriod(periodic, 100);
+    due = scheduler->task(periodic).due_us;
+    size_t before = ran;
+    while(ran == before) {
+        scheduler->runOnce();
+    }
+    TEST_ASSERT_EQUAL(due, now_us);
+    TEST_ASSERT_EQUAL(due + 100000, scheduler->task(periodic).due_us);
+
+    // ids that don't exist are left alone
+    scheduler->wake(scheduler->size());
+    scheduler->setPeriod(scheduler->size(), 10);
+}
+
+void test_clock_wraps() {
+    now_us = 0xFFFFFFFF - 25000;
+    uint8_t periodic = scheduler->add("periodic", taskA, 10, 1, 1);
+    scheduler->add("rare", taskB, 1000, 1, 1);
+    runFor(60000);
+    // at 0, 10 and 20 ms before the wrap, 30 to 50 after, and the rare one at the start
+    TEST_ASSERT_EQUAL_STRING("abaaaaa", order);
+    TEST_ASSERT_EQUAL(0, scheduler->task(periodic).stats.missed);
+    TEST_ASSERT_EQUAL(0, scheduler->task(periodic).stats.maxLate_us);
+    // every wait was to the next run, none the maximum
+    TEST_ASSERT_EQUAL(60000, scheduler->idle_us);
+    TEST_ASSERT_TRUE(now_us < 0x80000000);
+}
+
+void test_too_many_tasks() {
+    for(uint8_t i = 0; i < SCHEDULER_TASKS; i++) {
+        TEST_ASSERT_EQUAL(i, scheduler->add("a", taskA, 0, 1, 1));
+    }
+    TEST_ASSERT_EQUAL(SCHEDULER_NONE, scheduler->add("a", taskA, 0, 1, 1));
+    TEST_ASSERT_EQUAL(SCHEDULER_TASKS, scheduler->size());
+}
+
+void test_self_waking_task_starves_lower_ones() {
+    cost_us = 100;
+    pollingTask = scheduler->add("polling", taskPolling, 5, 4, 15);
+    uint8_t below = scheduler->add("below", taskA, 10, 3, 100);
+
+    // waking itself on every run, it always is the task due with the highest priority
+    wakesItself = true;
+    runFor(100000);
+    TEST_ASSERT_EQUAL(0, scheduler->task(below).stats.runs);
+
+    // polling on its period instead, both run on theirs
+    wakesItself = false;
+    runFor(100000);
+    TEST_ASSERT_EQUAL(10, scheduler->task(below).stats.runs);
+    // only the run it had been starved of started past its deadline
+    TEST_ASSERT_EQUAL(1, scheduler->task(below).stats.missed);
+    TEST_ASSERT_TRUE(scheduler->idle_us > 80000);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_order);
+    RUN_TEST(test_idle_until_next_due);
+    RUN_TEST(test_late_run_skips_ahead);
+    RUN_TEST(test_wake_and_set_period);
+    RUN_TEST(test_clock_wraps);
+    RUN_TEST(test_too_many_tasks);
+    RUN_TEST(test_self_waking_task_starves_lower_ones);
+    return UNITY_END();
+}
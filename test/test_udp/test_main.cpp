@@ -0,0 +1,235 @@
+#include <unity.h>
+#include "../../src/config.h"
+#include "../../src/sim/transport_sim.h"
+
+// UdpUploader: how many lines it packs into a datagram, samples leaving the queue as soon as
+// the stack took a datagram, and a send the stack refused. Then the charge of a wake that
+// uploads over UDP against one over HTTP, on the simulator's transport and timings.
+
+#define UNIX_BASE 1700000000u
+// long enough that the 24 samples of a full queue take more than a datagram
+#define PREFIX "climate,station=5137a1,location=living\\ room\\ by\\ the\\ north\\ window"
+
+// Keeps the datagrams the uploader sends, or refuses them while fail is set
+class FakeDatagrams : public DatagramTransport {
+public:
+    bool send(const char * /* host */, uint16_t /* port */, const uint8_t *data, size_t length) override {
+        if(fail) {
+            return false;
+        }
+        if(count < 8) {
+            memcpy(datagrams[count], data, length);
+            datagrams[count][length] = 0;
+            lengths[count] = length;
+        }
+        count++;
+        return true;
+    }
+
+    bool fail = false;
+    unsigned count = 0;
+    char datagrams[8][UDP_DATAGRAM_MAX + 1];
+    size_t lengths[8];
+};
+
+FakeDatagrams datagrams;
+// bigger than a datagram, the uploader must not use what's beyond
+char buffer[4096];
+UdpUploader *uploader;
+SampleBuffer queue;
+ClockSync stationClock;
+uint32_t now_ms;
+
+void setUp() {
+    datagrams = FakeDatagrams();
+    uploader = new UdpUploader(datagrams, buffer, sizeof buffer);
+    queue.clear();
+    uploader->setQueue(queue);
+    uploader->setTarget("influx", 8089, PREFIX);
+    stationClock.clear();
+    stationClock.sync(0, UNIX_BASE);
+    now_ms = 0;
+}
+
+void tearDown() {
+    delete uploader;
+}
+
+void queueSamples(uint8_t n) {
+    for(uint8_t i = 0; i < n; i++) {
+        queue.push(makeSample(i, 20 + i * 0.1f, 50));
+    }
+}
+
+// the line the sample at station time i goes out as
+size_t expectedLine(char *line, size_t size, uint8_t i) {
+    return snprintf(line, size, PREFIX " temperature_C=%.1f,humidity=50 %u\n", 20 + i * 0.1f, UNIX_BASE + i);
+}
+
+void step() {
+    uploader->step(now_ms++, stationClock);
+}
+
+void test_packs_lines_up_to_a_datagram() {
+    queueSamples(SAMPLE_BUFFER_SIZE);
+    char line[256];
+    size_t lineLength = expectedLine(line, sizeof line, 0);
+    size_t perDatagram = UDP_DATAGRAM_MAX / lineLength;
+    TEST_ASSERT_TRUE(perDatagram < SAMPLE_BUFFER_SIZE);
+
+    step();
+    TEST_ASSERT_EQUAL(Uploader::SEND, uploader->state());
+    step();
+    TEST_ASSERT_EQUAL(1, datagrams.count);
+    // as many whole lines as fit, the next one wouldn't have
+    TEST_ASSERT_TRUE(datagrams.lengths[0] <= UDP_DATAGRAM_MAX);
+    TEST_ASSERT_TRUE(datagrams.lengths[0] + expectedLine(line, sizeof line, perDatagram) > UDP_DATAGRAM_MAX);
+    size_t at = 0;
+    for(uint8_t i = 0; i < perDatagram; i++) {
+        lineLength = expectedLine(line, sizeof line, i);
+        TEST_ASSERT_EQUAL_MEMORY(line, datagrams.datagrams[0] + at, lineLength);
+        at += lineLength;
+    }
+    TEST_ASSERT_EQUAL_size_t(datagrams.lengths[0], at);
+
+    // the rest in the next datagram, starting where the first one stopped
+    while(!queue.empty() && now_ms < 100) {
+        step();
+    }
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(2, datagrams.count);
+    lineLength = expectedLine(line, sizeof line, perDatagram);
+    TEST_ASSERT_EQUAL_MEMORY(line, datagrams.datagrams[1], lineLength);
+    TEST_ASSERT_EQUAL(2, uploader->datagramsSent);
+}
+
+void test_line_longer_than_a_datagram_is_dropped() {
+    static char prefix[UDP_DATAGRAM_MAX + 1];
+    memset(prefix, 'x', sizeof prefix - 1);
+    uploader->setTarget("influx", 8089, prefix);
+    queueSamples(2);
+    step();
+    // it can never be sent, so it doesn't hold up the one after it
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(1, uploader->samplesRejected);
+    TEST_ASSERT_EQUAL(0, datagrams.count);
+}
+
+void test_samples_leave_queue_once_sent() {
+    queueSamples(3);
+    step();
+    // encoding doesn't take them
+    TEST_ASSERT_EQUAL(3, queue.size());
+    step();
+    TEST_ASSERT_EQUAL(0, queue.size());
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_EQUAL(0, uploader->lastResult);
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+
+    // one that came in while the datagram was encoded stays for the next
+    queueSamples(1);
+    step();
+    queue.push(makeSample(10, 21, 50));
+    step();
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(10, queue.at(0).timestamp_s);
+}
+
+void test_failed_send_backs_off_and_keeps_samples() {
+    queueSamples(3);
+    datagrams.fail = true;
+    step();
+    step();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(UPLOAD_ERROR_SEND_FAILED, uploader->lastResult);
+    TEST_ASSERT_EQUAL(1, uploader->uploadsFailed);
+    TEST_ASSERT_EQUAL(3, queue.size());
+
+    // nothing until the backoff is over
+    uint32_t failed_ms = now_ms - 1;
+    datagrams.fail = false;
+    now_ms = failed_ms + uploader->backoff() - 1;
+    step();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    step();
+    step();
+    step();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_EQUAL(1, datagrams.count);
+    TEST_ASSERT_EQUAL(0, queue.size());
+    char line[256];
+    size_t lineLength = expectedLine(line, sizeof line, 0);
+    TEST_ASSERT_EQUAL_MEMORY(line, datagrams.datagrams[0], lineLength);
+}
+
+// The charge a day of wakes every deepSleepMaxTimer draws, each uploading the sample it took,
+// with the time of the upload on the simulator's transport: a connection and a response for
+// HTTP, a datagram on air for UDP. The rest of a wake is the same for both.
+#define WAKE_OTHER_MS 400
+
+SimShared shared;
+SimTransport simTransport;
+
+float mAhPerDay(Uploader &uploader) {
+    memset(&shared, 0, sizeof shared);
+    sim = &shared;
+    EnergyAccount account;
+    account.clear();
+    SampleBuffer samples;
+    uploader.setQueue(samples);
+    uint32_t wakes = 86400 / settings.deepSleepMaxTimer;
+    for(uint32_t wake = 0; wake < wakes; wake++) {
+        // a wake starts metering from 0, like millis() after deep sleep
+        sim->wakeStart_ms = sim->now_ms;
+        EnergyMeter meter(account);
+        halDelay(WAKE_OTHER_MS);
+        samples.push(makeSample(wake * settings.deepSleepMaxTimer, 20, 50));
+        meter.enter(PHASE_UPLOAD, halMillis());
+        for(int steps = 0; steps < 10000 && (!samples.empty() || !uploader.idle()); steps++) {
+            uploader.step((uint32_t) sim->now_ms, stationClock);
+            sim->now_ms++;
+        }
+        meter.enter(PHASE_OTHER, halMillis());
+        // the radio goes off with the wake
+        simTransport.stop();
+        meter.sleep(halMillis(), settings.deepSleepMaxTimer);
+        sim->now_ms += settings.deepSleepMaxTimer * 1000;
+    }
+    return account.mAhPerDay(settings.phaseCurrent_uA);
+}
+
+void test_udp_wakes_draw_less_than_http() {
+    defaultSettings(settings);
+    TEST_ASSERT_TRUE(simTransport.toFile("-"));
+
+    InfluxUploader http(simTransport, buffer, sizeof buffer);
+    http.setTarget("influx", 8086, "/write?db=climate", "climate");
+    float http_mAh = mAhPerDay(http);
+    TEST_ASSERT_EQUAL(86400 / settings.deepSleepMaxTimer, http.uploadsSucceeded);
+
+    UdpUploader udp(simTransport, buffer, sizeof buffer);
+    udp.setTarget("influx", 8089, "climate");
+    float udp_mAh = mAhPerDay(udp);
+    TEST_ASSERT_EQUAL(86400 / settings.deepSleepMaxTimer, udp.datagramsSent);
+
+    char message[96];
+    snprintf(message, sizeof message, "HTTP %.3f mAh/day, UDP %.3f mAh/day", http_mAh, udp_mAh);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(udp_mAh < http_mAh);
+    // what UDP saves is the connection and the response, a round trip each at the upload
+    // current, less the datagram's time on air
+    float saved_mAh = (86400 / settings.deepSleepMaxTimer) * (2 * SIM_RTT_MS - SIM_DATAGRAM_MS)
+        * (float) settings.phaseCurrent_uA[PHASE_UPLOAD] / 3.6e9f;
+    TEST_ASSERT_FLOAT_WITHIN(saved_mAh * 0.05f, saved_mAh, http_mAh - udp_mAh);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_packs_lines_up_to_a_datagram);
+    RUN_TEST(test_line_longer_than_a_datagram_is_dropped);
+    RUN_TEST(test_samples_leave_queue_once_sent);
+    RUN_TEST(test_failed_send_backs_off_and_keeps_samples);
+    RUN_TEST(test_udp_wakes_draw_less_than_http);
+    return UNITY_END();
+}
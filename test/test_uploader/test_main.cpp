@@ -0,0 +1,301 @@
+#include <unity.h>
+#include "../../src/uploader.h"
+
+// InfluxUploader's queue and retry handling against a scripted server
+
+#define HTTP_NO_CONTENT "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n"
+#define HTTP_BAD_REQUEST "HTTP/1.1 400 Bad Request\r\nContent-Length: 11\r\n\r\nunparsable\n"
+
+// Answers every complete request with the response set, the connection stays open unless the
+// server is told to close it
+class FakeTransport : public UploadTransport {
+public:
+    bool connect(const char * /* host */, uint16_t /* port */) {
+        connects++;
+        open = !refuse;
+        stale = false;
+        requestLength = 0;
+        return open;
+    }
+
+    bool connected() {
+        return open;
+    }
+
+    size_t write(const uint8_t *data, size_t length) {
+        if(!open || stale) {
+            open = false;
+            return 0;
+        }
+        memcpy(request + requestLength, data, length);
+        requestLength += length;
+        request[requestLength] = 0;
+        const char *body = strstr(request, "\r\n\r\n");
+        const char *contentLength = strstr(request, "Content-Length: ");
+        if(body != NULL && contentLength != NULL && strlen(body + 4) == strtoul(contentLength + 16, NULL, 10)) {
+            requests++;
+            strncpy(lastBody, body + 4, sizeof lastBody - 1);
+            lastLines = 0;
+            for(const char *c = body + 4; *c; c++) {
+                lastLines += *c == '\n';
+            }
+            requestLength = 0;
+            unread = response;
+        }
+        return length;
+    }
+
+    int available() {
+        return unread != NULL ? strlen(unread) : 0;
+    }
+
+    int read() {
+        if(unread == NULL || *unread == 0) {
+            return -1;
+        }
+        return *unread++;
+    }
+
+    void stop() {
+        open = false;
+        unread = NULL;
+    }
+
+    // the server dropped the idle connection without the client noticing yet
+    void closeIdle() {
+        stale = true;
+    }
+
+    const char *response = HTTP_NO_CONTENT;
+    bool refuse = false;
+    unsigned connects = 0;
+    unsigned requests = 0;
+    unsigned lastLines = 0;
+    char lastBody[2048] = "";
+
+private:
+    bool open = false;
+    bool stale = false;
+    char request[4096];
+    size_t requestLength = 0;
+    const char *unread = NULL;
+};
+
+FakeTransport transport;
+char payload[2048];
+InfluxUploader *uploader;
+SampleBuffer queue;
+ClockSync clock;
+uint32_t now_ms;
+
+void setUp() {
+    transport = FakeTransport();
+    uploader = new InfluxUploader(transport, payload, sizeof payload);
+    queue.clear();
+    uploader->setQueue(queue);
+    uploader->setTarget("influx", 8086, "/write?db=test&precision=s", "climate");
+    clock.clear();
+    clock.sync(0, 1700000000);
+    now_ms = 0;
+}
+
+void tearDown() {
+    delete uploader;
+}
+
+void queueSamples(uint8_t n) {
+    for(uint8_t i = 0; i < n; i++) {
+        queue.push(makeSample(now_ms / 1000 + i, 20 + i * 0.1f, 50));
+    }
+}
+
+// steps until the uploader is idle or backing off again, at 1 ms per step
+void runUpload() {
+    do {
+        uploader->step(now_ms++, clock);
+    } while(!uploader->idle() && uploader->state() != Uploader::BACKOFF);
+}
+
+void test_accepted_upload_empties_queue() {
+    queueSamples(3);
+    runUpload();
+    TEST_ASSERT_EQUAL(1, transport.requests);
+    TEST_ASSERT_EQUAL(3, transport.lastLines);
+    TEST_ASSERT_EQUAL(204, uploader->lastResult);
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(1, uploader->uploadsSucceeded);
+}
+
+void test_client_error_drops_samples() {
+    transport.response = HTTP_BAD_REQUEST;
+    queueSamples(3);
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_EQUAL(400, uploader->lastResult);
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(3, uploader->samplesRejected);
+    TEST_ASSERT_EQUAL(1, uploader->uploadsFailed);
+    TEST_ASSERT_EQUAL(0, uploader->backoff());
+}
+
+void test_server_error_keeps_samples() {
+    transport.response = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+    queueSamples(3);
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(0, uploader->samplesRejected);
+}
+
+void test_backoff_doubles_up_to_max() {
+    transport.refuse = true;
+    queueSamples(1);
+    const uint32_t expected[] = { 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, 256000, 300000, 300000 };
+    for(uint32_t backoff : expected) {
+        runUpload();
+        TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+        TEST_ASSERT_EQUAL(backoff, uploader->backoff());
+        // waits out the whole backoff, not a step less
+        uint32_t failed_ms = now_ms - 1;
+        now_ms = failed_ms + backoff - 1;
+        uploader->step(now_ms, clock);
+        TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+        now_ms++;
+        uploader->step(now_ms, clock);
+        TEST_ASSERT_TRUE(uploader->idle());
+    }
+    TEST_ASSERT_EQUAL(11, uploader->uploadsFailed);
+
+    // the next success starts over
+    transport.refuse = false;
+    runUpload();
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(0, uploader->backoff());
+}
+
+void test_keep_alive_reused() {
+    queueSamples(1);
+    runUpload();
+    queueSamples(1);
+    runUpload();
+    TEST_ASSERT_EQUAL(1, transport.connects);
+    TEST_ASSERT_EQUAL(2, transport.requests);
+    TEST_ASSERT_EQUAL(1, uploader->connectionsOpened);
+    TEST_ASSERT_EQUAL(1, uploader->connectionsReused);
+}
+
+void test_server_close_reconnects_without_failure() {
+    queueSamples(1);
+    runUpload();
+    transport.closeIdle();
+    queueSamples(2);
+    runUpload();
+    TEST_ASSERT_TRUE(queue.empty());
+    TEST_ASSERT_EQUAL(2, transport.connects);
+    TEST_ASSERT_EQUAL(2, transport.lastLines);
+    TEST_ASSERT_EQUAL(2, uploader->uploadsSucceeded);
+    TEST_ASSERT_EQUAL(0, uploader->uploadsFailed);
+}
+
+void test_connection_close_header_not_reused() {
+    transport.response = "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n";
+    queueSamples(1);
+    runUpload();
+    queueSamples(1);
+    runUpload();
+    TEST_ASSERT_EQUAL(2, transport.connects);
+    TEST_ASSERT_EQUAL(0, uploader->connectionsReused);
+}
+
+void test_overflow_during_request() {
+    queueSamples(SAMPLE_BUFFER_SIZE);
+    uint32_t newest_s = queue.newest().timestamp_s;
+    // up to where the request is on its way
+    while(uploader->state() != Uploader::AWAIT_RESPONSE) {
+        uploader->step(now_ms++, clock);
+    }
+    // readings that push the oldest, in flight, samples out of the full queue
+    for(uint8_t i = 1; i <= 5; i++) {
+        queue.push(makeSample(newest_s + i, 25, 50));
+    }
+    TEST_ASSERT_EQUAL(5, queue.dropped);
+    runUpload();
+    TEST_ASSERT_EQUAL(SAMPLE_BUFFER_SIZE, transport.lastLines);
+    TEST_ASSERT_EQUAL(5, queue.size());
+    TEST_ASSERT_EQUAL(newest_s + 1, queue.oldest().timestamp_s);
+    TEST_ASSERT_EQUAL(newest_s + 5, queue.newest().timestamp_s);
+}
+
+void test_sample_during_request_kept() {
+    queueSamples(3);
+    while(uploader->state() != Uploader::AWAIT_RESPONSE) {
+        uploader->step(now_ms++, clock);
+    }
+    queue.push(makeSample(100, 25, 50));
+    runUpload();
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(100, queue.oldest().timestamp_s);
+}
+
+void test_invalid_clock_sends_lone_sample_untimed() {
+    clock.clear();
+    queueSamples(1);
+    runUpload();
+    TEST_ASSERT_EQUAL(1, transport.requests);
+    TEST_ASSERT_EQUAL(1, transport.lastLines);
+    // measurement and fields, but no timestamp
+    TEST_ASSERT_EQUAL_STRING("climate temperature_C=20.0,humidity=50\n", transport.lastBody);
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_invalid_clock_keeps_older_samples() {
+    clock.clear();
+    queueSamples(3);
+    TEST_ASSERT_FALSE(uploader->ready(clock));
+    runUpload();
+    TEST_ASSERT_TRUE(uploader->idle());
+    TEST_ASSERT_EQUAL(0, transport.requests);
+    TEST_ASSERT_EQUAL(3, queue.size());
+    TEST_ASSERT_EQUAL(0, uploader->samplesRejected);
+
+    // all of them once the clock places them
+    clock.sync(0, 1700000000);
+    TEST_ASSERT_TRUE(uploader->ready(clock));
+    runUpload();
+    TEST_ASSERT_EQUAL(1, transport.requests);
+    TEST_ASSERT_EQUAL(3, transport.lastLines);
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_header_too_large_not_sent() {
+    char url[300];
+    memset(url, 'a', sizeof url - 1);
+    url[0] = '/';
+    url[sizeof url - 1] = 0;
+    uploader->setTarget("influx", 8086, url, "climate");
+    queueSamples(3);
+    runUpload();
+    TEST_ASSERT_EQUAL(Uploader::BACKOFF, uploader->state());
+    TEST_ASSERT_EQUAL(UPLOAD_ERROR_TOO_LARGE, uploader->lastResult);
+    TEST_ASSERT_EQUAL(1, uploader->uploadsFailed);
+    TEST_ASSERT_EQUAL(0, transport.connects);
+    TEST_ASSERT_EQUAL(0, transport.requests);
+    TEST_ASSERT_EQUAL(3, queue.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_accepted_upload_empties_queue);
+    RUN_TEST(test_client_error_drops_samples);
+    RUN_TEST(test_server_error_keeps_samples);
+    RUN_TEST(test_backoff_doubles_up_to_max);
+    RUN_TEST(test_keep_alive_reused);
+    RUN_TEST(test_server_close_reconnects_without_failure);
+    RUN_TEST(test_connection_close_header_not_reused);
+    RUN_TEST(test_overflow_during_request);
+    RUN_TEST(test_sample_during_request_kept);
+    RUN_TEST(test_invalid_clock_sends_lone_sample_untimed);
+    RUN_TEST(test_invalid_clock_keeps_older_samples);
+    RUN_TEST(test_header_too_large_not_sent);
+    return UNITY_END();
+}